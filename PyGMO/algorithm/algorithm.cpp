@@ -25,7 +25,6 @@
 #include <Python.h>
 #include <boost/python/class.hpp>
 #include <boost/python/module.hpp>
-#include <boost/python/register_ptr_to_python.hpp>
 #include <boost/utility.hpp>
 #include <boost/python/enum.hpp>
 #include <sstream>
@@ -40,10 +39,20 @@ using namespace boost::python;
 using namespace pagmo;
 
 // Wrapper method for algorithm evolve that uses copy instead of pass-by-non-const-reference.
-static inline population evolve_copy(const algorithm::base &a, const population &pop)
+// The GIL is released during the evolution, Python-reimplemented objects take it back when needed. Other Python threads
+// may use the same algorithm meanwhile, so the evolution runs on a copy taken with the GIL held and the state of the copy
+// (random number generators, evaluation counters) is stored back afterwards, again with the GIL held, through the pickle
+// suite of the algorithm (which also handles the Python algorithms contained in meta-algorithms).
+template <class Algorithm, class PickleSuite>
+static inline population evolve_copy(Algorithm &a, const population &pop)
 {
+	Algorithm algo(a);
 	population pop_copy(pop);
-	a.evolve(pop_copy);
+	{
+		scoped_gil_release release;
+		algo.evolve(pop_copy);
+	}
+	PickleSuite::setstate(a,PickleSuite::getstate(algo));
 	return pop_copy;
 }
 
@@ -55,13 +64,64 @@ static inline class_<Algorithm,bases<algorithm::base> > algorithm_wrapper(const
 	retval.def(init<>());
 	retval.def("__copy__", &Py_copy_from_ctor<Algorithm>);
 	retval.def("__deepcopy__", &Py_deepcopy_from_ctor<Algorithm>);
-	retval.def("evolve", &evolve_copy);
+	retval.def("evolve", &evolve_copy<Algorithm,generic_pickle_suite<Algorithm> >);
 	retval.def_pickle(generic_pickle_suite<Algorithm>());
 	retval.def("cpp_loads", &py_cpp_loads<Algorithm>);
 	retval.def("cpp_dumps", &py_cpp_dumps<Algorithm>);
 	return retval;
 }
 
+// Algorithms contained in meta-algorithms, stored in the pickled state as Python objects after the archive, as they
+// can be implemented in Python.
+template <class Algorithm>
+struct meta_algorithm_components
+{
+	static const int size = 1;
+	static boost::python::tuple get(const Algorithm &algo)
+	{
+		return boost::python::make_tuple(algo.get_algorithm());
+	}
+	static void set(Algorithm &algo, const boost::python::tuple &state)
+	{
+		const algorithm::base_ptr internal_algo = boost::python::extract<algorithm::base_ptr>(state[1]);
+		algo.set_algorithm(*internal_algo);
+	}
+};
+
+template <>
+struct meta_algorithm_components<algorithm::cstrs_core>
+{
+	static const int size = 2;
+	static boost::python::tuple get(const algorithm::cstrs_core &algo)
+	{
+		return boost::python::make_tuple(algo.get_algorithm(),algo.get_repair_algorithm());
+	}
+	static void set(algorithm::cstrs_core &algo, const boost::python::tuple &state)
+	{
+		const algorithm::base_ptr internal_algo = boost::python::extract<algorithm::base_ptr>(state[1]);
+		const algorithm::base_ptr repair_algo = boost::python::extract<algorithm::base_ptr>(state[2]);
+		algo.set_algorithm(*internal_algo);
+		algo.set_repair_algorithm(*repair_algo);
+	}
+};
+
+template <>
+struct meta_algorithm_components<algorithm::cstrs_immune_system>
+{
+	static const int size = 2;
+	static boost::python::tuple get(const algorithm::cstrs_immune_system &algo)
+	{
+		return boost::python::make_tuple(algo.get_algorithm(),algo.get_algorithm_immune());
+	}
+	static void set(algorithm::cstrs_immune_system &algo, const boost::python::tuple &state)
+	{
+		const algorithm::base_ptr internal_algo = boost::python::extract<algorithm::base_ptr>(state[1]);
+		const algorithm::base_ptr immune_algo = boost::python::extract<algorithm::base_ptr>(state[2]);
+		algo.set_algorithm(*internal_algo);
+		algo.set_algorithm_immune(*immune_algo);
+	}
+};
+
 // Meta-algorithms need specialised pickle suites, as they contains pointers to classes that can be implemented in Python.
 template <class Algorithm>
 struct meta_algorithm_pickle_suite : boost::python::pickle_suite
@@ -75,21 +135,21 @@ struct meta_algorithm_pickle_suite : boost::python::pickle_suite
 		std::stringstream ss;
 		boost::archive::text_oarchive oa(ss);
 		oa << algo;
-		return boost::python::make_tuple(ss.str(),algo.get_algorithm());
+		return boost::python::tuple(boost::python::make_tuple(ss.str()) + meta_algorithm_components<Algorithm>::get(algo));
 	}
 	static void setstate(Algorithm &algo, boost::python::tuple state)
 	{
-		if (len(state) != 2)
+		const int size = meta_algorithm_components<Algorithm>::size + 1;
+		if (len(state) != size)
 		{
-			PyErr_SetObject(PyExc_ValueError,("expected 2-item tuple in call to __setstate__; got %s" % state).ptr());
+			PyErr_SetObject(PyExc_ValueError,("expected %d-item tuple in call to __setstate__; got %s" % boost::python::make_tuple(size,state)).ptr());
 			throw_error_already_set();
 		}
 		const std::string str = extract<std::string>(state[0]);
 		std::stringstream ss(str);
 		boost::archive::text_iarchive ia(ss);
 		ia >> algo;
-		const algorithm::base_ptr internal_algo = boost::python::extract<algorithm::base_ptr>(state[1]);
-		algo.set_algorithm(*internal_algo);
+		meta_algorithm_components<Algorithm>::set(algo,state);
 	}
 };
 
@@ -100,7 +160,7 @@ inline class_<algorithm::ms,bases<algorithm::base> > algorithm_wrapper(const cha
 	retval.def(init<>());
 	retval.def("__copy__", &Py_copy_from_ctor<algorithm::ms>);
 	retval.def("__deepcopy__", &Py_deepcopy_from_ctor<algorithm::ms>);
-	retval.def("evolve", &evolve_copy);
+	retval.def("evolve", &evolve_copy<algorithm::ms,meta_algorithm_pickle_suite<algorithm::ms> >);
 	retval.def_pickle(meta_algorithm_pickle_suite<algorithm::ms>());
 	retval.def("cpp_loads", &py_cpp_loads<algorithm::ms>);
 	retval.def("cpp_dumps", &py_cpp_dumps<algorithm::ms>);
@@ -114,7 +174,7 @@ inline class_<algorithm::mbh,bases<algorithm::base> > algorithm_wrapper(const ch
 	retval.def(init<>());
 	retval.def("__copy__", &Py_copy_from_ctor<algorithm::mbh>);
 	retval.def("__deepcopy__", &Py_deepcopy_from_ctor<algorithm::mbh>);
-	retval.def("evolve", &evolve_copy);
+	retval.def("evolve", &evolve_copy<algorithm::mbh,meta_algorithm_pickle_suite<algorithm::mbh> >);
 	retval.def_pickle(meta_algorithm_pickle_suite<algorithm::mbh>());
 	retval.def("cpp_loads", &py_cpp_loads<algorithm::mbh>);
 	retval.def("cpp_dumps", &py_cpp_dumps<algorithm::mbh>);
@@ -128,7 +188,7 @@ inline class_<algorithm::cstrs_co_evolution,bases<algorithm::base> > algorithm_w
 	retval.def(init<>());
 	retval.def("__copy__", &Py_copy_from_ctor<algorithm::cstrs_co_evolution>);
 	retval.def("__deepcopy__", &Py_deepcopy_from_ctor<algorithm::cstrs_co_evolution>);
-	retval.def("evolve", &evolve_copy);
+	retval.def("evolve", &evolve_copy<algorithm::cstrs_co_evolution,meta_algorithm_pickle_suite<algorithm::cstrs_co_evolution> >);
 	retval.def_pickle(meta_algorithm_pickle_suite<algorithm::cstrs_co_evolution>());
 	retval.def("cpp_loads", &py_cpp_loads<algorithm::cstrs_co_evolution>);
 	retval.def("cpp_dumps", &py_cpp_dumps<algorithm::cstrs_co_evolution>);
@@ -142,7 +202,7 @@ inline class_<algorithm::cstrs_self_adaptive,bases<algorithm::base> > algorithm_
 	retval.def(init<>());
 	retval.def("__copy__", &Py_copy_from_ctor<algorithm::cstrs_self_adaptive>);
 	retval.def("__deepcopy__", &Py_deepcopy_from_ctor<algorithm::cstrs_self_adaptive>);
-	retval.def("evolve", &evolve_copy);
+	retval.def("evolve", &evolve_copy<algorithm::cstrs_self_adaptive,meta_algorithm_pickle_suite<algorithm::cstrs_self_adaptive> >);
 	retval.def_pickle(meta_algorithm_pickle_suite<algorithm::cstrs_self_adaptive>());
 	retval.def("cpp_loads", &py_cpp_loads<algorithm::cstrs_self_adaptive>);
 	retval.def("cpp_dumps", &py_cpp_dumps<algorithm::cstrs_self_adaptive>);
@@ -156,13 +216,27 @@ inline class_<algorithm::cstrs_immune_system,bases<algorithm::base> > algorithm_
 	retval.def(init<>());
 	retval.def("__copy__", &Py_copy_from_ctor<algorithm::cstrs_immune_system>);
 	retval.def("__deepcopy__", &Py_deepcopy_from_ctor<algorithm::cstrs_immune_system>);
-	retval.def("evolve", &evolve_copy);
+	retval.def("evolve", &evolve_copy<algorithm::cstrs_immune_system,meta_algorithm_pickle_suite<algorithm::cstrs_immune_system> >);
 	retval.def_pickle(meta_algorithm_pickle_suite<algorithm::cstrs_immune_system>());
 	retval.def("cpp_loads", &py_cpp_loads<algorithm::cstrs_immune_system>);
 	retval.def("cpp_dumps", &py_cpp_dumps<algorithm::cstrs_immune_system>);
 	return retval;
 }
 
+template <>
+inline class_<algorithm::cstrs_core,bases<algorithm::base> > algorithm_wrapper(const char *name, const char *descr)
+{
+	class_<algorithm::cstrs_core,bases<algorithm::base> > retval(name,descr,init<const algorithm::cstrs_core &>());
+	retval.def(init<>());
+	retval.def("__copy__", &Py_copy_from_ctor<algorithm::cstrs_core>);
+	retval.def("__deepcopy__", &Py_deepcopy_from_ctor<algorithm::cstrs_core>);
+	retval.def("evolve", &evolve_copy<algorithm::cstrs_core,meta_algorithm_pickle_suite<algorithm::cstrs_core> >);
+	retval.def_pickle(meta_algorithm_pickle_suite<algorithm::cstrs_core>());
+	retval.def("cpp_loads", &py_cpp_loads<algorithm::cstrs_core>);
+	retval.def("cpp_dumps", &py_cpp_dumps<algorithm::cstrs_core>);
+	return retval;
+}
+
 BOOST_PYTHON_MODULE(_algorithm) {
 	common_module_init();
 
@@ -492,5 +566,6 @@ BOOST_PYTHON_MODULE(_algorithm) {
 	#endif	
 
 	// Register to_python conversion from smart pointer.
-	register_ptr_to_python<algorithm::base_ptr>();
+	// Pointers to Python-reimplemented algorithms are converted back to their Python objects.
+	to_python_converter<algorithm::base_ptr,py_object_ptr_to_python<algorithm::base> >();
 }
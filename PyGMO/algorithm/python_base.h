@@ -44,15 +44,18 @@ class __PAGMO_VISIBLE python_base: public base, public boost::python::wrapper<ba
 		python_base():base(), boost::python::wrapper<base>() {}
 		base_ptr clone() const
 		{
-			base_ptr retval = this->get_override("__get_deepcopy__")();
-			if (!retval) {
+			gil_state_lock lock;
+			const boost::python::object retval = this->get_override("__get_deepcopy__")();
+			base *ptr = boost::python::extract<base *>(retval);
+			if (!ptr) {
 				pagmo_throw(std::runtime_error,"algorithms's __get_deepcopy__() method returns a NULL pointer, please check the implementation");
 			}
-			return retval;
+			// The Python object is released with the GIL held, see py_object_deleter.
+			return base_ptr(ptr,py_object_deleter<base>(retval.ptr()));
 		}
 		std::string human_readable_extra() const
 		{
-			
+			gil_state_lock lock;
 			if (boost::python::override f = this->get_override("human_readable_extra")) {
 			#if BOOST_WORKAROUND(BOOST_MSVC, <= 1700)
 				return boost::python::call<std::string>(this->get_override("human_readable_extra").ptr());
@@ -68,6 +71,7 @@ class __PAGMO_VISIBLE python_base: public base, public boost::python::wrapper<ba
 		}
 		std::string get_name() const
 		{
+			gil_state_lock lock;
 			if (boost::python::override f = this->get_override("get_name")) {
 			#if BOOST_WORKAROUND(BOOST_MSVC, <= 1700)
 				return boost::python::call<std::string>(this->get_override("get_name").ptr());
@@ -88,6 +92,7 @@ class __PAGMO_VISIBLE python_base: public base, public boost::python::wrapper<ba
 		// Changed implementations from Python.
 		population py_evolve(const population &p) const
 		{
+			gil_state_lock lock;
 			if (boost::python::override f = this->get_override("evolve")) {
 				const population retval = f(p);
 				return retval;
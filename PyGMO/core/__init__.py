@@ -16,7 +16,8 @@ __all__ = [
     'local_island',
     'migration_direction',
     'population',
-    'py_island']
+    'py_island',
+    'py_pool_island']
 
 _orig_signal = _signal.getsignal(_signal.SIGINT)
 _main_pid = _os.getpid()
@@ -192,6 +193,215 @@ class py_island(base_island):
     def get_name(self):
         return "Python multiprocessing island"
 
+# Persistent worker processes used by py_pool_island. Each worker owns a
+# pipe and a shared memory buffer: the pipe carries small control messages,
+# while the serialised populations travel through the buffer (falling back
+# to the pipe when they do not fit). The algorithm and the problem are
+# pickled over to a worker only when they differ from the ones it already
+# holds.
+
+def _pool_to_bytes(s):
+    if isinstance(s, bytes):
+        return s
+    return s.encode('ascii')
+
+
+def _pool_from_bytes(b):
+    if str is bytes:
+        return b
+    return b.decode('ascii')
+
+
+def _pool_send(conn, buf, s):
+    import ctypes
+    data = _pool_to_bytes(s)
+    n = len(data)
+    if n <= len(buf):
+        ctypes.memmove(buf, data, n)
+        conn.send(n)
+    else:
+        conn.send(-1)
+        conn.send_bytes(data)
+
+
+def _pool_recv(conn, buf):
+    import ctypes
+    n = conn.recv()
+    if n < 0:
+        return _pool_from_bytes(conn.recv_bytes())
+    return _pool_from_bytes(ctypes.string_at(ctypes.addressof(buf), n))
+
+
+def _pool_loads(prob, s):
+    # Rebuild a population from its archive, re-attaching a real copy of the
+    # problem (the archive does not carry the state of pythonic problems).
+    pop = population(prob)
+    pop.__setstate__((s, prob))
+    return pop
+
+
+def _pool_worker_target(conn, buf, parent_pid):
+    import pickle
+    algo, prob = None, None
+    while True:
+        # The pipe is not closed if the parent dies, as the other workers
+        # inherited its end: check periodically that the parent is alive.
+        while not conn.poll(1):
+            if _os.getppid() != parent_pid:
+                return
+        payload = conn.recv()
+        if payload is None:
+            break
+        try:
+            if len(payload):
+                algo, prob = pickle.loads(payload)
+            pop = _pool_loads(prob, _pool_recv(conn, buf))
+            retval = algo.evolve(pop).cpp_dumps()
+        except BaseException as e:
+            conn.send(str(e))
+            continue
+        conn.send(None)
+        _pool_send(conn, buf, retval)
+
+
+class _pool_worker(object):
+
+    def __init__(self, buffer_size):
+        import multiprocessing as mp
+        self.buffer = mp.RawArray('c', buffer_size)
+        self.conn, child_conn = mp.Pipe()
+        self.process = mp.Process(
+            target=_pool_worker_target, args=(child_conn, self.buffer, _os.getpid()))
+        self.process.daemon = True
+        self.process.start()
+        child_conn.close()
+        # Digest of the (algorithm, problem) pair held by the worker.
+        self.key = None
+
+    def stop(self):
+        try:
+            self.conn.send(None)
+        except BaseException:
+            pass
+        self.process.join()
+        self.conn.close()
+
+
+class _island_pool(object):
+
+    def __init__(self):
+        self.size = None
+        self.buffer_size = 1 << 22
+        self.workers = []
+        self.idle = None
+
+    def acquire(self):
+        # The worker list is only modified under _process_lock, see the
+        # comments in py_island._perform_evolution.
+        with _process_lock:
+            if self.idle is None:
+                import multiprocessing as mp
+                try:
+                    from queue import Queue
+                except ImportError:
+                    from Queue import Queue
+                size = self.size if self.size else mp.cpu_count()
+                self.idle = Queue()
+                for i in range(size):
+                    w = _pool_worker(self.buffer_size)
+                    self.workers.append(w)
+                    self.idle.put(w)
+            idle = self.idle
+        return idle.get()
+
+    def release(self, w):
+        self.idle.put(w)
+
+    def discard(self, w):
+        # A worker whose pipe is in an unknown state is replaced by a fresh
+        # one.
+        with _process_lock:
+            w.stop()
+            self.workers.remove(w)
+            n = _pool_worker(self.buffer_size)
+            self.workers.append(n)
+        self.idle.put(n)
+
+    def shutdown(self):
+        with _process_lock:
+            for w in self.workers:
+                w.stop()
+            self.workers = []
+            self.idle = None
+
+_pool = _island_pool()
+
+
+class py_pool_island(base_island):
+
+    """Python process pool island.
+
+    Like :class:`py_island`, this island dispatches each evolution to a separate Python interpreter,
+    but the interpreters are persistent worker processes shared by all the pool islands. The algorithm
+    and the problem are sent to a worker only when they change, and populations are exchanged
+    through shared memory buffers, so that short evolutions do not pay for a process spawn each time.
+
+    The number of workers defaults to the number of CPUs and can be changed with :meth:`set_pool_size`.
+
+    """
+    __init__ = _generic_island_ctor
+
+    def _perform_evolution(self, algo, pop):
+        import pickle
+        import hashlib
+        try:
+            prob = pop.problem
+            payload = pickle.dumps((algo, prob), pickle.HIGHEST_PROTOCOL)
+            key = hashlib.sha1(payload).digest()
+            w = _pool.acquire()
+            try:
+                if w.key == key:
+                    w.conn.send(b'')
+                else:
+                    w.key = None
+                    w.conn.send(payload)
+                _pool_send(w.conn, w.buffer, pop.cpp_dumps())
+                err = w.conn.recv()
+                if err is None:
+                    w.key = key
+                    retval = _pool_loads(prob, _pool_recv(w.conn, w.buffer))
+            except BaseException:
+                _pool.discard(w)
+                raise
+            _pool.release(w)
+            if err is not None:
+                raise RuntimeError(err)
+            return retval
+        except BaseException as e:
+            print('Exception caught during evolution:')
+            print(e)
+            raise RuntimeError()
+
+    @staticmethod
+    def set_pool_size(n):
+        """Set the number of worker processes, stopping the current ones.
+
+        The pool is restarted lazily by the next evolution; this must not be called while
+        pool islands are evolving.
+
+        USAGE: py_pool_island.set_pool_size(4)
+
+        * n: number of workers (0 means the number of CPUs)
+        """
+        n = int(n)
+        if n < 0:
+            raise ValueError('the pool size must be non-negative')
+        _pool.shutdown()
+        _pool.size = n
+
+    def get_name(self):
+        return "Python process pool island"
+
 # This is the function that will be called by the task client
 # in ipy_island.
 
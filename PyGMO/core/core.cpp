@@ -28,6 +28,8 @@
 #include <boost/python/copy_const_reference.hpp>
 #include <boost/python/enum.hpp>
 #include <boost/python/extract.hpp>
+#include <boost/python/import.hpp>
+#include <boost/python/make_constructor.hpp>
 #include <boost/python/make_function.hpp>
 #include <boost/python/module.hpp>
 #include <boost/python/operators.hpp>
@@ -38,6 +40,7 @@
 #include <boost/python/overloads.hpp>
 #include <boost/utility.hpp> // For boost::noncopyable.
 #include <boost/array.hpp>
+#include <algorithm>
 #include <sstream>
 #include <vector>
 
@@ -140,6 +143,64 @@ inline static void population_repair(population &pop, const int &idx, const algo
 	pop.repair(boost::numeric_cast<population::size_type>(idx),repair_algo);
 }
 
+// Population constructors releasing the GIL during the initialisation of the individuals. The problem may be used
+// by other Python threads meanwhile, so it is cloned before the GIL is released.
+static inline boost::shared_ptr<population> population_ctor(const problem::base &prob, int n, boost::uint32_t seed)
+{
+	const problem::base_ptr prob_copy = prob.clone();
+	scoped_gil_release release;
+	return boost::shared_ptr<population>(new population(*prob_copy,n,seed));
+}
+
+static inline boost::shared_ptr<population> population_ctor_n(const problem::base &prob, int n)
+{
+	return population_ctor(prob,n,population::getSeed());
+}
+
+static inline boost::shared_ptr<population> population_ctor_prob(const problem::base &prob)
+{
+	return population_ctor_n(prob,0);
+}
+
+// Bulk export of one of the vectors of the individuals into a 2-D NumPy array, one row per individual.
+template <std::vector<double> population::individual_type::*Member>
+static inline boost::python::object population_get_block(const population &pop)
+{
+	using namespace boost::python;
+	const population::size_type n = pop.size();
+	const std::vector<double>::size_type m = n ? (pop.get_individual(0).*Member).size() : 0u;
+	object retval = import("numpy").attr("empty")(make_tuple(n,m));
+	py_buffer_view view(retval,PyBUF_WRITABLE);
+	view.check(n * m);
+	double *data = static_cast<double *>(view.data());
+	for (population::size_type i = 0; i < n; ++i, data += m) {
+		const std::vector<double> &v = pop.get_individual(i).*Member;
+		pagmo_assert(v.size() == m);
+		std::copy(v.begin(),v.end(),data);
+	}
+	return retval;
+}
+
+// Set the decision vectors of all the individuals from a 2-D array-like object, one row per individual.
+inline static void population_set_x_block(population &pop, const boost::python::object &x)
+{
+	using namespace boost::python;
+	object numpy = import("numpy");
+	const object x_array = numpy.attr("ascontiguousarray")(x,"float64");
+	const population::size_type n = pop.size();
+	const decision_vector::size_type dim = pop.problem().get_dimension();
+	if (x_array.attr("shape") != make_tuple(n,dim)) {
+		pagmo_throw(value_error,"the array of decision vectors must have shape (population size, problem dimension)");
+	}
+	std::vector<double> block(n * dim);
+	py_buffer_to_vector(block,x_array);
+	std::vector<decision_vector> xs(n);
+	for (population::size_type i = 0; i < n; ++i) {
+		xs[i].assign(block.begin() + i * dim,block.begin() + (i + 1) * dim);
+	}
+	pop.set_x(xs);
+}
+
 struct __PAGMO_VISIBLE population_pickle_suite : boost::python::pickle_suite
 {
 	static boost::python::tuple getinitargs(const population &pop)
@@ -280,7 +341,10 @@ BOOST_PYTHON_MODULE(_core)
 	typedef std::vector<population::size_type> (population::*get_best_N_idx)(const population::size_type& N) const;
 
 
-	class_<population>("population", "Population class.", init<const problem::base &,optional<int, boost::uint32_t> >())
+	class_<population>("population", "Population class.", no_init)
+		.def("__init__", make_constructor(&population_ctor_prob))
+		.def("__init__", make_constructor(&population_ctor_n))
+		.def("__init__", make_constructor(&population_ctor))
 		.def(init<const population &>())
 		.def("__copy__", &Py_copy_from_ctor<population>)
 		.def("__deepcopy__", &Py_deepcopy_from_ctor<population>)
@@ -300,6 +364,14 @@ BOOST_PYTHON_MODULE(_core)
 		.def("get_best_idx",get_best_N_idx(&population::get_best_idx),"Get index of best N individual.")
 		.def("get_worst_idx",&population::get_worst_idx,"Get index of worst individual.")
 		.def("set_x", &population_set_x,"Set decision vector of individual at position n.")
+		.def("set_x", &population_set_x_block,"Set the decision vectors of all the individuals from a 2-D array, one row per individual.")
+		.def("get_cur_x", &population_get_block<&population::individual_type::cur_x>,"Return the current decision vectors as a 2-D NumPy array, one row per individual.")
+		.def("get_cur_v", &population_get_block<&population::individual_type::cur_v>,"Return the current velocity vectors as a 2-D NumPy array, one row per individual.")
+		.def("get_cur_f", &population_get_block<&population::individual_type::cur_f>,"Return the current fitness vectors as a 2-D NumPy array, one row per individual.")
+		.def("get_cur_c", &population_get_block<&population::individual_type::cur_c>,"Return the current constraint vectors as a 2-D NumPy array, one row per individual.")
+		.def("get_best_x", &population_get_block<&population::individual_type::best_x>,"Return the best decision vectors as a 2-D NumPy array, one row per individual.")
+		.def("get_best_f", &population_get_block<&population::individual_type::best_f>,"Return the best fitness vectors as a 2-D NumPy array, one row per individual.")
+		.def("get_best_c", &population_get_block<&population::individual_type::best_c>,"Return the best constraint vectors as a 2-D NumPy array, one row per individual.")
 		.def("set_v", &population_set_v,"Set velocity of individual at position n.")
 		.def("push_back", &population::push_back,"Append individual with given decision vector at the end of the population.")
 		.def("erase", &population::erase, "Erase individual at position")
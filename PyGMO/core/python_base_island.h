@@ -74,23 +74,6 @@ namespace pagmo {
 // Base island class for re-implementation from Python.
 class __PAGMO_VISIBLE python_base_island:  public base_island, public boost::python::wrapper<base_island>
 {
-		// RAII gil releaser. See:
-		// http://wiki.python.org/moin/boost.python/HowTo#MultithreadingSupportformyfunction
-		class scoped_gil_release
-		{
-			public:
-				scoped_gil_release()
-				{
-					m_thread_state = PyEval_SaveThread();
-				}
-				~scoped_gil_release()
-				{
-					PyEval_RestoreThread(m_thread_state);
-					m_thread_state = NULL;
-				}
-			private:
-				PyThreadState *m_thread_state;
-		};
 	public:
 		explicit python_base_island(const algorithm::base &algo, const problem::base &prob, int n = 0,
 			const double &migr_prob = 1,
@@ -40,6 +40,7 @@
 #include "../../src/serialization.h"
 #include "../algorithm/python_base.h"
 #include "../problem/python_base.h"
+#include "../utils.h"
 
 // Forward declarations.
 namespace pagmo {
@@ -65,22 +66,6 @@ namespace pagmo {
 // computations.
 class __PAGMO_VISIBLE python_island: public island
 {
-		// RAII gil releaser.
-		class scoped_gil_release
-		{
-			public:
-				scoped_gil_release()
-				{
-					m_thread_state = PyEval_SaveThread();
-				}
-				~scoped_gil_release()
-				{
-					PyEval_RestoreThread(m_thread_state);
-					m_thread_state = NULL;
-				}
-			private:
-				PyThreadState *m_thread_state;
-		};
 	public:
 		explicit python_island(const algorithm::base &algo, const problem::base &prob, int n = 0,
 			const double &migr_prob = 1,
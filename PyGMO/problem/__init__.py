@@ -33,12 +33,13 @@ try:
         sides=[
             0.6,
             0.7,
-            0.8]):
+            0.8],
+        n_threads=1):
         """
         Construct a Neurocontroller Evolution problem that seeks to drive three point masses to form a triangle
         This problem was used to design a contorller for the MIT SPHERES test bed on boear the ISS
 
-        USAGE: problem.mit_spheres(sample_size = 10, n_hidden = 10, ode_prec = 1E-3, seed = 0, symmetric = False, simulation_time = 50.0):
+        USAGE: problem.mit_spheres(sample_size = 10, n_hidden = 10, ode_prec = 1E-3, seed = 0, symmetric = False, simulation_time = 50.0, sides = [0.6,0.7,0.8], n_threads = 1):
 
         * sample_size: number of initial conditions the neurocontroller is tested from
         * n_hidden: number of hidden  for the feed-forward neural network
@@ -47,6 +48,7 @@ try:
         * symmetric: when True activates a Neural Network having symmetric weights (i.e. purely homogeneuos agents)
         * simulation_time: when True activates a Neural Network having symmetric weights (i.e. purely homogeneuos agents)
         * sides: sides of the triangle
+        * n_threads: number of threads integrating the initial conditions concurrently
 
 """
 
@@ -60,6 +62,7 @@ try:
         arg_list.append(symmetric)
         arg_list.append(simulation_time)
         arg_list.append(sides)
+        arg_list.append(n_threads)
         self._orig_init(*arg_list)
     mit_spheres._orig_init = mit_spheres.__init__
     mit_spheres.__init__ = _mit_spheres_ctor
@@ -196,19 +199,21 @@ griewank._orig_init = griewank.__init__
 griewank.__init__ = _dejong_ctor
 
 
-def _lennard_jones_ctor(self, n_atoms=4):
+def _lennard_jones_ctor(self, n_atoms=4, cutoff=0.):
     """
     Constructs a Lennard-Jones problem (Box-Constrained Continuous Single-Objective)
 
-    USAGE: problem.lennard_jones(n_atoms=4)
+    USAGE: problem.lennard_jones(n_atoms=4, cutoff=0.)
 
     * n_atoms: number of atoms
+    * cutoff: pairs of atoms further apart than this are neglected (0 considers all pairs)
     """
 
     # We construct the arg list for the original constructor exposed by
     # boost_python
     arg_list = []
     arg_list.append(n_atoms)
+    arg_list.append(cutoff)
     self._orig_init(*arg_list)
 lennard_jones._orig_init = lennard_jones.__init__
 lennard_jones.__init__ = _lennard_jones_ctor
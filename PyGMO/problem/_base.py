@@ -8,6 +8,11 @@ class base(_base):
     in PyGMO, the user needs to write a class that inherits from this base class and needs to call its constructor.
     He will then need to re-implement a number of virtual functions that define the problem objectives and constraints,
     as well as defining the box-bounds on the decision vector.
+
+    Besides _objfun_impl(self, x), a problem can optionally implement _objfun_batch_impl(self, X), which receives
+    a NumPy array whose rows are decision vectors and must return an array whose rows are the corresponding fitness
+    vectors. When present, it is used by the algorithms that evaluate whole batches of decision vectors (e.g., when
+    initialising a population), so that vectorised NumPy code can replace one Python call per decision vector.
     """
 
     def __init__(self, *args):
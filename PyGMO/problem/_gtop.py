@@ -175,7 +175,7 @@ sagas.__init__ = _sagas_ctor
 gtoc_2.obj = _gtoc_2_objective
 
 
-def _gtoc_2_ctor(self, ast1=815, ast2=300, ast3=110, ast4=47, n_seg=10, objective=gtoc_2.obj.MASS_TIME):
+def _gtoc_2_ctor(self, ast1=815, ast2=300, ast3=110, ast4=47, n_seg=10, objective=gtoc_2.obj.MASS_TIME, n_threads=1):
     """
     Constructs a GTOC 2 Problem (Constrained Continuous Single-Objective)
 
@@ -184,7 +184,7 @@ def _gtoc_2_ctor(self, ast1=815, ast2=300, ast3=110, ast4=47, n_seg=10, objectiv
           difficult to find feasible solutions. Note that by default the asteroid sequence is the winning one
           from Turin University.
 
-    USAGE: problem.gtoc_2(ast1 = 815, ast2 = 300, ast3 = 110, ast4 = 47, n_seg = 10, objective = gtoc_2.obj.MASS_TIME)
+    USAGE: problem.gtoc_2(ast1 = 815, ast2 = 300, ast3 = 110, ast4 = 47, n_seg = 10, objective = gtoc_2.obj.MASS_TIME, n_threads = 1)
 
     * ast1 id of the first asteroid to visit (Group 1:   0 - 95)
     * ast2 id of the second asteroid to visit (Group 2:  96 - 271)
@@ -192,6 +192,7 @@ def _gtoc_2_ctor(self, ast1=815, ast2=300, ast3=110, ast4=47, n_seg=10, objectiv
     * ast4 id of the fourth asteroid to visit (Group 4: 572 - 909)
     * n_seg number of segments to be used per leg
     * obj objective function in the enum {MASS,TIME,MASS_TIME}
+    * n_threads number of threads used to evaluate the four legs
     """
 
     # We construct the arg list for the original constructor exposed by
@@ -203,6 +204,7 @@ def _gtoc_2_ctor(self, ast1=815, ast2=300, ast3=110, ast4=47, n_seg=10, objectiv
     arg_list.append(ast4)
     arg_list.append(n_seg)
     arg_list.append(objective)
+    arg_list.append(n_threads)
     self._orig_init(*arg_list)
 gtoc_2._orig_init = gtoc_2.__init__
 gtoc_2.__init__ = _gtoc_2_ctor
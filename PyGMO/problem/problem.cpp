@@ -30,7 +30,6 @@
 #include <boost/python/module.hpp>
 #include <boost/python/operators.hpp>
 #include <boost/python/make_constructor.hpp>
-#include <boost/python/register_ptr_to_python.hpp>
 #include <boost/utility.hpp>
 #include <cstddef>
 #include <string>
@@ -184,6 +183,7 @@ BOOST_PYTHON_MODULE(_problem) {
 	typedef void (problem::base::*best_x_setter)(const std::vector<decision_vector>&);
 	typedef constraint_vector (problem::base::*return_constraints)(const decision_vector &) const;
 	typedef fitness_vector (problem::base::*return_fitness)(const decision_vector &) const;
+	typedef std::vector<fitness_vector> (problem::base::*return_fitness_batch)(const std::vector<decision_vector> &) const;
     class_<problem::python_base, boost::noncopyable>("_base",init<int,optional<int,int,int,int,const std::vector<double> &> >())
 		.def(init<const decision_vector &, const decision_vector &, optional<int,int,int,int, const double &> >())
 		.def(init<int,int,int,int,int,const double>())
@@ -219,12 +219,14 @@ BOOST_PYTHON_MODULE(_problem) {
 		.def("feasibility_c",&problem::base::feasibility_c,"Determine feasibility of constraint vector.")
 		// Fitness.
 		.def("objfun",return_fitness(&problem::base::objfun),"Compute and return fitness vector.")
+		.def("objfun_batch",return_fitness_batch(&problem::base::objfun_batch),"Compute and return the fitness vectors of a sequence of decision vectors.")
 		.def("compare_fitness",&problem::base::compare_fitness,"Compare fitness vectors.")
 		// Virtual methods that can be (re)implemented.
 		.def("get_name",&problem::base::get_name,&problem::python_base::default_get_name)
 		.def("human_readable_extra", &problem::base::human_readable_extra, &problem::python_base::default_human_readable_extra)
 		.def("_get_typename",&problem::python_base::get_typename)
 		.def("_objfun_impl",&problem::python_base::py_objfun)
+		.def("_objfun_batch_impl",&problem::python_base::py_objfun_batch)
 		.def("_equality_operator_extra",&problem::python_base::py_equality_operator_extra)
 		.def("_compute_constraints_impl",&problem::python_base::py_compute_constraints_impl)
 		.def("_compare_constraints_impl",&problem::python_base::py_compare_constraints_impl)
@@ -315,7 +317,7 @@ BOOST_PYTHON_MODULE(_problem) {
 
 	// Lennard Jones problem.
 	problem_wrapper<problem::lennard_jones>("lennard_jones","Lennard Jones problem.")
-		.def(init<int>());
+		.def(init<int, double>());
 
 	// Levy5 problem.
 	problem_wrapper<problem::levy5>("levy5","Levy5 problem.")
@@ -562,7 +564,7 @@ BOOST_PYTHON_MODULE(_problem) {
 
 	// GTOC2 problem.
 	problem_wrapper<problem::gtoc_2>("gtoc_2","GTOC 2 problem (LT model).")
-		.def(init<optional<int,int,int,int,int,problem::gtoc_2::objective> >());
+		.def(init<optional<int,int,int,int,int,problem::gtoc_2::objective,unsigned int> >());
 
 	// GTOC2's objectives enum.
 	enum_<problem::gtoc_2::objective>("_gtoc_2_objective")
@@ -643,7 +645,7 @@ BOOST_PYTHON_MODULE(_problem) {
 #ifdef PAGMO_ENABLE_GSL
 	// Spheres Problems
 	stochastic_problem_wrapper<problem::spheres>("mit_spheres", "Spheres problem, a neurocontroller for the MIT test-bed (absolute perception-action)")
-		.def(init< optional<int,int,double,unsigned int, bool, double, std::vector<double> > >())
+		.def(init< optional<int,int,double,unsigned int, bool, double, std::vector<double>, unsigned int > >())
 		.def("post_evaluate", &problem::spheres::post_evaluate)
 		.def("simulate", &problem::spheres::simulate)
 		.def("get_nn_weights", &problem::spheres::get_nn_weights)
@@ -657,5 +659,6 @@ BOOST_PYTHON_MODULE(_problem) {
 #endif
 
 	// Register to_python conversion from smart pointer.
-	register_ptr_to_python<problem::base_ptr>();
+	// Pointers to Python-reimplemented problems are converted back to their Python objects.
+	to_python_converter<problem::base_ptr,py_object_ptr_to_python<problem::base> >();
 }
@@ -27,7 +27,9 @@
 
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/python/class.hpp>
+#include <boost/python/import.hpp>
 #include <string>
+#include <vector>
 
 #include "../../src/config.h"
 #include "../../src/exceptions.h"
@@ -66,14 +68,18 @@ class __PAGMO_VISIBLE python_base: public base, public boost::python::wrapper<ba
 			base(lb,ub,ni,nf,nc,nic,c_tol), boost::python::wrapper<base>() {}
 		base_ptr clone() const
 		{
-			base_ptr retval = this->get_override("__get_deepcopy__")();
-			if (!retval) {
+			gil_state_lock lock;
+			const boost::python::object retval = this->get_override("__get_deepcopy__")();
+			base *ptr = boost::python::extract<base *>(retval);
+			if (!ptr) {
 				pagmo_throw(std::runtime_error,"problem's __get_deepcopy__() method returns a NULL pointer, please check the implementation");
 			}
-			return retval;
+			// The Python object is released with the GIL held, see py_object_deleter.
+			return base_ptr(ptr,py_object_deleter<base>(retval.ptr()));
 		}
 		std::string get_name() const
 		{
+			gil_state_lock lock;
 			if (boost::python::override f = this->get_override("get_name")) {
 			#if BOOST_WORKAROUND(BOOST_MSVC, <= 1700)
 				return boost::python::call<std::string>(this->get_override("get_name").ptr());
@@ -89,6 +95,7 @@ class __PAGMO_VISIBLE python_base: public base, public boost::python::wrapper<ba
 		}
 		std::string human_readable_extra() const
 		{
+			gil_state_lock lock;
 			if (boost::python::override f = this->get_override("human_readable_extra")) {
 			#if BOOST_WORKAROUND(BOOST_MSVC, <= 1700)
 				return boost::python::call<std::string>(this->get_override("human_readable_extra").ptr());
@@ -105,13 +112,23 @@ class __PAGMO_VISIBLE python_base: public base, public boost::python::wrapper<ba
 		}
 		fitness_vector py_objfun(const decision_vector &x) const
 		{
+			gil_state_lock lock;
 			if (boost::python::override f = this->get_override("_objfun_impl")) {
 				return f(x);
 			}
 			pagmo_throw(not_implemented_error,"objective function has not been implemented");
 		}
+		boost::python::object py_objfun_batch(const boost::python::object &x) const
+		{
+			gil_state_lock lock;
+			if (boost::python::override f = this->get_override("_objfun_batch_impl")) {
+				return f(x);
+			}
+			pagmo_throw(not_implemented_error,"batch objective function has not been implemented");
+		}
 		std::string get_typename() const
 		{
+			gil_state_lock lock;
 			if (boost::python::override f = this->get_override("_get_typename")) {
 			#if BOOST_WORKAROUND(BOOST_MSVC, <= 1700)
 				return boost::python::call<std::string>(this->get_override("_get_typename").ptr());
@@ -123,6 +140,7 @@ class __PAGMO_VISIBLE python_base: public base, public boost::python::wrapper<ba
 		}
 		bool py_equality_operator_extra(const base &p) const
 		{
+			gil_state_lock lock;
 			if (boost::python::override f = this->get_override("_equality_operator_extra")) {
 				return f(p);
 			}
@@ -130,24 +148,28 @@ class __PAGMO_VISIBLE python_base: public base, public boost::python::wrapper<ba
 		}
 		constraint_vector py_compute_constraints_impl(const decision_vector &x) const
 		{
+			gil_state_lock lock;
 			boost::python::override f = this->get_override("_compute_constraints_impl");
 			pagmo_assert(f);
 			return f(x);
         }
         bool py_compare_fitness_impl(const fitness_vector &f0, const fitness_vector &f1) const
         {
+            gil_state_lock lock;
             boost::python::override f = this->get_override("_compare_fitness_impl");
             pagmo_assert(f);
             return f(f0, f1);
         }
         bool py_compare_constraints_impl(const constraint_vector &c0, const constraint_vector &c1) const
         {
+            gil_state_lock lock;
             boost::python::override f = this->get_override("_compare_constraints_impl");
             pagmo_assert(f);
             return f(c0, c1);
         }
         bool py_compare_fc_impl(const fitness_vector &f0, const constraint_vector &c0, const fitness_vector &f1, const constraint_vector &c1) const
         {
+            gil_state_lock lock;
             boost::python::override f = this->get_override("_compare_fc_impl");
             pagmo_assert(f);
             return f(f0, c0, f1, c1);
@@ -158,6 +180,31 @@ class __PAGMO_VISIBLE python_base: public base, public boost::python::wrapper<ba
 		{
 			f = py_objfun(x);
 		}
+		// If the Python problem implements _objfun_batch_impl(), the whole block is evaluated with a single
+		// call exchanging NumPy arrays. Otherwise, fall back to one _objfun_impl() call per decision vector.
+		void objfun_batch_impl(std::vector<double> &f, const std::vector<double> &x, size_type n) const
+		{
+			gil_state_lock lock;
+			boost::python::override f_batch = this->get_override("_objfun_batch_impl");
+			if (!f_batch) {
+				base::objfun_batch_impl(f,x,n);
+				return;
+			}
+			using namespace boost::python;
+			object numpy = import("numpy");
+			// The block is stored as structure-of-arrays: copy it into a (dimension,n) array
+			// and pass the (n,dimension) transposed view.
+			object X = numpy.attr("empty")(make_tuple(get_dimension(),n));
+			vector_to_py_buffer(X,x);
+			object F = f_batch(object(X.attr("T")));
+			// Same trick on the way back: the transpose of the (n,f_dimension) fitness array
+			// is laid out as our fitness block.
+			F = numpy.attr("ascontiguousarray")(object(numpy.attr("asarray")(F,"float64").attr("T")));
+			if (F.attr("shape") != make_tuple(get_f_dimension(),n)) {
+				pagmo_throw(value_error,"_objfun_batch_impl() must return an array of shape (number of decision vectors, fitness dimension)");
+			}
+			py_buffer_to_vector(f,F);
+		}
 		bool equality_operator_extra(const base &p) const
 		{
 			// NOTE: here the dynamic cast is safe because in base equality we already checked the C++ type.
@@ -168,6 +215,7 @@ class __PAGMO_VISIBLE python_base: public base, public boost::python::wrapper<ba
 		}
 		void compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
 		{
+			gil_state_lock lock;
 			if (this->get_override("_compute_constraints_impl")) {
 				// If the function is overridden, use it.
 				c = py_compute_constraints_impl(x);
@@ -178,6 +226,7 @@ class __PAGMO_VISIBLE python_base: public base, public boost::python::wrapper<ba
 		}
         bool compare_fitness_impl(const fitness_vector &f0, const fitness_vector &f1) const
         {
+            gil_state_lock lock;
             if(this->get_override("_compare_fitness_impl")) {
                 // if the function is overidden, use it
                 return py_compare_fitness_impl(f0, f1);
@@ -188,6 +237,7 @@ class __PAGMO_VISIBLE python_base: public base, public boost::python::wrapper<ba
         }
         bool compare_constraints_impl(const constraint_vector &c0, const constraint_vector &c1) const
         {
+            gil_state_lock lock;
             if(this->get_override("_compare_constraints_impl")) {
                 // if the function is overidden, use it
                 return py_compare_constraints_impl(c0, c1);
@@ -198,6 +248,7 @@ class __PAGMO_VISIBLE python_base: public base, public boost::python::wrapper<ba
         }
         bool compare_fc_impl(const fitness_vector &f0, const constraint_vector &c0, const fitness_vector &f1, const constraint_vector &c1) const
         {
+            gil_state_lock lock;
             if(this->get_override("_compare_fc_impl")) {
                 // if the function is overidden, use it
                 return py_compare_fc_impl(f0, c0, f1, c1);
@@ -62,14 +62,18 @@ class __PAGMO_VISIBLE python_base_stochastic: public base_stochastic, public boo
 			base_stochastic(n,seed), boost::python::wrapper<base_stochastic>() {}
 		base_ptr clone() const
 		{
-			base_ptr retval = this->get_override("__get_deepcopy__")();
-			if (!retval) {
+			gil_state_lock lock;
+			const boost::python::object retval = this->get_override("__get_deepcopy__")();
+			base *ptr = boost::python::extract<base *>(retval);
+			if (!ptr) {
 				pagmo_throw(std::runtime_error,"problem's __get_deepcopy__() method returns a NULL pointer, please check the implementation");
 			}
-			return retval;
+			// The Python object is released with the GIL held, see py_object_deleter.
+			return base_ptr(ptr,py_object_deleter<base>(retval.ptr()));
 		}
 		std::string get_name() const
 		{
+			gil_state_lock lock;
 			if (boost::python::override f = this->get_override("get_name")) {
 			#if BOOST_WORKAROUND(BOOST_MSVC, <= 1700)
 				return boost::python::call<std::string>(this->get_override("get_name").ptr());
@@ -85,6 +89,7 @@ class __PAGMO_VISIBLE python_base_stochastic: public base_stochastic, public boo
 		}
 		std::string human_readable_extra() const
 		{
+			gil_state_lock lock;
 			if (boost::python::override f = this->get_override("human_readable_extra")) {
 			#if BOOST_WORKAROUND(BOOST_MSVC, <= 1700)
 				return boost::python::call<std::string>(this->get_override("human_readable_extra").ptr());
@@ -100,6 +105,7 @@ class __PAGMO_VISIBLE python_base_stochastic: public base_stochastic, public boo
 		}
 		fitness_vector py_objfun(const decision_vector &x) const
 		{
+			gil_state_lock lock;
 			if (boost::python::override f = this->get_override("_objfun_impl")) {
 				return f(x);
 			}
@@ -107,6 +113,7 @@ class __PAGMO_VISIBLE python_base_stochastic: public base_stochastic, public boo
 		}
 		std::string get_typename() const
 		{
+			gil_state_lock lock;
 			if (boost::python::override f = this->get_override("_get_typename")) {
 			#if BOOST_WORKAROUND(BOOST_MSVC, <= 1700)
 				return boost::python::call<std::string>(this->get_override("_get_typename").ptr());
@@ -118,6 +125,7 @@ class __PAGMO_VISIBLE python_base_stochastic: public base_stochastic, public boo
 		}
 		bool py_equality_operator_extra(const base &p) const
 		{
+			gil_state_lock lock;
 			if (boost::python::override f = this->get_override("_equality_operator_extra")) {
 				return f(p);
 			}
@@ -125,24 +133,28 @@ class __PAGMO_VISIBLE python_base_stochastic: public base_stochastic, public boo
 		}
 		constraint_vector py_compute_constraints_impl(const decision_vector &x) const
 		{
+			gil_state_lock lock;
 			boost::python::override f = this->get_override("_compute_constraints_impl");
 			pagmo_assert(f);
 			return f(x);
         }
         bool py_compare_fitness_impl(const fitness_vector &f0, const fitness_vector &f1) const
         {
+            gil_state_lock lock;
             boost::python::override f = this->get_override("_compare_fitness_impl");
             pagmo_assert(f);
             return f(f0, f1);
         }
         bool py_compare_constraints_impl(const constraint_vector &c0, const constraint_vector &c1) const
         {
+            gil_state_lock lock;
             boost::python::override f = this->get_override("_compare_constraints_impl");
             pagmo_assert(f);
             return f(c0, c1);
         }
         bool py_compare_fc_impl(const fitness_vector &f0, const constraint_vector &c0, const fitness_vector &f1, const constraint_vector &c1) const
         {
+            gil_state_lock lock;
             boost::python::override f = this->get_override("_compare_fc_impl");
             pagmo_assert(f);
             return f(f0, c0, f1, c1);
@@ -163,6 +175,7 @@ class __PAGMO_VISIBLE python_base_stochastic: public base_stochastic, public boo
 		}
 		void compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
 		{
+			gil_state_lock lock;
 			if (this->get_override("_compute_constraints_impl")) {
 				// If the function is overridden, use it.
 				c = py_compute_constraints_impl(x);
@@ -173,6 +186,7 @@ class __PAGMO_VISIBLE python_base_stochastic: public base_stochastic, public boo
         }
         bool compare_fitness_impl(const fitness_vector &f0, const fitness_vector &f1) const
         {
+            gil_state_lock lock;
             if(this->get_override("_compare_fitness_impl")) {
                 // if the function is overidden, use it
                 return py_compare_fitness_impl(f0, f1);
@@ -183,6 +197,7 @@ class __PAGMO_VISIBLE python_base_stochastic: public base_stochastic, public boo
         }
         bool compare_constraints_impl(const constraint_vector &c0, const constraint_vector &c1) const
         {
+            gil_state_lock lock;
             if(this->get_override("_compare_constraints_impl")) {
                 // if the function is overidden, use it
                 return py_compare_constraints_impl(c0, c1);
@@ -193,6 +208,7 @@ class __PAGMO_VISIBLE python_base_stochastic: public base_stochastic, public boo
         }
         bool compare_fc_impl(const fitness_vector &f0, const constraint_vector &c0, const fitness_vector &f1, const constraint_vector &c1) const
         {
+            gil_state_lock lock;
             if(this->get_override("_compare_fc_impl")) {
                 // if the function is overidden, use it
                 return py_compare_fc_impl(f0, c0, f1, c1);
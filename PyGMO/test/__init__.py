@@ -22,6 +22,7 @@
 # 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 import unittest as _ut
+from PyGMO.problem import base as _problem_base
 
 
 class _serialization_test(_ut.TestCase):
@@ -76,6 +77,15 @@ class _island_torture_test(_ut.TestCase):
             for prob in prob_list:
                 self.__test_impl(isl_type, algo, prob)
 
+    def test_py_pool_island(self):
+        from PyGMO import py_pool_island, algorithm, problem
+        isl_type = py_pool_island
+        algo_list = [algorithm.py_example(1), algorithm.de(5)]
+        prob_list = [problem.py_example(), problem.dejong(1)]
+        for algo in algo_list:
+            for prob in prob_list:
+                self.__test_impl(isl_type, algo, prob)
+
     def test_ipy_island(self):
         from PyGMO import ipy_island, algorithm, problem
         try:
@@ -99,6 +109,225 @@ class _island_torture_test(_ut.TestCase):
                 self.__test_impl(isl_type, algo, prob)
 
 
+# Problems implemented in Python, with and without a vectorised batch objective
+# function (two objectives: squared distances from the origin and from
+# [1, ..., 1]).
+class _py_loop_problem(_problem_base):
+
+    def __init__(self, dim=6, n_obj=2):
+        super(_py_loop_problem, self).__init__(dim, 0, n_obj)
+        self.set_bounds(-2., 2.)
+
+    def _objfun_impl(self, x):
+        f = (sum([xi * xi for xi in x]),
+             sum([(xi - 1.) * (xi - 1.) for xi in x]))
+        return f[:self.f_dimension]
+
+
+class _py_batch_problem(_py_loop_problem):
+
+    def __init__(self, dim=6, n_obj=2, shape_error=False):
+        super(_py_batch_problem, self).__init__(dim, n_obj)
+        self.__shape_error = shape_error
+        self.batch_calls = 0
+
+    def _objfun_batch_impl(self, X):
+        import numpy
+        self.batch_calls += 1
+        F = numpy.column_stack(((X * X).sum(axis=1),
+                                ((X - 1.) * (X - 1.)).sum(axis=1)))
+        if self.__shape_error:
+            return F.T
+        return F[:, :self.f_dimension]
+
+
+class _problem_batch_test(_ut.TestCase):
+
+    def test_objfun_batch(self):
+        from random import Random
+        rng = Random(42)
+        for n_obj in [1, 2]:
+            for n in [1, 7, 100]:
+                xs = [[rng.uniform(-2., 2.) for j in range(6)]
+                      for i in range(n)]
+                prob = _py_batch_problem(6, n_obj)
+                batch = prob.objfun_batch(xs)
+                # The whole batch is evaluated by one call.
+                self.assertEqual(prob.batch_calls, 1)
+                # Without _objfun_batch_impl() each vector goes through
+                # _objfun_impl().
+                loop = _py_loop_problem(6, n_obj).objfun_batch(xs)
+                self.assertEqual(len(batch), n)
+                for x, fb, fl in zip(xs, batch, loop):
+                    f = _py_batch_problem(6, n_obj).objfun(x)
+                    self.assertEqual(len(fb), n_obj)
+                    for k in range(n_obj):
+                        self.assertAlmostEqual(fb[k], f[k], places=12)
+                        self.assertEqual(fl[k], f[k])
+
+    def test_objfun_batch_shape(self):
+        xs = [[0.5] * 6] * 3
+        self.assertRaises(
+            ValueError, _py_batch_problem(6, 2, True).objfun_batch, xs)
+
+
+class _population_block_test(_ut.TestCase):
+
+    def __probs(self):
+        from PyGMO import problem
+        return [problem.ackley(10), problem.zdt(1, 10), problem.cec2006(7)]
+
+    def test_get_block(self):
+        from PyGMO import population
+        for prob in self.__probs():
+            pop = population(prob, 23, 42)
+            blocks = [(pop.get_cur_x(), 'cur_x'), (pop.get_cur_v(), 'cur_v'),
+                      (pop.get_cur_f(), 'cur_f'), (pop.get_cur_c(), 'cur_c'),
+                      (pop.get_best_x(), 'best_x'),
+                      (pop.get_best_f(), 'best_f'),
+                      (pop.get_best_c(), 'best_c')]
+            for block, name in blocks:
+                self.assertEqual(block.shape[0], len(pop))
+                for i, ind in enumerate(pop):
+                    self.assertEqual(tuple(block[i]), getattr(ind, name))
+        # An empty population gives an empty array.
+        self.assertEqual(population(prob).get_cur_x().shape, (0, 0))
+
+    def test_set_x_block(self):
+        from PyGMO import population
+        for prob in self.__probs():
+            bulk = population(prob, 23, 42)
+            single = population(prob, 23, 42)
+            xs = population(prob, 23, 43).get_cur_x()
+            bulk.set_x(xs)
+            for i in range(len(single)):
+                single.set_x(i, xs[i])
+            self.assertEqual(bulk.get_cur_x().tolist(), xs.tolist())
+            for a, b in zip(bulk, single):
+                self.assertEqual(a.cur_x, b.cur_x)
+                self.assertEqual(a.cur_f, b.cur_f)
+                self.assertEqual(a.cur_c, b.cur_c)
+                self.assertEqual(a.best_x, b.best_x)
+                self.assertEqual(a.best_f, b.best_f)
+            self.assertEqual(bulk.champion.x, single.champion.x)
+            self.assertEqual(bulk.champion.f, single.champion.f)
+            self.assertEqual(bulk.compute_pareto_fronts(),
+                             single.compute_pareto_fronts())
+            # Lists of lists are accepted too.
+            bulk.set_x(xs.tolist())
+            self.assertEqual(bulk.get_cur_x().tolist(), xs.tolist())
+            # One row per individual, one column per dimension.
+            self.assertRaises(ValueError, bulk.set_x, xs[1:])
+            self.assertRaises(ValueError, bulk.set_x, xs[:, 1:])
+
+
+# The C++ computations release the GIL: the same objects are used from
+# several Python threads at once.
+class _gil_release_test(_ut.TestCase):
+
+    def __run(self, target, n_threads=6):
+        from threading import Thread
+        errors = []
+
+        def wrapper(i):
+            try:
+                target(i)
+            except Exception as e:
+                errors.append(e)
+        threads = [Thread(target=wrapper, args=(i,))
+                   for i in range(n_threads)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        self.assertEqual(errors, [])
+
+    def __check_pop(self, pop, prob):
+        # The fitness of each individual is the one of its decision vector.
+        for ind in pop:
+            self.assertEqual(ind.cur_f, prob.objfun(ind.cur_x))
+
+    def test_shared_problem(self):
+        from PyGMO import problem
+        from random import Random
+        prob, ref = problem.zdt(1, 10), problem.zdt(1, 10)
+        xs = [[[Random(i * 100 + j).random() for k in range(10)]
+               for j in range(50)] for i in range(6)]
+
+        def target(i):
+            for x in xs[i]:
+                self.assertEqual(prob.objfun(x), ref.objfun(x))
+            self.assertEqual(list(prob.objfun_batch(xs[i])),
+                             [ref.objfun(x) for x in xs[i]])
+        self.__run(target)
+        self.assertEqual(prob.fevals, 6 * 100)
+
+    def test_shared_algorithm(self):
+        from PyGMO import algorithm, population, problem
+        for make in [lambda: problem.ackley(10),
+                     lambda: _py_loop_problem(6, 1)]:
+            prob, ref, algo = make(), make(), algorithm.de(gen=20)
+            pops = [population(prob, 20, i) for i in range(6)]
+
+            def target(i):
+                for k in range(3):
+                    pops[i] = algo.evolve(pops[i])
+            self.__run(target)
+            for pop in pops:
+                self.__check_pop(pop, ref)
+
+    def test_evolve_state(self):
+        from PyGMO import algorithm, population, problem
+        # The random number generators of the algorithm advance across
+        # calls to evolve().
+        algo = algorithm.de(gen=5)
+        pop = population(problem.ackley(10), 20, 42)
+        self.assertNotEqual(algo.evolve(pop).get_cur_x().tolist(),
+                            algo.evolve(pop).get_cur_x().tolist())
+        algo.reset_rngs(42)
+        first = algo.evolve(pop).get_cur_x().tolist()
+        algo.reset_rngs(42)
+        self.assertEqual(algo.evolve(pop).get_cur_x().tolist(), first)
+        # Meta-algorithms keep their Python algorithms across calls.
+        algo = algorithm.mbh(algorithm.py_example(1))
+        for k in range(3):
+            pop = algo.evolve(pop)
+        self.assertEqual(type(algo.algorithm), algorithm.py_example)
+
+    def test_shared_population_problem(self):
+        from PyGMO import population, problem
+        prob = problem.zdt(2, 10)
+        pops = [None] * 6
+
+        def target(i):
+            pops[i] = population(prob, 30, i)
+        self.__run(target)
+        for pop in pops:
+            self.__check_pop(pop, problem.zdt(2, 10))
+
+    def test_shared_hypervolume(self):
+        from PyGMO import population, problem
+        from PyGMO.util import hypervolume, hv_algorithm
+        pop = population(problem.dtlz(2, 10, 4), 60, 42)
+        r = [max(ind.cur_f[k] for ind in pop) + 1. for k in range(4)]
+        for copy_points in [True, False]:
+            hv = hypervolume(pop)
+            hv.set_copy_points(copy_points)
+            algo = hv_algorithm.wfg()
+            expected = (hv.compute(r=r, algorithm=algo),
+                        hv.contributions(r=r, algorithm=algo))
+            points = hv.get_points()
+
+            def target(i):
+                for k in range(5):
+                    self.assertEqual(hv.compute(r=r, algorithm=algo),
+                                     expected[0])
+                    self.assertEqual(hv.contributions(r=r, algorithm=algo),
+                                     expected[1])
+            self.__run(target)
+            self.assertEqual(hv.get_points(), points)
+
+
 def run_serialization_test_suite():
     """Run the serialization test suite."""
     from PyGMO import test
@@ -11,13 +11,13 @@ class analysis:
     selection.
     """
 
-    def __init__(self, input_object, npoints=0, method='sobol', first=1, output_to_file=False):
+    def __init__(self, input_object, npoints=0, method='sobol', first=1, output_to_file=False, n_threads=0):
         """
         Constructor of the analysis class from a problem or population object. Also calls
         analysis.sample when npoints>0 or by default when a population object is input.
 
         **USAGE:**
-        analysis(input_object=prob [, npoints=1000, method='sobol', first=1, output_to_file=False])
+        analysis(input_object=prob [, npoints=1000, method='sobol', first=1, output_to_file=False, n_threads=0])
 
         * input_object: problem or population object used to initialise the analysis.
         * npoints: number of points of the search space to sample. If a population is input,
@@ -37,7 +37,10 @@ class analysis:
         * output_to_file: if True, all outputs generated by this class will be written to the file
           log.txt and all plots saved as .png images in the directory ./analysis_X/ which is specified
           in attribute analysis.dir. If False, all of them will be shown on screen.
+        * n_threads: number of threads used to evaluate the problem during the sampling and the tests.
+          If set to 0, the number of hardware threads is used. Stored as attribute analysis.n_threads.
         """
+        self.n_threads = n_threads
         self.npoints = 0
         self.points = []
         self.f = []
@@ -149,7 +152,7 @@ class analysis:
         **NOTE:** when calling sample, all sampling methods can be used and the search space is sampled within its box constraints. If a population has been input to the
         constructor, a subset of individuals are selected (randomly).
         """
-        from PyGMO.util import lhs, sobol, faure, halton
+        from PyGMO.util._util import _landscape_sample, _landscape_evaluate, _landscape_value_type
 
         self.points = []
         self.f = []
@@ -202,28 +205,16 @@ class analysis:
                     if j >= self.cont_dim:
                         r = round(r, 0)
                     self.points[i].append(r)
-                self.f.append(list(self.prob.objfun(self.points[i])))
+            self.f = _landscape_evaluate(
+                self.prob, self.points, _landscape_value_type.FITNESS, self.n_threads)
         else:
-            if method == 'sobol':
-                sampler = sobol(self.dim, first)
-            elif method == 'lhs':
-                sampler = lhs(self.dim, npoints)
-            elif method == 'faure':
-                sampler = faure(self.dim, first)
-            elif method == 'halton':
-                sampler = halton(self.dim, first)
-            else:
+            if method not in ['sobol', 'lhs', 'faure', 'halton']:
                 raise ValueError(
                     "analysis.sample: method specified is not valid. choose 'sobol', 'lhs', 'faure','halton', 'montecarlo' or 'pop'")
-            for i in range(npoints):
-                temp = list(sampler.next())  # sample in the unit hypercube
-                for j in range(self.dim):
-                    temp[j] = temp[j] * self.ub[j] + \
-                        (1 - temp[j]) * self.lb[j]  # resize
-                    if j >= self.cont_dim:
-                        temp[j] = round(temp[j], 0)  # round if necessary
-                self.points.append(temp)
-                self.f.append(list(self.prob.objfun(temp)))
+            # sample in the unit hypercube, resize and round if necessary
+            self.points = _landscape_sample(self.prob, method, npoints, first)
+            self.f = _landscape_evaluate(
+                self.prob, self.points, _landscape_value_type.FITNESS, self.n_threads)
 
         self.f_offset = self._percentile(0)
         self.f_span = self._ptp()
@@ -627,39 +618,19 @@ class analysis:
         if n_pairs == 0:
             n_pairs = self.npoints
         try:
-            from numpy.random import random, randint
-            from numpy import array, multiply, divide, zeros
+            from numpy import array, zeros
         except ImportError:
             raise ImportError(
                 "analysis._p_lin_conv needs numpy to run. Is it installed?")
+        from PyGMO.util._util import _landscape_linearity_deltas, _landscape_value_type
         p_lin = zeros(self.f_dim)
         p_conv = zeros(self.f_dim)
         mean_dev = zeros(self.f_dim)
-        for i in range(n_pairs):
-            i1 = randint(self.npoints)
-            i2 = randint(self.npoints)
-            while (i2 == i1):
-                i2 = randint(self.npoints)
-            r = random()
-            x = r * array(self.points[i1]) + (1 - r) * array(self.points[i2])
-
-            if self.cont_dim != self.dim:
-                x[self.cont_dim:] = self.points[i1][self.cont_dim:]
-                x = multiply(
-                    array(x), array(self.ub) - array(self.lb)) + array(self.lb)
-                x2 = multiply(array(self.points[i2][:self.cont_dim] + self.points[i1][
-                              self.cont_dim:]), array(self.ub) - array(self.lb)) + array(self.lb)
-                f2 = divide(
-                    array(self.prob.objfun(x2)) - array(self.f_offset), self.f_span)
-                f_lin = r * array(self.f[i1]) + (1 - r) * array(f2)
-            else:
-                x = multiply(
-                    array(x), array(self.ub) - array(self.lb)) + array(self.lb)
-                f_lin = r * array(self.f[i1]) + (1 - r) * array(self.f[i2])
-
-            f_real = divide(
-                array(self.prob.objfun(x)) - array(self.f_offset), self.f_span)
-            delta = f_lin - f_real
+        i1, i2, r = self._random_pairs(n_pairs)
+        deltas = _landscape_linearity_deltas(self.prob, self.points, self.f, self.f_offset, self.f_span,
+                                             i1, i2, r, _landscape_value_type.FITNESS, self.n_threads)
+        for delta in deltas:
+            delta = array(delta)
             mean_dev += abs(delta)
             for j in range(self.f_dim):
                 if abs(delta[j]) < threshold:
@@ -672,6 +643,29 @@ class analysis:
         self.lin_conv_npairs = n_pairs
         return (list(p_lin), list(p_conv), list(mean_dev))
 
+    def _random_pairs(self, n_pairs):
+        """
+        Draws the pairs of distinct points of the sample and the convex combination coefficients
+        used by the linearity tests.
+
+
+        **USAGE:**
+        analysis._random_pairs(n_pairs=100)
+
+
+        **Returns** a tuple of length 3 containing the lists of the indexes of the first points, of the
+        indexes of the second points and of the coefficients, each of length n_pairs.
+        """
+        from numpy.random import random, randint
+        i1, i2, r = [], [], []
+        for i in range(n_pairs):
+            i1.append(int(randint(self.npoints)))
+            i2.append(int(randint(self.npoints)))
+            while (i2[-1] == i1[-1]):
+                i2[-1] = int(randint(self.npoints))
+            r.append(random())
+        return (i1, i2, r)
+
     ##########################################################################
     # FITNESS REGRESSION
     ##########################################################################
@@ -1378,11 +1372,14 @@ class analysis:
             grad_points = [randint(self.npoints)
                            for i in range(sample_size)]  # avoid repetition?
 
-        grad = []
+        from PyGMO.util._util import _landscape_gradient, _landscape_value_type
+        if mode == 'f':
+            span, value_type = self.f_span, _landscape_value_type.FITNESS
+        else:
+            span, value_type = self.c_span, _landscape_value_type.CONSTRAINTS
+        grad = _landscape_gradient(self.prob, [self.points[i] for i in grad_points], span,
+                                   h, grad_tol, tmax, value_type, self.n_threads)
         grad_sparsity = 0
-        for i in grad_points:
-            grad.append(self._richardson_gradient(
-                x=self.points[i], h=h, grad_tol=grad_tol, tmax=tmax, mode=mode))
         average_abs_gradient = nanmean(abs(asarray(grad)), 0)
         for i in range(dim):
             for j in range(self.cont_dim):
@@ -1423,50 +1420,12 @@ class analysis:
 
         **NOTE:** all integer variables are ignored for this test.
         """
-        from numpy import array, zeros, amax
+        from PyGMO.util._util import _landscape_gradient, _landscape_value_type
         if mode == 'f':
-            function = self.prob.objfun
-            span = self.f_span
-            dim = self.f_dim
+            span, value_type = self.f_span, _landscape_value_type.FITNESS
         elif mode == 'c':
-            function = self.prob.compute_constraints
-            span = self.c_span
-            dim = self.c_dim
-        d = [[zeros([dim, self.cont_dim])], []]
-        hh = 2 * h
-        err = 1
-        t = 0
-        # descale
-        x = array(x) * (array(self.ub) - array(self.lb)) + array(self.lb)
-        while (err > grad_tol and t < tmax):
-            hh /= 2
-            for i in range(self.cont_dim):
-                xu = x.tolist()
-                xd = x.tolist()
-                xu[i] += hh * (self.ub[i] - self.lb[i])
-                xd[i] -= hh * (self.ub[i] - self.lb[i])
-                if xu[i] > self.ub[i] or xd[i] < self.lb[i]:
-                    tmp = zeros(dim)
-                else:
-                    # rescale
-                    tmp = (array(function(xu)) - array(function(xd))) / \
-                        (2 * hh * array(span))
-
-                for j in range(dim):
-                    d[t % 2][0][j][i] = tmp[j]
-
-            for k in range(1, t + 1):
-                d[t % 2][k] = d[t % 2][k - 1] + \
-                    (d[t % 2][k - 1] - d[(t + 1) % 2][k - 1]) / (4 ** k - 1)
-
-            if t > 0:
-                err = amax(abs(d[t % 2][t] - d[(t + 1) % 2][t - 1]))
-
-            d[(t + 1) %
-              2].extend([zeros([dim, self.cont_dim]), zeros([dim, self.cont_dim])])
-            t += 1
-
-        return d[(t + 1) % 2][t - 1].tolist()
+            span, value_type = self.c_span, _landscape_value_type.CONSTRAINTS
+        return _landscape_gradient(self.prob, [x], span, h, grad_tol, tmax, value_type, 1)[0]
 
     def _get_hessian(self, sample_size=0, h=0.01, hess_tol=0.000001, tmax=15):
         """
@@ -1510,10 +1469,9 @@ class analysis:
             self.hess_points = [randint(self.npoints)
                                 for i in range(sample_size)]
 
-        self.hess = []
-        for i in self.hess_points:
-            self.hess.append(
-                self._richardson_hessian(x=self.points[i], h=h, hess_tol=hess_tol, tmax=tmax))
+        from PyGMO.util._util import _landscape_hessian
+        self.hess = _landscape_hessian(self.prob, [self.points[i] for i in self.hess_points], self.f_span,
+                                       h, hess_tol, tmax, self.n_threads)
 
     def _richardson_hessian(self, x, h, hess_tol, tmax=15):
         """
@@ -1537,86 +1495,8 @@ class analysis:
 
         **NOTE:** all integer variables are ignored for this test.\n
         """
-        from numpy import array, zeros, amax
-        from itertools import combinations_with_replacement
-        ind = list(combinations_with_replacement(range(self.cont_dim), 2))
-        n_ind = len(ind)
-        d = [[zeros([self.f_dim, n_ind])], []]
-        hh = 2 * h
-        err = 1
-        t = 0
-        x = array(x) * (array(self.ub) - array(self.lb)) + array(self.lb)
-        while (err > hess_tol and t < tmax):
-            hh /= 2
-            for i in range(n_ind):
-                xu = x.tolist()
-                xd = x.tolist()
-                xuu = x.tolist()
-                xdd = x.tolist()
-                xud = x.tolist()
-                xdu = x.tolist()
-
-                if ind[i][0] == ind[i][1]:
-                    xu[ind[i][0]] = xu[ind[i][0]] + hh * \
-                        (self.ub[ind[i][0]] - self.lb[ind[i][0]])
-                    xd[ind[i][0]] -= hh * \
-                        (self.ub[ind[i][0]] - self.lb[ind[i][0]])
-                    if xu[ind[i][0]] > self.ub[ind[i][0]] or xd[ind[i][0]] < self.lb[ind[i][0]]:
-                        tmp = zeros(self.f_dim)
-                    else:
-                        # rescale
-                        tmp = (array(self.prob.objfun(xu)) - 2 * array(self.prob.objfun(x)) +
-                               array(self.prob.objfun(xd))) / ((hh ** 2) * array(self.f_span))
-
-                else:
-                    xuu[ind[i][0]] += hh * \
-                        (self.ub[ind[i][0]] - self.lb[ind[i][0]])
-                    xuu[ind[i][1]] += hh * \
-                        (self.ub[ind[i][1]] - self.lb[ind[i][1]])
-                    xdd[ind[i][0]] -= hh * \
-                        (self.ub[ind[i][0]] - self.lb[ind[i][0]])
-                    xdd[ind[i][1]] -= hh * \
-                        (self.ub[ind[i][1]] - self.lb[ind[i][1]])
-                    xud[ind[i][0]] += hh * \
-                        (self.ub[ind[i][0]] - self.lb[ind[i][0]])
-                    xud[ind[i][1]] -= hh * \
-                        (self.ub[ind[i][1]] - self.lb[ind[i][1]])
-                    xdu[ind[i][0]] -= hh * \
-                        (self.ub[ind[i][0]] - self.lb[ind[i][0]])
-                    xdu[ind[i][1]] += hh * \
-                        (self.ub[ind[i][1]] - self.lb[ind[i][1]])
-                    limit_test = [xuu[ind[i][0]] > self.ub[ind[i][0]], xuu[ind[i][1]] > self.ub[ind[i][1]], xdd[ind[i][0]] < self.lb[ind[i][0]], xdd[ind[i][1]] < self.lb[ind[i][1]],
-                                  xud[ind[i][0]] > self.ub[ind[i][0]], xud[ind[i][1]] < self.lb[ind[i][1]], xdu[ind[i][0]] < self.lb[ind[i][0]], xdu[ind[i][1]] > self.ub[ind[i][1]]]
-                    if any(limit_test):
-                        tmp = zeros(self.f_dim)
-                    else:
-                        # rescale
-                        tmp = (array(self.prob.objfun(xuu)) - array(self.prob.objfun(xud)) - array(
-                            self.prob.objfun(xdu)) + array(self.prob.objfun(xdd))) / (4 * hh * hh * array(self.f_span))
-
-                for j in range(self.f_dim):
-                    d[t % 2][0][j][i] = tmp[j]
-
-            for k in range(1, t + 1):
-                d[t % 2][k] = d[t % 2][k - 1] + \
-                    (d[t % 2][k - 1] - d[(t + 1) % 2][k - 1]) / (4 ** k - 1)
-
-            if t > 0:
-                err = amax(abs(d[t % 2][t] - d[(t + 1) % 2][t - 1]))
-
-            d[(t + 1) %
-              2].extend([zeros([self.f_dim, n_ind]), zeros([self.f_dim, n_ind])])
-            t += 1
-
-        hessian = []
-        for i in range(self.f_dim):
-            mat = zeros([self.cont_dim, self.cont_dim])
-            for j in range(n_ind):
-                mat[ind[j][0]][ind[j][1]] = d[(t + 1) % 2][t - 1][i][j]
-                mat[ind[j][1]][ind[j][0]] = d[(t + 1) % 2][t - 1][i][j]
-            hessian.append(mat.tolist())
-
-        return hessian
+        from PyGMO.util._util import _landscape_hessian
+        return _landscape_hessian(self.prob, [x], self.f_span, h, hess_tol, tmax, 1)[0]
 
     def _grad_properties(self, tol=10 ** (-8), mode='f'):
         """
@@ -2109,37 +1989,17 @@ class analysis:
         if n_pairs == 0:
             n_pairs = self.npoints
         try:
-            from numpy.random import random, randint
-            from numpy import array, multiply, zeros, divide
+            from numpy import zeros
         except ImportError:
             raise ImportError(
                 "analysis._c_lin needs numpy to run. Is it installed?")
+        from PyGMO.util._util import _landscape_linearity_deltas, _landscape_value_type
 
         p_lin = zeros(self.c_dim)
-        for i in range(n_pairs):
-            i1 = randint(self.npoints)
-            i2 = randint(self.npoints)
-            while (i2 == i1):
-                i2 = randint(self.npoints)
-            r = random()
-            x = r * array(self.points[i1]) + (1 - r) * array(self.points[i2])
-
-            if self.cont_dim != self.dim:
-                x[self.cont_dim:] = self.points[i1][self.cont_dim:]
-                x = multiply(
-                    array(x), array(self.ub) - array(self.lb)) + array(self.lb)
-                x2 = multiply(array(self.points[i2][:self.cont_dim] + self.points[i1][
-                              self.cont_dim:]), array(self.ub) - array(self.lb)) + array(self.lb)
-                c2 = divide(self.prob.compute_constraints(x2), self.c_span)
-                c_lin = r * array(self.c[i1]) + (1 - r) * array(c2)
-            else:
-                x = multiply(
-                    array(x), array(self.ub) - array(self.lb)) + array(self.lb)
-                c_lin = r * array(self.c[i1]) + (1 - r) * array(self.c[i2])
-
-            c_real = divide(self.prob.compute_constraints(x), self.c_span)
-            delta = c_lin - c_real
-
+        i1, i2, r = self._random_pairs(n_pairs)
+        deltas = _landscape_linearity_deltas(self.prob, self.points, self.c, [0.] * self.c_dim, self.c_span,
+                                             i1, i2, r, _landscape_value_type.CONSTRAINTS, self.n_threads)
+        for delta in deltas:
             for j in range(self.c_dim):
                 if abs(delta[j]) < threshold:
                     p_lin[j] += 1
@@ -2179,9 +2039,9 @@ class analysis:
         self.c = []
         self.c_span = []
         if self.c_dim != 0:
-            for i in range(self.npoints):
-                self.c.append(
-                    list(self.prob.compute_constraints(self.points[i])))
+            from PyGMO.util._util import _landscape_evaluate, _landscape_value_type
+            self.c = _landscape_evaluate(
+                self.prob, self.points, _landscape_value_type.CONSTRAINTS, self.n_threads)
 
             temp0 = ptp(self.c, 0).tolist()
             temp1 = amax(self.c, 0).tolist()
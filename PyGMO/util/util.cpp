@@ -23,8 +23,12 @@
  *****************************************************************************/
 
 #include <Python.h>
+#include <string>
+#include <vector>
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/python/class.hpp>
+#include <boost/python/def.hpp>
+#include <boost/python/list.hpp>
 #include <boost/python/module.hpp>
 #include <boost/python/scope.hpp>
 #include <boost/python/register_ptr_to_python.hpp>
@@ -35,6 +39,7 @@
 
 #include "../../src/util/hypervolume.h"
 #include "../../src/util/discrepancy.h"
+#include "../../src/util/landscape.h"
 #include "../../src/util/race_pop.h"
 #include "../../src/util/race_algo.h"
 #include "../utils.h"
@@ -122,35 +127,107 @@ void expose_hv_algorithm()
 	class_<util::hv_algorithm::bf_fpras, bases<util::hv_algorithm::base> >("bf_fpras","Hypervolume approximation based on FPRAS", init<const double, const double>());
 }
 
-void expose_hypervolume()
+// Hypervolume wrappers releasing the GIL during the computation. The hypervolume object and the hypervolume algorithm
+// may be used by other Python threads meanwhile (the algorithms keep work buffers and random number generators in
+// mutable members, and the points are reordered in place when they are not copied), so the computation runs on copies
+// made with the GIL held. The copied points need not be copied again by the algorithm.
+static inline util::hypervolume hv_copy(const util::hypervolume &hv)
 {
-	typedef double (util::hypervolume::*compute_custom)(const fitness_vector &, const util::hv_algorithm::base_ptr) const;
-	typedef double (util::hypervolume::*compute_dynamic)(const fitness_vector &) const;
+	util::hypervolume retval(hv);
+	retval.set_copy_points(false);
+	return retval;
+}
 
-	typedef double (util::hypervolume::*exclusive_custom)(const unsigned int, const fitness_vector &, const util::hv_algorithm::base_ptr) const;
-	typedef double (util::hypervolume::*exclusive_dynamic)(const unsigned int, const fitness_vector &) const;
+static inline double hv_compute_custom(const util::hypervolume &hv, const fitness_vector &r, const util::hv_algorithm::base_ptr algo)
+{
+	const util::hypervolume hv_c(hv_copy(hv));
+	const util::hv_algorithm::base_ptr algo_c = algo->clone();
+	scoped_gil_release release;
+	return hv_c.compute(r,algo_c);
+}
 
-	typedef unsigned int (util::hypervolume::*least_contributor_custom)(const fitness_vector &, const util::hv_algorithm::base_ptr) const;
-	typedef unsigned int (util::hypervolume::*least_contributor_dynamic)(const fitness_vector &) const;
+static inline double hv_compute_dynamic(const util::hypervolume &hv, const fitness_vector &r)
+{
+	const util::hypervolume hv_c(hv_copy(hv));
+	scoped_gil_release release;
+	return hv_c.compute(r);
+}
 
-	typedef unsigned int (util::hypervolume::*greatest_contributor_custom)(const fitness_vector &, const util::hv_algorithm::base_ptr) const;
-	typedef unsigned int (util::hypervolume::*greatest_contributor_dynamic)(const fitness_vector &) const;
+static inline double hv_exclusive_custom(const util::hypervolume &hv, const unsigned int p_idx, const fitness_vector &r, const util::hv_algorithm::base_ptr algo)
+{
+	const util::hypervolume hv_c(hv_copy(hv));
+	const util::hv_algorithm::base_ptr algo_c = algo->clone();
+	scoped_gil_release release;
+	return hv_c.exclusive(p_idx,r,algo_c);
+}
 
-	typedef std::vector<double> (util::hypervolume::*contributions_custom)(const fitness_vector &, const util::hv_algorithm::base_ptr) const;
-	typedef std::vector<double> (util::hypervolume::*contributions_dynamic)(const fitness_vector &) const;
+static inline double hv_exclusive_dynamic(const util::hypervolume &hv, const unsigned int p_idx, const fitness_vector &r)
+{
+	const util::hypervolume hv_c(hv_copy(hv));
+	scoped_gil_release release;
+	return hv_c.exclusive(p_idx,r);
+}
+
+static inline unsigned int hv_least_contributor_custom(const util::hypervolume &hv, const fitness_vector &r, const util::hv_algorithm::base_ptr algo)
+{
+	const util::hypervolume hv_c(hv_copy(hv));
+	const util::hv_algorithm::base_ptr algo_c = algo->clone();
+	scoped_gil_release release;
+	return hv_c.least_contributor(r,algo_c);
+}
+
+static inline unsigned int hv_least_contributor_dynamic(const util::hypervolume &hv, const fitness_vector &r)
+{
+	const util::hypervolume hv_c(hv_copy(hv));
+	scoped_gil_release release;
+	return hv_c.least_contributor(r);
+}
+
+static inline unsigned int hv_greatest_contributor_custom(const util::hypervolume &hv, const fitness_vector &r, const util::hv_algorithm::base_ptr algo)
+{
+	const util::hypervolume hv_c(hv_copy(hv));
+	const util::hv_algorithm::base_ptr algo_c = algo->clone();
+	scoped_gil_release release;
+	return hv_c.greatest_contributor(r,algo_c);
+}
+
+static inline unsigned int hv_greatest_contributor_dynamic(const util::hypervolume &hv, const fitness_vector &r)
+{
+	const util::hypervolume hv_c(hv_copy(hv));
+	scoped_gil_release release;
+	return hv_c.greatest_contributor(r);
+}
+
+static inline std::vector<double> hv_contributions_custom(const util::hypervolume &hv, const fitness_vector &r, const util::hv_algorithm::base_ptr algo)
+{
+	const util::hypervolume hv_c(hv_copy(hv));
+	const util::hv_algorithm::base_ptr algo_c = algo->clone();
+	scoped_gil_release release;
+	return hv_c.contributions(r,algo_c);
+}
+
+static inline std::vector<double> hv_contributions_dynamic(const util::hypervolume &hv, const fitness_vector &r)
+{
+	const util::hypervolume hv_c(hv_copy(hv));
+	scoped_gil_release release;
+	return hv_c.contributions(r);
+}
+
+void expose_hypervolume()
+{
 
 	class_<util::hypervolume>("hypervolume","Hypervolume class.", init<const std::vector<std::vector<double> > &, const bool >())
 		.def(init<boost::shared_ptr<population>, const bool>())
-		.def("compute", compute_custom(&util::hypervolume::compute), "Computes the hypervolume using the provided hypervolume algorithm.")
-		.def("compute", compute_dynamic(&util::hypervolume::compute), "Computes the hypervolume.")
-		.def("exclusive", exclusive_custom(&util::hypervolume::exclusive), "Computes the exclusive hypervolume using the provided hypervolume algorithm.")
-		.def("exclusive", exclusive_dynamic(&util::hypervolume::exclusive), "Computes the exclusive hypervolume.")
-		.def("least_contributor", least_contributor_custom(&util::hypervolume::least_contributor), "Get the least contributor of the hypervolume using provided hypervolume algorithm.")
-		.def("least_contributor", least_contributor_dynamic(&util::hypervolume::least_contributor), "Get the least contributor of the hypervolume.")
-		.def("greatest_contributor", greatest_contributor_custom(&util::hypervolume::greatest_contributor), "Get the greatest contributor of the hypervolume using provided hypervolume algorithm.")
-		.def("greatest_contributor", greatest_contributor_dynamic(&util::hypervolume::greatest_contributor), "Get the greatest contributor of the hypervolume.")
-		.def("contributions", contributions_custom(&util::hypervolume::contributions), "Get the contributions to the hypervolume by each point using provided hypervolume algorithm..")
-		.def("contributions", contributions_dynamic(&util::hypervolume::contributions), "Get the contributions to the hypervolume by each point.")
+		.def("compute", &hv_compute_custom, "Computes the hypervolume using the provided hypervolume algorithm.")
+		.def("compute", &hv_compute_dynamic, "Computes the hypervolume.")
+		.def("exclusive", &hv_exclusive_custom, "Computes the exclusive hypervolume using the provided hypervolume algorithm.")
+		.def("exclusive", &hv_exclusive_dynamic, "Computes the exclusive hypervolume.")
+		.def("least_contributor", &hv_least_contributor_custom, "Get the least contributor of the hypervolume using provided hypervolume algorithm.")
+		.def("least_contributor", &hv_least_contributor_dynamic, "Get the least contributor of the hypervolume.")
+		.def("greatest_contributor", &hv_greatest_contributor_custom, "Get the greatest contributor of the hypervolume using provided hypervolume algorithm.")
+		.def("greatest_contributor", &hv_greatest_contributor_dynamic, "Get the greatest contributor of the hypervolume.")
+		.def("contributions", &hv_contributions_custom, "Get the contributions to the hypervolume by each point using provided hypervolume algorithm..")
+		.def("contributions", &hv_contributions_dynamic, "Get the contributions to the hypervolume by each point.")
 		.def("get_nadir_point", &util::hypervolume::get_nadir_point)
 		.def("set_copy_points", &util::hypervolume::set_copy_points)
 		.def("get_copy_points", &util::hypervolume::get_copy_points)
@@ -159,6 +236,102 @@ void expose_hypervolume()
 		.def("get_verify", &util::hypervolume::get_verify);
 }
 
+// Nested Python lists from nested vectors, as built by the pure Python analysis.
+static inline object landscape_to_list(const double &x)
+{
+	return object(x);
+}
+
+template <class T>
+static inline list landscape_to_list(const std::vector<T> &v)
+{
+	list retval;
+	for (typename std::vector<T>::size_type i = 0; i < v.size(); ++i) {
+		retval.append(landscape_to_list(v[i]));
+	}
+	return retval;
+}
+
+// Landscape analysis kernels, the GIL being released while they run.
+static inline list landscape_sample(const problem::base &prob, const std::string &method, unsigned int npoints, unsigned int first)
+{
+	const unsigned int dim = boost::numeric_cast<unsigned int>(prob.get_dimension());
+	discrepancy::base_ptr sampler;
+	if (method == "sobol") {
+		sampler.reset(new discrepancy::sobol(dim,first));
+	} else if (method == "lhs") {
+		sampler.reset(new discrepancy::lhs(dim,npoints));
+	} else if (method == "faure") {
+		sampler.reset(new discrepancy::faure(dim,first));
+	} else if (method == "halton") {
+		sampler.reset(new discrepancy::halton(dim,first));
+	} else {
+		pagmo_throw(value_error,"invalid sampling method");
+	}
+	std::vector<decision_vector> retval;
+	{
+		scoped_gil_release release;
+		retval = landscape::sample(prob,*sampler,npoints);
+	}
+	return landscape_to_list(retval);
+}
+
+static inline list landscape_evaluate(const problem::base &prob, const std::vector<decision_vector> &x, landscape::value_type type, unsigned int n_threads)
+{
+	std::vector<std::vector<double> > retval;
+	{
+		scoped_gil_release release;
+		retval = landscape::evaluate(prob,x,type,n_threads);
+	}
+	return landscape_to_list(retval);
+}
+
+static inline list landscape_gradient(const problem::base &prob, const std::vector<decision_vector> &points, const std::vector<double> &span,
+	double h, double tol, unsigned int tmax, landscape::value_type type, unsigned int n_threads)
+{
+	std::vector<std::vector<std::vector<double> > > retval;
+	{
+		scoped_gil_release release;
+		retval = landscape::gradient(prob,points,span,h,tol,tmax,type,n_threads);
+	}
+	return landscape_to_list(retval);
+}
+
+static inline list landscape_hessian(const problem::base &prob, const std::vector<decision_vector> &points, const std::vector<double> &span,
+	double h, double tol, unsigned int tmax, unsigned int n_threads)
+{
+	std::vector<std::vector<std::vector<std::vector<double> > > > retval;
+	{
+		scoped_gil_release release;
+		retval = landscape::hessian(prob,points,span,h,tol,tmax,n_threads);
+	}
+	return landscape_to_list(retval);
+}
+
+static inline list landscape_linearity_deltas(const problem::base &prob, const std::vector<decision_vector> &points,
+	const std::vector<std::vector<double> > &values, const std::vector<double> &offset, const std::vector<double> &span,
+	const std::vector<int> &i1, const std::vector<int> &i2, const std::vector<double> &r, landscape::value_type type, unsigned int n_threads)
+{
+	std::vector<std::vector<double> > retval;
+	{
+		scoped_gil_release release;
+		retval = landscape::linearity_deltas(prob,points,values,offset,span,i1,i2,r,type,n_threads);
+	}
+	return landscape_to_list(retval);
+}
+
+void expose_landscape()
+{
+	enum_<landscape::value_type>("_landscape_value_type")
+		.value("FITNESS", landscape::FITNESS)
+		.value("CONSTRAINTS", landscape::CONSTRAINTS);
+	def("_landscape_sample", &landscape_sample, "Sample the search space of a problem with a low-discrepancy sequence.");
+	def("_landscape_evaluate", &landscape_evaluate, "Evaluate the fitness or the constraints of a set of points.");
+	def("_landscape_gradient", &landscape_gradient, "Jacobian matrices at scaled points by Richardson extrapolation.");
+	def("_landscape_hessian", &landscape_hessian, "Hessian tensors at scaled points by Richardson extrapolation.");
+	def("_landscape_linearity_deltas", &landscape_linearity_deltas, "Deviations from linearity along segments of the sample.");
+}
+
 // Main method containing all the juice of race_pop
 static inline boost::python::tuple race_pop_run_return_tuple(
 	racing::race_pop& race_obj,
@@ -259,6 +432,9 @@ BOOST_PYTHON_MODULE(_util) {
 	.def(init<const std::vector<pagmo::algorithm::base_ptr> &, const std::vector<pagmo::problem::base_ptr> &, unsigned int, unsigned int>())
 	.def("run", &race_algo_run_return_tuple, "Race the algorithms");
 	
+	// Landscape analysis
+	expose_landscape();
+
 	// Hypervolumes
 	expose_hypervolume();
 	scope current;
@@ -35,10 +35,17 @@
 #include <boost/python/dict.hpp>
 #include <boost/python/docstring_options.hpp>
 #include <boost/python/extract.hpp>
+#include <boost/python/object/class_wrapper.hpp>
+#include <boost/python/object/make_ptr_instance.hpp>
+#include <boost/python/object/pointer_holder.hpp>
+#include <boost/python/to_python_converter.hpp>
 #include <boost/python/tuple.hpp>
+#include <boost/shared_ptr.hpp>
 #include <csignal>
+#include <cstring>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "exceptions.h"
 
@@ -151,6 +158,135 @@ inline std::string py_cpp_dumps(const T &x)
 	return ss.str();
 }
 
+// RAII GIL releaser, used around C++ computations which do not touch Python objects. See:
+// http://wiki.python.org/moin/boost.python/HowTo#MultithreadingSupportformyfunction
+class scoped_gil_release
+{
+	public:
+		scoped_gil_release()
+		{
+			m_thread_state = PyEval_SaveThread();
+		}
+		~scoped_gil_release()
+		{
+			PyEval_RestoreThread(m_thread_state);
+			m_thread_state = NULL;
+		}
+	private:
+		scoped_gil_release(const scoped_gil_release &);
+		scoped_gil_release &operator=(const scoped_gil_release &);
+		PyThreadState *m_thread_state;
+};
+
+// RAII GIL acquirer, used by the C++ classes reimplemented in Python before calling back into Python.
+// It can be nested and it works both when the GIL is held and when it was released by scoped_gil_release.
+class gil_state_lock
+{
+	public:
+		gil_state_lock():m_gstate(PyGILState_Ensure()) {}
+		~gil_state_lock()
+		{
+			PyGILState_Release(m_gstate);
+		}
+	private:
+		gil_state_lock(const gil_state_lock &);
+		gil_state_lock &operator=(const gil_state_lock &);
+		PyGILState_STATE m_gstate;
+};
+
+// Deleter for shared pointers to the C++ part of a Python object, keeping the Python object alive.
+// Unlike the shared pointers built by the Boost.Python converters, the reference to the Python object
+// is dropped with the GIL held, so that the pointer can be destroyed in code that released the GIL.
+template <class T>
+class py_object_deleter
+{
+	public:
+		explicit py_object_deleter(PyObject *obj):m_obj(obj)
+		{
+			Py_INCREF(m_obj);
+		}
+		void operator()(T *)
+		{
+			gil_state_lock lock;
+			Py_DECREF(m_obj);
+		}
+		PyObject *get() const
+		{
+			return m_obj;
+		}
+	private:
+		PyObject *m_obj;
+};
+
+// To-Python converter for shared pointers to classes which can be reimplemented in Python, to be registered
+// in place of register_ptr_to_python(). Pointers built with py_object_deleter are converted back to the Python
+// object they belong to, like Boost.Python does for the pointers built by its own converters.
+template <class T>
+struct py_object_ptr_to_python
+{
+	static PyObject *convert(const boost::shared_ptr<T> &p)
+	{
+		if (const py_object_deleter<T> *d = boost::get_deleter<py_object_deleter<T> >(p)) {
+			return boost::python::incref(d->get());
+		}
+		return boost::python::objects::class_value_wrapper<boost::shared_ptr<T>,
+			boost::python::objects::make_ptr_instance<T,boost::python::objects::pointer_holder<boost::shared_ptr<T>,T> > >::convert(p);
+	}
+};
+
+// RAII holder of a Python buffer view.
+class py_buffer_view
+{
+	public:
+		py_buffer_view(const boost::python::object &obj, int flags)
+		{
+			if (PyObject_GetBuffer(obj.ptr(),&m_view,flags | PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) {
+				boost::python::throw_error_already_set();
+			}
+		}
+		~py_buffer_view()
+		{
+			PyBuffer_Release(&m_view);
+		}
+		// Check that the buffer holds exactly size doubles.
+		void check(std::vector<double>::size_type size) const
+		{
+			if (m_view.itemsize != sizeof(double) || !m_view.format || std::strcmp(m_view.format,"d") != 0 ||
+				m_view.len != static_cast<Py_ssize_t>(size * sizeof(double)))
+			{
+				PyErr_SetString(PyExc_ValueError,"the buffer does not contain the expected number of doubles");
+				boost::python::throw_error_already_set();
+			}
+		}
+		void *data() const
+		{
+			return m_view.buf;
+		}
+	private:
+		py_buffer_view(const py_buffer_view &);
+		py_buffer_view &operator=(const py_buffer_view &);
+		Py_buffer m_view;
+};
+
+// Copy a vector of doubles into a writable C-contiguous buffer of the same size (e.g., a NumPy array of float64).
+inline void vector_to_py_buffer(const boost::python::object &obj, const std::vector<double> &v)
+{
+	py_buffer_view view(obj,PyBUF_WRITABLE);
+	view.check(v.size());
+	if (v.size()) {
+		std::memcpy(view.data(),&v[0],v.size() * sizeof(double));
+	}
+}
+
+// Copy a C-contiguous buffer of doubles of the same size as v into v.
+inline void py_buffer_to_vector(std::vector<double> &v, const boost::python::object &obj)
+{
+	py_buffer_view view(obj,PyBUF_SIMPLE);
+	view.check(v.size());
+	if (v.size()) {
+		std::memcpy(&v[0],view.data(),v.size() * sizeof(double));
+	}
+}
 
 #define common_module_init() \
 /* Initialise Python thread support. */ \
@@ -0,0 +1,72 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_BENCHMARKS_ALGORITHM_REGISTRY_H
+#define PAGMO_BENCHMARKS_ALGORITHM_REGISTRY_H
+
+#include <string>
+
+#include "../src/pagmo.h"
+
+// Algorithms selectable by name in the benchmark drivers.
+static const char *algorithm_names[] = {"de", "jde", "mde_pbx", "pso", "pso_generational", "sga", "sga_gray", "bee_colony",
+	"cmaes", "ihs", "sea", "monte_carlo", "nsga2", "null"};
+
+// Algorithms performing gen generations per evolution. The tolerance stopping criteria are disabled, so that the
+// work done does not depend on the progress of the optimisation.
+static pagmo::algorithm::base_ptr make_algorithm(const std::string &name, int gen)
+{
+	if (name == "de") {
+		return pagmo::algorithm::de(gen,0.8,0.9,2,0,0).clone();
+	} else if (name == "jde") {
+		return pagmo::algorithm::jde(gen,2,1,0,0).clone();
+	} else if (name == "mde_pbx") {
+		return pagmo::algorithm::mde_pbx(gen,0.15,1.5,0,0).clone();
+	} else if (name == "pso") {
+		return pagmo::algorithm::pso(gen).clone();
+	} else if (name == "pso_generational") {
+		return pagmo::algorithm::pso_generational(gen).clone();
+	} else if (name == "sga") {
+		return pagmo::algorithm::sga(gen).clone();
+	} else if (name == "sga_gray") {
+		return pagmo::algorithm::sga_gray(gen).clone();
+	} else if (name == "bee_colony") {
+		return pagmo::algorithm::bee_colony(gen).clone();
+	} else if (name == "cmaes") {
+		return pagmo::algorithm::cmaes(gen,-1,-1,-1,-1,0.5,0,0).clone();
+	} else if (name == "ihs") {
+		return pagmo::algorithm::ihs(gen).clone();
+	} else if (name == "sea") {
+		return pagmo::algorithm::sea(gen).clone();
+	} else if (name == "monte_carlo") {
+		return pagmo::algorithm::monte_carlo(gen).clone();
+	} else if (name == "nsga2") {
+		return pagmo::algorithm::nsga2(gen).clone();
+	} else if (name == "null") {
+		return pagmo::algorithm::null().clone();
+	}
+	pagmo_throw(value_error,"unknown algorithm: " + name);
+}
+
+#endif
@@ -0,0 +1,54 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Replacement of the global allocation functions counting the allocations. Kept in its own translation unit
+// so that the replaced functions are never inlined in the code being measured.
+
+#include <boost/atomic.hpp>
+#include <cstdlib>
+#include <new>
+
+#include "alloc_counter.h"
+
+static boost::atomic<unsigned long long> n_allocs(0);
+
+unsigned long long allocation_count()
+{
+	return n_allocs.load();
+}
+
+void *operator new(std::size_t size)
+{
+	++n_allocs;
+	void *retval = std::malloc(size ? size : 1);
+	if (!retval) {
+		throw std::bad_alloc();
+	}
+	return retval;
+}
+
+void operator delete(void *p) throw()
+{
+	std::free(p);
+}
@@ -0,0 +1,438 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Strong and weak scaling of archipelago::evolve(). For every number of islands an archipelago is built from the
+// selected algorithm, problem and topology and evolved --evolutions times, with a migration step after each evolution.
+// - strong scaling: the total population (--population) is split among the islands, so that the total work is fixed;
+// - weak scaling: each island holds --population individuals, so that the work per island is fixed.
+// Every island evolves in its own thread (or on an MPI process with --mpi), so the number of islands is also the number
+// of concurrent evolutions. For each run the wall time, the evaluations per second, and per island the time spent in the
+// algorithm, in migration (everything else done by the island thread: immigration, emigration and waiting for the
+// archipelago locks) and idle (waiting for the other islands) are written in JSON to the standard output or to --output.
+// Of --repetitions runs, the one with the median wall time is reported.
+//
+// Usage: archipelago_scaling [--algorithm <name>] [--problem <name>] [--dimension <n>] [--topology <name>]
+//        [--islands <n1,n2,...>] [--population <n>] [--generations <n>] [--evolutions <n>] [--migration-probability <p>]
+//        [--mode strong|weak|both] [--repetitions <n>] [--output <file>] [--mpi] [--list]
+
+#include <algorithm>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/pagmo.h"
+#include "algorithm_registry.h"
+
+using namespace pagmo;
+
+static const char *problem_names[] = {"rosenbrock", "ackley", "rastrigin", "griewank", "schwefel", "dejong", "lennard_jones",
+	"zdt1", "dtlz2"};
+static const char *topology_names[] = {"unconnected", "ring", "one_way_ring", "fully_connected", "barabasi_albert",
+	"clustered_ba", "ageing_clustered_ba", "erdos_renyi", "hypercube", "pan", "rim", "watts_strogatz"};
+
+static problem::base_ptr make_problem(const std::string &name, int dim)
+{
+	if (name == "rosenbrock") {
+		return problem::rosenbrock(dim).clone();
+	} else if (name == "ackley") {
+		return problem::ackley(dim).clone();
+	} else if (name == "rastrigin") {
+		return problem::rastrigin(dim).clone();
+	} else if (name == "griewank") {
+		return problem::griewank(dim).clone();
+	} else if (name == "schwefel") {
+		return problem::schwefel(dim).clone();
+	} else if (name == "dejong") {
+		return problem::dejong(dim).clone();
+	} else if (name == "lennard_jones") {
+		return problem::lennard_jones(dim).clone();
+	} else if (name == "zdt1") {
+		return problem::zdt(1,dim).clone();
+	} else if (name == "dtlz2") {
+		return problem::dtlz(2,dim,3).clone();
+	}
+	pagmo_throw(value_error,"unknown problem: " + name);
+}
+
+static topology::base_ptr make_topology(const std::string &name)
+{
+	if (name == "unconnected") {
+		return topology::unconnected().clone();
+	} else if (name == "ring") {
+		return topology::ring().clone();
+	} else if (name == "one_way_ring") {
+		return topology::one_way_ring().clone();
+	} else if (name == "fully_connected") {
+		return topology::fully_connected().clone();
+	} else if (name == "barabasi_albert") {
+		return topology::barabasi_albert().clone();
+	} else if (name == "clustered_ba") {
+		return topology::clustered_ba().clone();
+	} else if (name == "ageing_clustered_ba") {
+		return topology::ageing_clustered_ba().clone();
+	} else if (name == "erdos_renyi") {
+		return topology::erdos_renyi().clone();
+	} else if (name == "hypercube") {
+		return topology::hypercube().clone();
+	} else if (name == "pan") {
+		return topology::pan().clone();
+	} else if (name == "rim") {
+		return topology::rim().clone();
+	} else if (name == "watts_strogatz") {
+		return topology::watts_strogatz().clone();
+	}
+	pagmo_throw(value_error,"unknown topology: " + name);
+}
+
+static double elapsed(const boost::posix_time::ptime &start, const boost::posix_time::ptime &stop)
+{
+	return (stop - start).total_microseconds() * 1E-6;
+}
+
+static boost::posix_time::ptime now()
+{
+	return boost::posix_time::microsec_clock::universal_time();
+}
+
+// Timings of an island, shared by the island and its clones living in the archipelago.
+struct island_stats
+{
+	island_stats():compute(0),active(0),fevals(0) {}
+	// Time spent in the algorithm.
+	double				compute;
+	// Lifetime of the evolution threads, from the synchronised start to the end of the last migration.
+	double				active;
+	unsigned long long		fevals;
+	boost::posix_time::ptime	entry;
+};
+
+typedef boost::shared_ptr<island_stats> island_stats_ptr;
+
+// Island recording its timings into an island_stats. Island is pagmo::island or pagmo::mpi_island.
+template <class Island>
+class timed_island: public Island
+{
+	public:
+		timed_island(const algorithm::base &algo, const problem::base &prob, int n, const double &migr_prob,
+			const island_stats_ptr &stats):Island(algo,prob,n,migr_prob),m_stats(stats) {}
+		base_island_ptr clone() const
+		{
+			return base_island_ptr(new timed_island(*this));
+		}
+	protected:
+		void perform_evolution(const algorithm::base &algo, population &pop) const
+		{
+			const boost::posix_time::ptime start = now();
+			const unsigned int fevals = pop.problem().get_fevals();
+			Island::perform_evolution(algo,pop);
+			m_stats->compute += elapsed(start,now());
+			m_stats->fevals += pop.problem().get_fevals() - fevals;
+		}
+		void thread_entry()
+		{
+			Island::thread_entry();
+			m_stats->entry = now();
+		}
+		void thread_exit()
+		{
+			m_stats->active += elapsed(m_stats->entry,now());
+			Island::thread_exit();
+		}
+	private:
+		island_stats_ptr	m_stats;
+};
+
+struct settings
+{
+	settings():algorithm("de"),problem("rosenbrock"),topology("ring"),dimension(30),population(160),generations(100),
+		evolutions(10),migr_prob(1),strong(true),weak(true),repetitions(3),mpi(false)
+	{
+		islands.push_back(1);
+		islands.push_back(2);
+		islands.push_back(4);
+		islands.push_back(8);
+	}
+	std::string		algorithm;
+	std::string		problem;
+	std::string		topology;
+	int			dimension;
+	std::vector<int>	islands;
+	int			population;
+	int			generations;
+	int			evolutions;
+	double			migr_prob;
+	bool			strong;
+	bool			weak;
+	unsigned int		repetitions;
+	bool			mpi;
+};
+
+struct run_result
+{
+	std::string			mode;
+	int				islands;
+	int				pop_size;
+	double				wall;
+	unsigned long long		fevals;
+	std::vector<island_stats>	stats;
+};
+
+static run_result run(const settings &s, const std::string &mode, int n_islands, int pop_size)
+{
+	const algorithm::base_ptr algo = make_algorithm(s.algorithm,s.generations);
+	const problem::base_ptr prob = make_problem(s.problem,s.dimension);
+	archipelago archi(*make_topology(s.topology));
+	std::vector<island_stats_ptr> stats;
+	for (int i = 0; i < n_islands; ++i) {
+		stats.push_back(island_stats_ptr(new island_stats()));
+#ifdef PAGMO_ENABLE_MPI
+		if (s.mpi) {
+			archi.push_back(timed_island<mpi_island>(*algo,*prob,pop_size,s.migr_prob,stats.back()));
+			continue;
+		}
+#endif
+		archi.push_back(timed_island<island>(*algo,*prob,pop_size,s.migr_prob,stats.back()));
+	}
+	const boost::posix_time::ptime start = now();
+	archi.evolve(s.evolutions);
+	archi.join();
+	run_result retval;
+	retval.wall = elapsed(start,now());
+	retval.mode = mode;
+	retval.islands = n_islands;
+	retval.pop_size = pop_size;
+	retval.fevals = 0;
+	for (int i = 0; i < n_islands; ++i) {
+		retval.stats.push_back(*stats[i]);
+		retval.fevals += stats[i]->fevals;
+	}
+	return retval;
+}
+
+static bool wall_less(const run_result &a, const run_result &b)
+{
+	return a.wall < b.wall;
+}
+
+static run_result median_run(const settings &s, const std::string &mode, int n_islands, int pop_size)
+{
+	std::vector<run_result> runs;
+	for (unsigned int r = 0; r < s.repetitions; ++r) {
+		runs.push_back(run(s,mode,n_islands,pop_size));
+	}
+	std::sort(runs.begin(),runs.end(),wall_less);
+	return runs[runs.size() / 2];
+}
+
+template <class T>
+static void write_array(std::ostream &os, const std::vector<T> &v)
+{
+	os << '[';
+	for (std::size_t i = 0; i < v.size(); ++i) {
+		os << (i ? ", " : "") << v[i];
+	}
+	os << ']';
+}
+
+// The speedup and the efficiency are relative to the first run of the same mode.
+static void write_json(std::ostream &os, const settings &s, const std::vector<run_result> &results)
+{
+	os.precision(6);
+	os << "{\n  \"algorithm\": \"" << s.algorithm << "\",\n  \"problem\": \"" << s.problem << "\",\n  \"dimension\": " << s.dimension
+		<< ",\n  \"topology\": \"" << s.topology << "\",\n  \"island_type\": \"" << (s.mpi ? "mpi_island" : "island")
+		<< "\",\n  \"generations\": " << s.generations << ",\n  \"evolutions\": " << s.evolutions
+		<< ",\n  \"migration_probability\": " << s.migr_prob << ",\n  \"repetitions\": " << s.repetitions << ",\n  \"runs\": [";
+	for (std::size_t i = 0; i < results.size(); ++i) {
+		const run_result &r = results[i];
+		std::size_t ref = i;
+		while (ref > 0 && results[ref - 1].mode == r.mode) {
+			--ref;
+		}
+		const double speedup = results[ref].wall / r.wall;
+		const double efficiency = (r.mode == "strong") ? speedup * results[ref].islands / r.islands : speedup;
+		std::vector<double> compute, migration, idle;
+		double total_active = 0, total_migration = 0;
+		for (std::size_t j = 0; j < r.stats.size(); ++j) {
+			compute.push_back(r.stats[j].compute);
+			migration.push_back(std::max(r.stats[j].active - r.stats[j].compute,0.));
+			idle.push_back(std::max(r.wall - r.stats[j].active,0.));
+			total_active += r.stats[j].active;
+			total_migration += migration.back();
+		}
+		os << (i ? ",\n" : "\n") << "    {\"mode\": \"" << r.mode << "\", \"islands\": " << r.islands
+			<< ", \"population_per_island\": " << r.pop_size << ", \"wall_s\": " << r.wall << ", \"fevals\": " << r.fevals
+			<< ", \"evals_per_s\": " << r.fevals / r.wall << ", \"speedup\": " << speedup << ", \"efficiency\": " << efficiency
+			<< ", \"migration_fraction\": " << (total_active > 0 ? total_migration / total_active : 0.)
+			<< ",\n     \"compute_s\": ";
+		write_array(os,compute);
+		os << ",\n     \"migration_s\": ";
+		write_array(os,migration);
+		os << ",\n     \"idle_s\": ";
+		write_array(os,idle);
+		os << "}";
+	}
+	os << "\n  ]\n}\n";
+}
+
+static std::vector<int> parse_list(const std::string &str)
+{
+	std::vector<int> retval;
+	std::istringstream iss(str);
+	std::string item;
+	while (std::getline(iss,item,',')) {
+		const int n = boost::lexical_cast<int>(item);
+		if (n <= 0) {
+			pagmo_throw(value_error,"the number of islands must be positive");
+		}
+		retval.push_back(n);
+	}
+	if (retval.empty()) {
+		pagmo_throw(value_error,"empty list of island numbers");
+	}
+	return retval;
+}
+
+template <std::size_t N>
+static void print_names(const char *what, const char *(&names)[N])
+{
+	std::cout << what << ':';
+	for (std::size_t i = 0; i < N; ++i) {
+		std::cout << ' ' << names[i];
+	}
+	std::cout << '\n';
+}
+
+static void usage(const char *name)
+{
+	std::cerr << "Usage: " << name << " [--algorithm <name>] [--problem <name>] [--dimension <n>] [--topology <name>]\n"
+		"       [--islands <n1,n2,...>] [--population <n>] [--generations <n>] [--evolutions <n>] [--migration-probability <p>]\n"
+		"       [--mode strong|weak|both] [--repetitions <n>] [--output <file>] [--mpi] [--list]\n";
+}
+
+int main(int argc, char **argv)
+{
+	settings s;
+	std::string output;
+	try {
+		for (int i = 1; i < argc; ++i) {
+			const std::string arg(argv[i]);
+			if (arg == "--list") {
+				print_names("algorithms",algorithm_names);
+				print_names("problems",problem_names);
+				print_names("topologies",topology_names);
+				return 0;
+			} else if (arg == "--mpi") {
+				s.mpi = true;
+			} else if (i + 1 < argc && arg == "--algorithm") {
+				s.algorithm = argv[++i];
+			} else if (i + 1 < argc && arg == "--problem") {
+				s.problem = argv[++i];
+			} else if (i + 1 < argc && arg == "--topology") {
+				s.topology = argv[++i];
+			} else if (i + 1 < argc && arg == "--dimension") {
+				s.dimension = boost::lexical_cast<int>(argv[++i]);
+			} else if (i + 1 < argc && arg == "--islands") {
+				s.islands = parse_list(argv[++i]);
+			} else if (i + 1 < argc && arg == "--population") {
+				s.population = boost::lexical_cast<int>(argv[++i]);
+			} else if (i + 1 < argc && arg == "--generations") {
+				s.generations = boost::lexical_cast<int>(argv[++i]);
+			} else if (i + 1 < argc && arg == "--evolutions") {
+				s.evolutions = boost::lexical_cast<int>(argv[++i]);
+			} else if (i + 1 < argc && arg == "--migration-probability") {
+				s.migr_prob = boost::lexical_cast<double>(argv[++i]);
+			} else if (i + 1 < argc && arg == "--repetitions") {
+				s.repetitions = std::max(boost::lexical_cast<unsigned int>(argv[++i]),1u);
+			} else if (i + 1 < argc && arg == "--output") {
+				output = argv[++i];
+			} else if (i + 1 < argc && arg == "--mode") {
+				const std::string mode(argv[++i]);
+				if (mode != "strong" && mode != "weak" && mode != "both") {
+					usage(argv[0]);
+					return 1;
+				}
+				s.strong = (mode != "weak");
+				s.weak = (mode != "strong");
+			} else {
+				usage(argv[0]);
+				return 1;
+			}
+		}
+		// Validate the names before starting.
+		make_algorithm(s.algorithm,s.generations);
+		make_problem(s.problem,s.dimension);
+		make_topology(s.topology);
+	} catch (const std::exception &e) {
+		std::cerr << e.what() << '\n';
+		usage(argv[0]);
+		return 1;
+	}
+#ifdef PAGMO_ENABLE_MPI
+	// The slave processes never return from the constructor of the MPI environment.
+	boost::scoped_ptr<mpi_environment> env(s.mpi ? new mpi_environment() : 0);
+#else
+	if (s.mpi) {
+		std::cerr << "PaGMO was compiled without MPI support.\n";
+		return 1;
+	}
+#endif
+	std::vector<run_result> results;
+	for (int m = 0; m < 2; ++m) {
+		if ((m == 0 && !s.strong) || (m == 1 && !s.weak)) {
+			continue;
+		}
+		const std::string mode(m == 0 ? "strong" : "weak");
+		for (std::size_t i = 0; i < s.islands.size(); ++i) {
+			const int pop_size = (m == 0) ? s.population / s.islands[i] : s.population;
+			if (pop_size <= 0) {
+				std::cerr << "skipping " << mode << " scaling on " << s.islands[i] << " islands: empty islands\n";
+				continue;
+			}
+			try {
+				results.push_back(median_run(s,mode,s.islands[i],pop_size));
+			} catch (const std::exception &e) {
+				std::cerr << "skipping " << mode << " scaling on " << s.islands[i] << " islands: " << e.what() << '\n';
+				continue;
+			}
+			// Progress on the standard error, so that the JSON on the standard output stays clean.
+			const run_result &r = results.back();
+			std::cerr << mode << ", " << r.islands << " islands x " << r.pop_size << " individuals: " << r.wall << " s, "
+				<< r.fevals / r.wall << " evals/s\n";
+		}
+	}
+	if (output.empty()) {
+		write_json(std::cout,s,results);
+	} else {
+		std::ofstream ofs(output.c_str());
+		write_json(ofs,s,results);
+	}
+	return 0;
+}
@@ -0,0 +1,119 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Throughput comparison between the scalar (problem::base::objfun()) and the batched
+// (problem::base::objfun_batch()) evaluation of the analytic benchmark problems. Note that the kernels
+// calling libm (ackley, rastrigin, schwefel, ...) are vectorised only when the build allows a vector
+// math library, e.g. CMAKE_CXX_FLAGS="-O3 -ffast-math" with GCC and glibc.
+
+#include <algorithm>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+// Random decision vectors within the bounds of the problem.
+static std::vector<decision_vector> random_block(const problem::base &prob, std::size_t n)
+{
+	rng_double drng(42);
+	std::vector<decision_vector> retval(n,decision_vector(prob.get_dimension()));
+	for (std::size_t i = 0; i < n; ++i) {
+		for (problem::base::size_type j = 0; j < prob.get_dimension(); ++j) {
+			retval[i][j] = boost::uniform_real<double>(prob.get_lb()[j],prob.get_ub()[j])(drng);
+		}
+	}
+	return retval;
+}
+
+static double elapsed(const boost::posix_time::ptime &start)
+{
+	return (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() * 1E-6;
+}
+
+static void run(const problem::base &prob, std::size_t n, unsigned int repeats)
+{
+	const std::vector<decision_vector> x = random_block(prob,n);
+	std::vector<fitness_vector> f_scalar(n,fitness_vector(prob.get_f_dimension())), f_batch;
+
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+	for (unsigned int r = 0; r < repeats; ++r) {
+		for (std::size_t i = 0; i < n; ++i) {
+			prob.objfun(f_scalar[i],x[i]);
+		}
+	}
+	const double t_scalar = elapsed(start);
+
+	start = boost::posix_time::microsec_clock::universal_time();
+	for (unsigned int r = 0; r < repeats; ++r) {
+		prob.objfun_batch(f_batch,x);
+	}
+	const double t_batch = elapsed(start);
+
+	double max_err = 0;
+	for (std::size_t i = 0; i < n; ++i) {
+		for (fitness_vector::size_type k = 0; k < f_batch[i].size(); ++k) {
+			max_err = std::max(max_err,std::abs(f_batch[i][k] - f_scalar[i][k]));
+		}
+	}
+	const double evals = static_cast<double>(n) * repeats;
+	std::cout << std::setw(16) << std::left << prob.get_name() << std::right
+		<< std::setw(6) << prob.get_dimension()
+		<< std::setw(14) << std::scientific << std::setprecision(3) << evals / t_scalar
+		<< std::setw(14) << evals / t_batch
+		<< std::setw(10) << std::fixed << std::setprecision(2) << t_scalar / t_batch
+		<< std::setw(12) << std::scientific << std::setprecision(1) << max_err << '\n';
+}
+
+int main()
+{
+	const std::size_t n = 1000;
+	const unsigned int repeats = 20;
+	std::cout << std::setw(16) << std::left << "problem" << std::right << std::setw(6) << "dim"
+		<< std::setw(14) << "scalar ev/s" << std::setw(14) << "batch ev/s"
+		<< std::setw(10) << "speedup" << std::setw(12) << "max err" << '\n';
+	run(problem::ackley(50),n,repeats);
+	run(problem::rastrigin(50),n,repeats);
+	run(problem::rosenbrock(50),n,repeats);
+	run(problem::schwefel(50),n,repeats);
+	run(problem::griewank(50),n,repeats);
+	run(problem::michalewicz(50),n,repeats);
+	run(problem::levy5(50),n,repeats);
+	run(problem::dejong(50),n,repeats);
+	for (int id = 1; id <= 6; ++id) {
+		if (id != 5) {
+			run(problem::zdt(id,30),n,repeats);
+		}
+	}
+	for (int id = 1; id <= 7; ++id) {
+		run(problem::dtlz(id,10,3),n,repeats);
+	}
+	return 0;
+}
@@ -0,0 +1,647 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Time-to-target benchmarking of the algorithms over the problem library, in the style of COCO.
+//
+// Every (algorithm, problem, seed) triple of the matrix is an independent run, and the runs are spread over --threads
+// threads. A run evolves a population of --population individuals, --generations generations at a time, until
+// --budget x dimension function evaluations have been spent or, when the optimum is known, the finest target has been
+// reached. After each step the best value of the quality indicator found so far is recorded in the trace of the run as
+// (fevals, wall time, best). The quality indicator is:
+// - the best feasible objective for single-objective problems (infinity while no feasible point has been found);
+// - the average distance from the Pareto front (problem::base_unc_mo::p_distance) for zdt and dtlz;
+// - minus the hypervolume of the population with respect to the reference point (1.1, ..., 1.1) for the other
+//   multi-objective problems.
+// Constrained problems are optimised through problem::death_penalty, so that every algorithm can be used.
+//
+// A target is reached when best - reference <= precision. The reference is the known optimum when the problem provides
+// it (cec2006, cec2013, and 0 for the distance from the Pareto front), otherwise the best value found by any run on
+// the problem. Written in --output-dir:
+// - ert.csv: expected running time (fevals and seconds) and success rate of each algorithm on each problem and target.
+//   The expected running time is the total cost of all runs, where unsuccessful runs count their whole cost, divided
+//   by the number of successful runs;
+// - ecdf.csv: for each algorithm and problem, and over all problems, the empirical cumulative distribution of the
+//   runtimes, i.e. the fraction of (run, target) pairs reached within a budget of fevals / dimension;
+// - traces.csv, or traces.bin with --binary: the traces of the runs that did not fail. The binary file is made of
+//   the 8 characters "PAGMOERT", the version (uint32, currently 1) and the number of runs (uint32), followed for each
+//   run by the algorithm and problem names (uint32 length followed by the characters), the seed and the number of
+//   points (uint32), and the points (uint64 fevals, double wall time in seconds, double best value). Native byte order.
+//
+// Usage: ert_suite [--algorithms <a1,a2,...>] [--suites <s1,s2,...>] [--filter <substring>] [--seeds <n>]
+//        [--budget <fevals per dimension>] [--population <n>] [--generations <n>] [--targets <p1,p2,...>]
+//        [--dimension <n>] [--cec2013-data <dir>] [--threads <n>] [--output-dir <dir>] [--binary] [--list]
+
+#include <algorithm>
+#include <boost/cstdint.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/pagmo.h"
+#include "algorithm_registry.h"
+
+using namespace pagmo;
+
+static const char *suite_names[] = {"cec2006", "cec2009", "cec2013", "zdt", "dtlz"
+#ifdef PAGMO_ENABLE_KEP_TOOLBOX
+	, "mga"
+#endif
+};
+
+// Reference point of the hypervolume indicator.
+static const double hv_reference = 1.1;
+
+struct problem_entry
+{
+	std::string		name;
+	// Problem optimised by the algorithms.
+	problem::base_ptr	prob;
+	bool			known_optimum;
+	double			f_opt;
+};
+
+static void add_problem(std::vector<problem_entry> &suite, const std::string &name, const problem::base &prob)
+{
+	problem_entry entry;
+	entry.name = name;
+	entry.known_optimum = false;
+	entry.f_opt = 0;
+	if (dynamic_cast<const problem::base_unc_mo *>(&prob)) {
+		entry.known_optimum = true;
+	} else if (prob.get_f_dimension() == 1 && !prob.get_best_f().empty()) {
+		entry.known_optimum = true;
+		entry.f_opt = prob.get_best_f()[0][0];
+	}
+	entry.prob = prob.get_c_dimension() ? problem::death_penalty(prob).clone() : prob.clone();
+	suite.push_back(entry);
+}
+
+static std::string numbered(const std::string &name, unsigned int n)
+{
+	return name + boost::lexical_cast<std::string>(n);
+}
+
+static std::vector<problem_entry> build_suite(const std::vector<std::string> &suites, unsigned int dim, const std::string &cec2013_data)
+{
+	std::vector<problem_entry> retval;
+	for (std::vector<std::string>::size_type s = 0; s < suites.size(); ++s) {
+		const std::string &name = suites[s];
+		if (name == "cec2006") {
+			for (unsigned int i = 1; i <= 24; ++i) {
+				add_problem(retval,numbered("cec2006_",i),problem::cec2006(i));
+			}
+		} else if (name == "cec2009") {
+			for (unsigned int i = 1; i <= 10; ++i) {
+				add_problem(retval,numbered("cec2009_uf",i),problem::cec2009(i,30,false));
+			}
+			for (unsigned int i = 1; i <= 10; ++i) {
+				add_problem(retval,numbered("cec2009_cf",i),problem::cec2009(i,10,true));
+			}
+		} else if (name == "cec2013") {
+			try {
+				for (unsigned int i = 1; i <= 28; ++i) {
+					add_problem(retval,numbered("cec2013_",i),problem::cec2013(i,dim,cec2013_data));
+					// The optima are the biases added in cec2013::objfun_impl().
+					retval.back().known_optimum = true;
+					retval.back().f_opt = (i <= 14) ? -1400. + 100. * (i - 1) : 100. * (i - 14);
+				}
+			} catch (const std::exception &e) {
+				std::cerr << "skipping the cec2013 suite: " << e.what() << '\n';
+			}
+		} else if (name == "zdt") {
+			const unsigned int ids[] = {1, 2, 3, 4, 6};
+			for (unsigned int i = 0; i < 5; ++i) {
+				add_problem(retval,numbered("zdt",ids[i]),problem::zdt(ids[i],(ids[i] == 4 || ids[i] == 6) ? 10 : 30));
+			}
+		} else if (name == "dtlz") {
+			for (unsigned int i = 1; i <= 7; ++i) {
+				add_problem(retval,numbered("dtlz",i),problem::dtlz(i));
+			}
+#ifdef PAGMO_ENABLE_KEP_TOOLBOX
+		} else if (name == "mga") {
+			add_problem(retval,"cassini_1",problem::cassini_1());
+			add_problem(retval,"cassini_2",problem::cassini_2());
+			add_problem(retval,"gtoc_1",problem::gtoc_1());
+			add_problem(retval,"messenger_full",problem::messenger_full());
+			add_problem(retval,"rosetta",problem::rosetta());
+			add_problem(retval,"sagas",problem::sagas());
+			add_problem(retval,"tandem",problem::tandem());
+#endif
+		} else {
+			pagmo_throw(value_error,"unknown suite: " + name);
+		}
+	}
+	return retval;
+}
+
+// Quality indicator of the population, the lower the better.
+static double indicator(const population &pop)
+{
+	const problem::base &prob = pop.problem();
+	if (prob.get_f_dimension() == 1) {
+		// Infeasible points are assigned the highest double by death_penalty.
+		const double f = pop.champion().f[0];
+		return (f == std::numeric_limits<double>::max()) ? std::numeric_limits<double>::infinity() : f;
+	}
+	const problem::base_unc_mo *mo = dynamic_cast<const problem::base_unc_mo *>(&prob);
+	if (mo) {
+		return mo->p_distance(pop);
+	}
+	const fitness_vector ref(prob.get_f_dimension(),hv_reference);
+	std::vector<fitness_vector> points;
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		const fitness_vector &f = pop.get_individual(i).cur_f;
+		bool inside = true;
+		for (fitness_vector::size_type j = 0; j < f.size() && inside; ++j) {
+			inside = f[j] < ref[j];
+		}
+		if (inside) {
+			points.push_back(f);
+		}
+	}
+	return points.empty() ? 0. : -util::hypervolume(points).compute(ref);
+}
+
+struct trace_point
+{
+	unsigned long long	fevals;
+	double			wall;
+	double			best;
+};
+
+struct run_record
+{
+	std::size_t			algo;
+	std::size_t			prob;
+	unsigned int			seed;
+	std::vector<trace_point>	trace;
+	std::string			error;
+};
+
+struct settings
+{
+	settings():seeds(5),budget(1000),population(20),generations(1),dimension(10),cec2013_data("input_data/"),
+		threads(boost::thread::hardware_concurrency()),output_dir("."),binary(false)
+	{
+		algorithms.push_back("de");
+		algorithms.push_back("jde");
+		algorithms.push_back("pso");
+		algorithms.push_back("cmaes");
+		algorithms.push_back("nsga2");
+		suites.push_back("cec2006");
+		suites.push_back("zdt");
+		suites.push_back("dtlz");
+		for (int i = 2; i >= -8; --i) {
+			targets.push_back(std::pow(10.,i));
+		}
+	}
+	std::vector<std::string>	algorithms;
+	std::vector<std::string>	suites;
+	std::string			filter;
+	unsigned int			seeds;
+	unsigned int			budget;
+	int				population;
+	int				generations;
+	std::vector<double>		targets;
+	unsigned int			dimension;
+	std::string			cec2013_data;
+	unsigned int			threads;
+	std::string			output_dir;
+	bool				binary;
+};
+
+static double elapsed(const boost::posix_time::ptime &start)
+{
+	return (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() * 1E-6;
+}
+
+// The wall time of a run counts the evaluations of the initial population and the evolutions, not the indicator.
+static void run(const settings &s, const problem_entry &entry, run_record &rec)
+{
+	const algorithm::base_ptr algo = make_algorithm(s.algorithms[rec.algo],s.generations);
+	algo->reset_rngs(rec.seed);
+	const unsigned long long budget = static_cast<unsigned long long>(s.budget) * entry.prob->get_dimension();
+	const double finest = *std::min_element(s.targets.begin(),s.targets.end());
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+	population pop(*entry.prob,s.population,rec.seed);
+	double wall = elapsed(start);
+	trace_point point;
+	point.fevals = pop.problem().get_fevals();
+	point.wall = wall;
+	point.best = indicator(pop);
+	rec.trace.push_back(point);
+	while (point.fevals < budget && !(entry.known_optimum && point.best - entry.f_opt <= finest)) {
+		start = boost::posix_time::microsec_clock::universal_time();
+		algo->evolve(pop);
+		wall += elapsed(start);
+		const unsigned long long fevals = pop.problem().get_fevals();
+		// Stop if the algorithm does not evaluate anymore.
+		if (fevals == point.fevals) {
+			break;
+		}
+		point.fevals = fevals;
+		point.wall = wall;
+		const double best = indicator(pop);
+		if (best < point.best) {
+			point.best = best;
+			rec.trace.push_back(point);
+		}
+	}
+	// Final cost of the run.
+	if (rec.trace.back().fevals != point.fevals) {
+		rec.trace.push_back(point);
+	}
+}
+
+// Worker thread: runs the jobs left in the matrix.
+struct worker
+{
+	worker(const settings &s, const std::vector<problem_entry> &suite, std::vector<run_record> &records, std::size_t &next,
+		boost::mutex &mutex):m_s(s),m_suite(suite),m_records(records),m_next(next),m_mutex(mutex) {}
+	void operator()() const
+	{
+		while (true) {
+			std::size_t i;
+			{
+				boost::lock_guard<boost::mutex> lock(m_mutex);
+				if (m_next == m_records.size()) {
+					return;
+				}
+				i = m_next++;
+			}
+			run_record &rec = m_records[i];
+			try {
+				run(m_s,m_suite[rec.prob],rec);
+			} catch (const std::exception &e) {
+				rec.error = e.what();
+			} catch (...) {
+				rec.error = "unknown exception";
+			}
+		}
+	}
+	const settings			&m_s;
+	const std::vector<problem_entry>	&m_suite;
+	std::vector<run_record>		&m_records;
+	std::size_t			&m_next;
+	boost::mutex			&m_mutex;
+};
+
+// First trace point reaching value, or 0 if the run did not reach it. Infinite values never reach a target.
+static const trace_point *first_hit(const run_record &rec, double value)
+{
+	for (std::vector<trace_point>::size_type i = 0; i < rec.trace.size(); ++i) {
+		if (rec.trace[i].best <= value && !std::isinf(rec.trace[i].best)) {
+			return &rec.trace[i];
+		}
+	}
+	return 0;
+}
+
+static std::string number(double x)
+{
+	if (std::isinf(x)) {
+		return x > 0 ? "inf" : "-inf";
+	}
+	std::ostringstream oss;
+	oss.precision(10);
+	oss << x;
+	return oss.str();
+}
+
+// Reference of each problem: the known optimum, or the best value found by the runs.
+static std::vector<double> references(const std::vector<problem_entry> &suite, const std::vector<run_record> &records)
+{
+	std::vector<double> retval;
+	for (std::vector<problem_entry>::size_type p = 0; p < suite.size(); ++p) {
+		retval.push_back(suite[p].known_optimum ? suite[p].f_opt : std::numeric_limits<double>::infinity());
+	}
+	for (std::vector<run_record>::size_type i = 0; i < records.size(); ++i) {
+		if (records[i].error.empty() && !suite[records[i].prob].known_optimum) {
+			retval[records[i].prob] = std::min(retval[records[i].prob],records[i].trace.back().best);
+		}
+	}
+	return retval;
+}
+
+static void write_ert(std::ostream &os, const settings &s, const std::vector<problem_entry> &suite,
+	const std::vector<run_record> &records, const std::vector<double> &refs)
+{
+	os << "algorithm,problem,dimension,target,reference,reference_source,runs,successes,success_rate,ert_fevals,ert_seconds\n";
+	for (std::size_t a = 0; a < s.algorithms.size(); ++a) {
+		for (std::size_t p = 0; p < suite.size(); ++p) {
+			for (std::size_t t = 0; t < s.targets.size(); ++t) {
+				unsigned int runs = 0, successes = 0;
+				double fevals = 0, seconds = 0;
+				for (std::size_t i = 0; i < records.size(); ++i) {
+					const run_record &rec = records[i];
+					if (rec.algo != a || rec.prob != p || !rec.error.empty()) {
+						continue;
+					}
+					++runs;
+					const trace_point *hit = first_hit(rec,refs[p] + s.targets[t]);
+					if (hit) {
+						++successes;
+						fevals += hit->fevals;
+						seconds += hit->wall;
+					} else {
+						fevals += rec.trace.back().fevals;
+						seconds += rec.trace.back().wall;
+					}
+				}
+				if (!runs) {
+					continue;
+				}
+				const double inf = std::numeric_limits<double>::infinity();
+				os << s.algorithms[a] << ',' << suite[p].name << ',' << suite[p].prob->get_dimension() << ',' << number(s.targets[t])
+					<< ',' << number(refs[p]) << ',' << (suite[p].known_optimum ? "known" : "best_run") << ',' << runs << ','
+					<< successes << ',' << number(static_cast<double>(successes) / runs) << ','
+					<< number(successes ? fevals / successes : inf) << ',' << number(successes ? seconds / successes : inf) << '\n';
+			}
+		}
+	}
+}
+
+// Runtimes in fevals / dimension of all the (run, target) pairs of algorithm a on problem p (all problems if p is
+// the size of the suite). Unreached targets are assigned an infinite runtime.
+static std::vector<double> runtimes(const settings &s, const std::vector<problem_entry> &suite, const std::vector<run_record> &records,
+	const std::vector<double> &refs, std::size_t a, std::size_t p)
+{
+	std::vector<double> retval;
+	for (std::size_t i = 0; i < records.size(); ++i) {
+		const run_record &rec = records[i];
+		if (rec.algo != a || (p != suite.size() && rec.prob != p) || !rec.error.empty()) {
+			continue;
+		}
+		for (std::size_t t = 0; t < s.targets.size(); ++t) {
+			const trace_point *hit = first_hit(rec,refs[rec.prob] + s.targets[t]);
+			retval.push_back(hit ? static_cast<double>(hit->fevals) / suite[rec.prob].prob->get_dimension() :
+				std::numeric_limits<double>::infinity());
+		}
+	}
+	std::sort(retval.begin(),retval.end());
+	return retval;
+}
+
+// The budgets are 5 per decade, up to the maximum budget.
+static void write_ecdf(std::ostream &os, const settings &s, const std::vector<problem_entry> &suite,
+	const std::vector<run_record> &records, const std::vector<double> &refs)
+{
+	os << "algorithm,problem,fevals_per_dimension,fraction\n";
+	for (std::size_t a = 0; a < s.algorithms.size(); ++a) {
+		for (std::size_t p = 0; p <= suite.size(); ++p) {
+			const std::vector<double> rt = runtimes(s,suite,records,refs,a,p);
+			if (rt.empty()) {
+				continue;
+			}
+			for (int k = 0; ; ++k) {
+				const double b = std::min(std::pow(10.,k / 5.),static_cast<double>(s.budget));
+				const std::size_t reached = std::upper_bound(rt.begin(),rt.end(),b) - rt.begin();
+				os << s.algorithms[a] << ',' << (p == suite.size() ? "all" : suite[p].name) << ',' << number(b) << ','
+					<< number(static_cast<double>(reached) / rt.size()) << '\n';
+				if (b >= s.budget) {
+					break;
+				}
+			}
+		}
+	}
+}
+
+static void write_traces_csv(std::ostream &os, const settings &s, const std::vector<problem_entry> &suite,
+	const std::vector<run_record> &records)
+{
+	os << "algorithm,problem,seed,fevals,wall_s,best\n";
+	for (std::size_t i = 0; i < records.size(); ++i) {
+		const run_record &rec = records[i];
+		if (!rec.error.empty()) {
+			continue;
+		}
+		for (std::size_t j = 0; j < rec.trace.size(); ++j) {
+			os << s.algorithms[rec.algo] << ',' << suite[rec.prob].name << ',' << rec.seed << ',' << rec.trace[j].fevals << ','
+				<< number(rec.trace[j].wall) << ',' << number(rec.trace[j].best) << '\n';
+		}
+	}
+}
+
+template <class T>
+static void write_raw(std::ostream &os, const T &x)
+{
+	os.write(reinterpret_cast<const char *>(&x),sizeof(T));
+}
+
+static void write_raw_string(std::ostream &os, const std::string &str)
+{
+	write_raw(os,static_cast<boost::uint32_t>(str.size()));
+	os.write(str.data(),str.size());
+}
+
+static void write_traces_binary(std::ostream &os, const settings &s, const std::vector<problem_entry> &suite,
+	const std::vector<run_record> &records)
+{
+	boost::uint32_t n_runs = 0;
+	for (std::size_t i = 0; i < records.size(); ++i) {
+		n_runs += records[i].error.empty();
+	}
+	os.write("PAGMOERT",8);
+	write_raw(os,boost::uint32_t(1));
+	write_raw(os,n_runs);
+	for (std::size_t i = 0; i < records.size(); ++i) {
+		const run_record &rec = records[i];
+		if (!rec.error.empty()) {
+			continue;
+		}
+		write_raw_string(os,s.algorithms[rec.algo]);
+		write_raw_string(os,suite[rec.prob].name);
+		write_raw(os,static_cast<boost::uint32_t>(rec.seed));
+		write_raw(os,static_cast<boost::uint32_t>(rec.trace.size()));
+		for (std::size_t j = 0; j < rec.trace.size(); ++j) {
+			write_raw(os,static_cast<boost::uint64_t>(rec.trace[j].fevals));
+			write_raw(os,rec.trace[j].wall);
+			write_raw(os,rec.trace[j].best);
+		}
+	}
+}
+
+static std::vector<std::string> split(const std::string &str)
+{
+	std::vector<std::string> retval;
+	std::istringstream iss(str);
+	std::string item;
+	while (std::getline(iss,item,',')) {
+		if (!item.empty()) {
+			retval.push_back(item);
+		}
+	}
+	if (retval.empty()) {
+		pagmo_throw(value_error,"empty list");
+	}
+	return retval;
+}
+
+template <std::size_t N>
+static void print_names(const char *what, const char *(&names)[N])
+{
+	std::cout << what << ':';
+	for (std::size_t i = 0; i < N; ++i) {
+		std::cout << ' ' << names[i];
+	}
+	std::cout << '\n';
+}
+
+static void usage(const char *name)
+{
+	std::cerr << "Usage: " << name << " [--algorithms <a1,a2,...>] [--suites <s1,s2,...>] [--filter <substring>] [--seeds <n>]\n"
+		"       [--budget <fevals per dimension>] [--population <n>] [--generations <n>] [--targets <p1,p2,...>]\n"
+		"       [--dimension <n>] [--cec2013-data <dir>] [--threads <n>] [--output-dir <dir>] [--binary] [--list]\n";
+}
+
+int main(int argc, char **argv)
+{
+	settings s;
+	std::vector<problem_entry> suite;
+	try {
+		for (int i = 1; i < argc; ++i) {
+			const std::string arg(argv[i]);
+			if (arg == "--list") {
+				print_names("algorithms",algorithm_names);
+				print_names("suites",suite_names);
+				return 0;
+			} else if (arg == "--binary") {
+				s.binary = true;
+			} else if (i + 1 < argc && arg == "--algorithms") {
+				s.algorithms = split(argv[++i]);
+			} else if (i + 1 < argc && arg == "--suites") {
+				s.suites = split(argv[++i]);
+			} else if (i + 1 < argc && arg == "--filter") {
+				s.filter = argv[++i];
+			} else if (i + 1 < argc && arg == "--seeds") {
+				s.seeds = std::max(boost::lexical_cast<unsigned int>(argv[++i]),1u);
+			} else if (i + 1 < argc && arg == "--budget") {
+				s.budget = std::max(boost::lexical_cast<unsigned int>(argv[++i]),1u);
+			} else if (i + 1 < argc && arg == "--population") {
+				s.population = boost::lexical_cast<int>(argv[++i]);
+			} else if (i + 1 < argc && arg == "--generations") {
+				s.generations = boost::lexical_cast<int>(argv[++i]);
+			} else if (i + 1 < argc && arg == "--targets") {
+				const std::vector<std::string> targets = split(argv[++i]);
+				s.targets.clear();
+				for (std::size_t j = 0; j < targets.size(); ++j) {
+					s.targets.push_back(boost::lexical_cast<double>(targets[j]));
+				}
+			} else if (i + 1 < argc && arg == "--dimension") {
+				s.dimension = boost::lexical_cast<unsigned int>(argv[++i]);
+			} else if (i + 1 < argc && arg == "--cec2013-data") {
+				s.cec2013_data = argv[++i];
+			} else if (i + 1 < argc && arg == "--threads") {
+				s.threads = boost::lexical_cast<unsigned int>(argv[++i]);
+			} else if (i + 1 < argc && arg == "--output-dir") {
+				s.output_dir = argv[++i];
+			} else {
+				usage(argv[0]);
+				return 1;
+			}
+		}
+		for (std::size_t i = 0; i < s.algorithms.size(); ++i) {
+			make_algorithm(s.algorithms[i],s.generations);
+		}
+		const std::vector<problem_entry> all = build_suite(s.suites,s.dimension,s.cec2013_data);
+		for (std::size_t i = 0; i < all.size(); ++i) {
+			if (all[i].name.find(s.filter) != std::string::npos) {
+				suite.push_back(all[i]);
+			}
+		}
+	} catch (const std::exception &e) {
+		std::cerr << e.what() << '\n';
+		usage(argv[0]);
+		return 1;
+	}
+	// The matrix of runs. Each record is filled by the thread running it.
+	std::vector<run_record> records;
+	for (std::size_t p = 0; p < suite.size(); ++p) {
+		for (std::size_t a = 0; a < s.algorithms.size(); ++a) {
+			for (unsigned int seed = 1; seed <= s.seeds; ++seed) {
+				run_record rec;
+				rec.algo = a;
+				rec.prob = p;
+				rec.seed = seed;
+				records.push_back(rec);
+			}
+		}
+	}
+	std::cerr << records.size() << " runs on " << suite.size() << " problems\n";
+	const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+	std::size_t next = 0;
+	boost::mutex mutex;
+	boost::thread_group threads;
+	for (unsigned int i = 0; i < std::max(s.threads,1u); ++i) {
+		threads.create_thread(worker(s,suite,records,next,mutex));
+	}
+	threads.join_all();
+	std::cerr << "done in " << elapsed(start) << " s\n";
+	// Report the failed runs once per algorithm and error, typically an algorithm unsuitable for some problems.
+	std::map<std::pair<std::size_t,std::string>,std::vector<std::size_t> > errors;
+	for (std::size_t i = 0; i < records.size(); ++i) {
+		if (!records[i].error.empty()) {
+			std::vector<std::size_t> &probs = errors[std::make_pair(records[i].algo,records[i].error)];
+			if (probs.empty() || probs.back() != records[i].prob) {
+				probs.push_back(records[i].prob);
+			}
+		}
+	}
+	for (std::map<std::pair<std::size_t,std::string>,std::vector<std::size_t> >::const_iterator it = errors.begin(); it != errors.end(); ++it) {
+		std::cerr << s.algorithms[it->first.first] << " failed on";
+		for (std::size_t i = 0; i < it->second.size(); ++i) {
+			std::cerr << ' ' << suite[it->second[i]].name;
+		}
+		std::cerr << ": " << it->first.second << '\n';
+	}
+	const std::vector<double> refs = references(suite,records);
+	const std::string prefix = s.output_dir + "/";
+	std::ofstream ert((prefix + "ert.csv").c_str());
+	write_ert(ert,s,suite,records,refs);
+	std::ofstream ecdf((prefix + "ecdf.csv").c_str());
+	write_ecdf(ecdf,s,suite,records,refs);
+	if (s.binary) {
+		std::ofstream traces((prefix + "traces.bin").c_str(),std::ios::binary);
+		write_traces_binary(traces,s,suite,records);
+	} else {
+		std::ofstream traces((prefix + "traces.csv").c_str());
+		write_traces_csv(traces,s,suite,records);
+	}
+	if (!ert || !ecdf) {
+		std::cerr << "could not write the results in " << s.output_dir << '\n';
+		return 1;
+	}
+	return 0;
+}
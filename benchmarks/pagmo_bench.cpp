@@ -0,0 +1,464 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Microbenchmarks of the hot paths of PaGMO. Each benchmark performs a number of operations calibrated to last
+// at least --min-time seconds, repeated --repetitions times. The median, minimum and maximum times per operation and
+// the number of heap allocations per operation are written in JSON to the standard output or to --output.
+//
+// Usage: pagmo_bench [--filter <substring>] [--min-time <seconds>] [--repetitions <n>] [--output <file>] [--list]
+
+#include <algorithm>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/serialization/shared_ptr.hpp>
+#include <boost/serialization/utility.hpp>
+#include <boost/shared_ptr.hpp>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../src/pagmo.h"
+#include "alloc_counter.h"
+#ifdef PAGMO_ENABLE_KEP_TOOLBOX
+#include "../src/keplerian_toolbox/keplerian_toolbox.h"
+#endif
+
+using namespace pagmo;
+
+// Base benchmark class: the constructor prepares the data, run() performs n operations.
+class benchmark
+{
+	public:
+		explicit benchmark(const std::string &name):m_name(name) {}
+		virtual ~benchmark() {}
+		virtual void run(std::size_t n) = 0;
+		const std::string &name() const
+		{
+			return m_name;
+		}
+	private:
+		const std::string m_name;
+};
+
+typedef boost::shared_ptr<benchmark> benchmark_ptr;
+
+// Random decision vectors within the bounds of the problem.
+static std::vector<decision_vector> random_block(const problem::base &prob, std::size_t n)
+{
+	rng_double drng(42);
+	std::vector<decision_vector> retval(n,decision_vector(prob.get_dimension()));
+	for (std::size_t i = 0; i < n; ++i) {
+		for (problem::base::size_type j = 0; j < prob.get_dimension(); ++j) {
+			retval[i][j] = boost::uniform_real<double>(prob.get_lb()[j],prob.get_ub()[j])(drng);
+		}
+	}
+	return retval;
+}
+
+// Number of distinct points cycled through by the benchmarks, well above problem::base::cache_capacity.
+static const std::size_t n_points = 256;
+
+// population::set_x() on a population of 64 individuals.
+class population_set_x: public benchmark
+{
+	public:
+		population_set_x(const problem::base &prob):benchmark("population_set_x/" + prob.get_name()),
+			m_pop(prob,64,42),m_x(random_block(prob,n_points)) {}
+		void run(std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; ++i) {
+				m_pop.set_x(i % m_pop.size(),m_x[i % m_x.size()]);
+			}
+		}
+	private:
+		population			m_pop;
+		const std::vector<decision_vector>	m_x;
+};
+
+// population::push_back() filling populations of up to 64 individuals (the population is cleared when full).
+class population_push_back: public benchmark
+{
+	public:
+		population_push_back(const problem::base &prob):benchmark("population_push_back/" + prob.get_name()),
+			m_pop(prob,0,42),m_x(random_block(prob,n_points)) {}
+		void run(std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; ++i) {
+				if (m_pop.size() == 64) {
+					m_pop.clear();
+				}
+				m_pop.push_back(m_x[i % m_x.size()]);
+			}
+		}
+	private:
+		population			m_pop;
+		const std::vector<decision_vector>	m_x;
+};
+
+// Exposes the protected domination update of the population.
+class dom_population: public population
+{
+	public:
+		dom_population(const problem::base &prob, int n):population(prob,n,42) {}
+		void update(const size_type &idx)
+		{
+			update_dom(idx);
+		}
+};
+
+// Domination list update of one individual in a population of 64 individuals.
+class population_update_dom: public benchmark
+{
+	public:
+		population_update_dom(const problem::base &prob):benchmark("population_update_dom/" + prob.get_name()),m_pop(prob,64) {}
+		void run(std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; ++i) {
+				m_pop.update(i % m_pop.size());
+			}
+		}
+	private:
+		dom_population	m_pop;
+};
+
+// problem::base::objfun(), either always on the same point (cache hits) or cycling through n_points points (cache misses).
+class objfun: public benchmark
+{
+	public:
+		objfun(const problem::base &prob, bool hit):benchmark(std::string(hit ? "objfun_cache_hit/" : "objfun/") + prob.get_name()),
+			m_prob(prob.clone()),m_x(random_block(prob,hit ? 1 : n_points)),m_f(prob.get_f_dimension()) {}
+		void run(std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; ++i) {
+				m_prob->objfun(m_f,m_x[i % m_x.size()]);
+			}
+		}
+	private:
+		const problem::base_ptr			m_prob;
+		const std::vector<decision_vector>	m_x;
+		fitness_vector				m_f;
+};
+
+// problem::base::compare_fc() between fitness/constraint pairs of random points.
+class compare_fc: public benchmark
+{
+	public:
+		compare_fc(const problem::base &prob):benchmark("compare_fc/" + prob.get_name()),m_prob(prob.clone()),m_count(0)
+		{
+			const std::vector<decision_vector> x = random_block(prob,n_points);
+			for (std::size_t i = 0; i < x.size(); ++i) {
+				m_f.push_back(prob.objfun(x[i]));
+				m_c.push_back(prob.compute_constraints(x[i]));
+			}
+		}
+		void run(std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; ++i) {
+				const std::size_t j = i % m_f.size(), k = (i * 7 + 1) % m_f.size();
+				m_count += m_prob->compare_fc(m_f[j],m_c[j],m_f[k],m_c[k]);
+			}
+		}
+	private:
+		const problem::base_ptr			m_prob;
+		std::vector<fitness_vector>		m_f;
+		std::vector<constraint_vector>		m_c;
+		std::size_t				m_count;
+};
+
+// One archipelago::evolve() of 8 islands of 20 individuals with the null algorithm: the cost is made of the island
+// threads and of the migration through the topology.
+class archipelago_migration: public benchmark
+{
+	public:
+		archipelago_migration(const topology::base &topo):benchmark("archipelago_migration/" + topo.get_name()),
+			m_archi(algorithm::null(),problem::rosenbrock(10),8,20,topo) {}
+		void run(std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; ++i) {
+				m_archi.evolve(1);
+				m_archi.join();
+			}
+		}
+	private:
+		archipelago	m_archi;
+};
+
+// Text archive round-trip of the (population, algorithm) pair sent to the MPI islands, as done by mpi_environment.
+class mpi_serialization: public benchmark
+{
+	public:
+		mpi_serialization(const problem::base &prob, int size):
+			benchmark("mpi_serialization/" + prob.get_name() + "/" + boost::lexical_cast<std::string>(size)),
+			m_payload(boost::shared_ptr<population>(new population(prob,size,42)),algorithm::de(10).clone()) {}
+		void run(std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; ++i) {
+				std::stringstream ss;
+				{
+					boost::archive::text_oarchive oa(ss);
+					oa << m_payload;
+				}
+				const std::string buffer(ss.str());
+				std::stringstream in(buffer);
+				boost::archive::text_iarchive ia(in);
+				payload_type retval;
+				ia >> retval;
+			}
+		}
+	private:
+		typedef std::pair<boost::shared_ptr<population>,algorithm::base_ptr> payload_type;
+		const payload_type	m_payload;
+};
+
+#ifdef PAGMO_ENABLE_KEP_TOOLBOX
+// Random state vectors on orbits of semi-major axis in [1,3] (non dimensional units).
+static void random_states(std::vector<kep_toolbox::array3D> &r, std::vector<kep_toolbox::array3D> &v)
+{
+	rng_double drng(42);
+	for (std::size_t i = 0; i < n_points; ++i) {
+		const double a = boost::uniform_real<double>(1,3)(drng), theta = boost::uniform_real<double>(0,6.28)(drng);
+		const double vc = 1. / std::sqrt(a) * boost::uniform_real<double>(0.8,1.2)(drng);
+		const kep_toolbox::array3D ri = {{ a * std::cos(theta), a * std::sin(theta), 0.1 * boost::uniform_real<double>(-1,1)(drng) }};
+		const kep_toolbox::array3D vi = {{ -vc * std::sin(theta), vc * std::cos(theta), 0.05 * boost::uniform_real<double>(-1,1)(drng) }};
+		r.push_back(ri);
+		v.push_back(vi);
+	}
+}
+
+// Construction (and solution) of a multi-revolution lambert_problem.
+class lambert: public benchmark
+{
+	public:
+		lambert():benchmark("lambert_problem"),m_sum(0)
+		{
+			random_states(m_r,m_v);
+		}
+		void run(std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; ++i) {
+				const std::size_t j = i % m_r.size(), k = (j + 1) % m_r.size();
+				const kep_toolbox::lambert_problem lp(m_r[j],m_r[k],1. + static_cast<double>(j % 10),1.,0,5);
+				m_sum += lp.get_v1()[0][0];
+			}
+		}
+	private:
+		std::vector<kep_toolbox::array3D>	m_r, m_v;
+		double					m_sum;
+};
+
+// Keplerian propagation with Lagrange coefficients.
+class propagate_lagrangian: public benchmark
+{
+	public:
+		propagate_lagrangian():benchmark("propagate_lagrangian")
+		{
+			random_states(m_r,m_v);
+		}
+		void run(std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; ++i) {
+				kep_toolbox::array3D r = m_r[i % m_r.size()], v = m_v[i % m_r.size()];
+				kep_toolbox::propagate_lagrangian(r,v,1. + static_cast<double>(i % 10),1.);
+			}
+		}
+	private:
+		std::vector<kep_toolbox::array3D>	m_r, m_v;
+};
+
+// Thrusted propagation with the Taylor integrator.
+class propagate_taylor: public benchmark
+{
+	public:
+		propagate_taylor():benchmark("propagate_taylor")
+		{
+			random_states(m_r,m_v);
+		}
+		void run(std::size_t n)
+		{
+			const kep_toolbox::array3D thrust = {{ 0.01, 0.005, 0. }};
+			for (std::size_t i = 0; i < n; ++i) {
+				kep_toolbox::array3D r = m_r[i % m_r.size()], v = m_v[i % m_r.size()];
+				double m = 1.;
+				kep_toolbox::propagate_taylor(r,v,m,thrust,1.,1.,1.,-10,-10);
+			}
+		}
+	private:
+		std::vector<kep_toolbox::array3D>	m_r, m_v;
+};
+#endif
+
+static std::vector<benchmark_ptr> all_benchmarks()
+{
+	std::vector<benchmark_ptr> retval;
+	retval.push_back(benchmark_ptr(new population_set_x(problem::rosenbrock(10))));
+	retval.push_back(benchmark_ptr(new population_set_x(problem::zdt(1,30))));
+	retval.push_back(benchmark_ptr(new population_push_back(problem::rosenbrock(10))));
+	retval.push_back(benchmark_ptr(new population_push_back(problem::zdt(1,30))));
+	retval.push_back(benchmark_ptr(new population_update_dom(problem::rosenbrock(10))));
+	retval.push_back(benchmark_ptr(new population_update_dom(problem::zdt(1,30))));
+	retval.push_back(benchmark_ptr(new objfun(problem::rosenbrock(10),true)));
+	retval.push_back(benchmark_ptr(new compare_fc(problem::rosenbrock(10))));
+	retval.push_back(benchmark_ptr(new compare_fc(problem::cec2006(7))));
+	retval.push_back(benchmark_ptr(new archipelago_migration(topology::unconnected())));
+	retval.push_back(benchmark_ptr(new archipelago_migration(topology::ring())));
+	retval.push_back(benchmark_ptr(new archipelago_migration(topology::one_way_ring())));
+	retval.push_back(benchmark_ptr(new archipelago_migration(topology::fully_connected())));
+	retval.push_back(benchmark_ptr(new archipelago_migration(topology::barabasi_albert())));
+	retval.push_back(benchmark_ptr(new mpi_serialization(problem::rosenbrock(10),20)));
+	retval.push_back(benchmark_ptr(new mpi_serialization(problem::rosenbrock(10),200)));
+	// Representative problems (cache misses)
+	retval.push_back(benchmark_ptr(new objfun(problem::rosenbrock(10),false)));
+	retval.push_back(benchmark_ptr(new objfun(problem::ackley(30),false)));
+	retval.push_back(benchmark_ptr(new objfun(problem::rastrigin(30),false)));
+	retval.push_back(benchmark_ptr(new objfun(problem::zdt(1,30),false)));
+	retval.push_back(benchmark_ptr(new objfun(problem::dtlz(2,10,3),false)));
+	retval.push_back(benchmark_ptr(new objfun(problem::cec2006(7),false)));
+	retval.push_back(benchmark_ptr(new objfun(problem::tsp(),false)));
+#ifdef PAGMO_ENABLE_KEP_TOOLBOX
+	retval.push_back(benchmark_ptr(new objfun(problem::cassini_1(),false)));
+	retval.push_back(benchmark_ptr(new objfun(problem::gtoc_1(),false)));
+	retval.push_back(benchmark_ptr(new objfun(problem::messenger_full(),false)));
+	retval.push_back(benchmark_ptr(new objfun(problem::mga_1dsm_tof(),false)));
+	retval.push_back(benchmark_ptr(new lambert()));
+	retval.push_back(benchmark_ptr(new propagate_lagrangian()));
+	retval.push_back(benchmark_ptr(new propagate_taylor()));
+#endif
+	return retval;
+}
+
+static double elapsed(const boost::posix_time::ptime &start)
+{
+	return (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() * 1E-6;
+}
+
+// Timing of n operations.
+static double time_run(benchmark &b, std::size_t n)
+{
+	const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+	b.run(n);
+	return elapsed(start);
+}
+
+struct result
+{
+	std::string	name;
+	std::size_t	ops;
+	double		median_ns;
+	double		min_ns;
+	double		max_ns;
+	double		allocs;
+};
+
+static result measure(benchmark &b, double min_time, unsigned int repetitions)
+{
+	// Warm up, then double the number of operations until a run lasts at least min_time.
+	std::size_t n = 1;
+	b.run(n);
+	while (time_run(b,n) < min_time && n < (std::size_t(1) << 30)) {
+		n *= 2;
+	}
+	std::vector<double> ns;
+	unsigned long long allocs = 0;
+	for (unsigned int r = 0; r < repetitions; ++r) {
+		const unsigned long long a0 = allocation_count();
+		ns.push_back(time_run(b,n) * 1E9 / static_cast<double>(n));
+		allocs += allocation_count() - a0;
+	}
+	std::sort(ns.begin(),ns.end());
+	result retval;
+	retval.name = b.name();
+	retval.ops = n;
+	retval.median_ns = ns[ns.size() / 2];
+	retval.min_ns = ns.front();
+	retval.max_ns = ns.back();
+	retval.allocs = static_cast<double>(allocs) / (static_cast<double>(n) * repetitions);
+	return retval;
+}
+
+static void write_json(std::ostream &os, const std::vector<result> &results, double min_time, unsigned int repetitions)
+{
+	os.precision(6);
+	os << "{\n  \"min_time\": " << min_time << ",\n  \"repetitions\": " << repetitions << ",\n  \"benchmarks\": [";
+	for (std::size_t i = 0; i < results.size(); ++i) {
+		const result &r = results[i];
+		os << (i ? ",\n" : "\n") << "    {\"name\": \"" << r.name << "\", \"ops\": " << r.ops
+			<< ", \"ns_per_op\": " << r.median_ns << ", \"min_ns_per_op\": " << r.min_ns
+			<< ", \"max_ns_per_op\": " << r.max_ns << ", \"allocs_per_op\": " << r.allocs << "}";
+	}
+	os << "\n  ]\n}\n";
+}
+
+int main(int argc, char **argv)
+{
+	std::string filter, output;
+	double min_time = 0.2;
+	unsigned int repetitions = 5;
+	bool list = false;
+	for (int i = 1; i < argc; ++i) {
+		const std::string arg(argv[i]);
+		if (arg == "--list") {
+			list = true;
+		} else if (i + 1 < argc && arg == "--filter") {
+			filter = argv[++i];
+		} else if (i + 1 < argc && arg == "--output") {
+			output = argv[++i];
+		} else if (i + 1 < argc && arg == "--min-time") {
+			min_time = boost::lexical_cast<double>(argv[++i]);
+		} else if (i + 1 < argc && arg == "--repetitions") {
+			repetitions = std::max(boost::lexical_cast<unsigned int>(argv[++i]),1u);
+		} else {
+			std::cerr << "Usage: " << argv[0] << " [--filter <substring>] [--min-time <seconds>] [--repetitions <n>] [--output <file>] [--list]\n";
+			return 1;
+		}
+	}
+	const std::vector<benchmark_ptr> benchmarks = all_benchmarks();
+	std::vector<result> results;
+	for (std::size_t i = 0; i < benchmarks.size(); ++i) {
+		if (benchmarks[i]->name().find(filter) == std::string::npos) {
+			continue;
+		}
+		if (list) {
+			std::cout << benchmarks[i]->name() << '\n';
+			continue;
+		}
+		results.push_back(measure(*benchmarks[i],min_time,repetitions));
+		// Progress on the standard error, so that the JSON on the standard output stays clean.
+		std::cerr << results.back().name << ": " << results.back().median_ns << " ns/op, " << results.back().allocs << " allocs/op\n";
+	}
+	if (list) {
+		return 0;
+	}
+	if (output.empty()) {
+		write_json(std::cout,results,min_time,repetitions);
+	} else {
+		std::ofstream ofs(output.c_str());
+		write_json(ofs,results,min_time,repetitions);
+	}
+	return 0;
+}
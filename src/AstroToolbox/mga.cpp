@@ -38,10 +38,10 @@ using namespace std;
 
 //the function return 0 if the input is right or -1 it there is something wrong
 
-int MGA(vector<double> t,	// it is the vector which provides time in modified julian date 2000.
+int MGA(const vector<double> &t,	// it is the vector which provides time in modified julian date 2000.
 								// The first entry is launch date, the next entries represent the time needed to
 								// fly from last swing-by to current swing-by.
-			mgaproblem problem,
+			const mgaproblem &problem,
 
 			/* OUTPUT values: */
 			vector<double>& rp,  // periplanets radius
@@ -50,11 +50,11 @@ int MGA(vector<double> t,	// it is the vector which provides time in modified ju
 
 {
 	const int n = problem.sequence.size();
-	const vector<int> sequence = problem.sequence;
-	const vector<int> rev_flag = problem.rev_flag;// array containing 0 clockwise, 1 un-clockwise
-	customobject cust_obj = problem.asteroid;
+	const vector<int> &sequence = problem.sequence;
+	const vector<int> &rev_flag = problem.rev_flag;// array containing 0 clockwise, 1 un-clockwise
+	const customobject &cust_obj = problem.asteroid;
 
-	double MU[9] = {//1.32712440018e11, //SUN = 0
+	static const double MU[9] = {//1.32712440018e11, //SUN = 0
 					1.32712428e11,
 					22321,		// Gravitational constant of Mercury	= 1
 					324860,		// Gravitational constant of Venus		= 2
@@ -65,7 +65,7 @@ int MGA(vector<double> t,	// it is the vector which provides time in modified ju
 					5.78e6,		// Gravitational constant of Uranus		= 7
 					6.8e6		// Gravitational constant of Neptune	= 8
 				    };
-	double penalty[9] = {0,
+	static const double penalty[9] = {0,
 		                0,        // Mercury
 						6351.8,   // Venus
 						6778.1,   // Earth
@@ -77,7 +77,7 @@ int MGA(vector<double> t,	// it is the vector which provides time in modified ju
 						0         // Neptune
 	};
 
-	double penalty_coeffs[9] = {0,
+	static const double penalty_coeffs[9] = {0,
 								0,      // Mercury
 								0.01,   // Venus
 								0.01,   // Earth
@@ -109,9 +109,13 @@ int MGA(vector<double> t,	// it is the vector which provides time in modified ju
 
 
 
-	double *vec, *rec;
-	vector<double*> r;    // {0...n-1} position
-	vector<double*> v;    // {0...n-1} velocity
+	// {0...n-1} positions and velocities (3 D vectors), in the memory pre-allocated in the problem
+	if (problem.r.size() != 3 * (size_t)n) {
+		problem.r.resize(3 * n);
+		problem.v.resize(3 * n);
+	}
+	double (*r)[3] = reinterpret_cast<double (*)[3]>(problem.r.empty() ? 0 : &problem.r[0]);
+	double (*v)[3] = reinterpret_cast<double (*)[3]>(problem.v.empty() ? 0 : &problem.v[0]);
 
 	double T = 0.0;         // total time
 
@@ -123,11 +127,6 @@ int MGA(vector<double> t,	// it is the vector which provides time in modified ju
 	{
 		for ( i_count = 0; i_count < n; i_count++)
 		{
-			vec = new double [3];  // velocity and position are 3 D vector
-			rec = new double [3];
-			r.push_back(vec);
-			v.push_back(rec);
-
 			DV [i_count] = 0.0;
 		}
 
@@ -258,15 +257,6 @@ int MGA(vector<double> t,	// it is the vector which provides time in modified ju
 		obj_funct = - (final_mass)* fabs(dot_prod);
 	}
 
-
-	// final clean
-	for ( i_count = 0;i_count < n;i_count++)
-	{
-		delete [] r[i_count];
-		delete [] v[i_count];
-	}
-	r.clear();
-	v.clear();
 	return 0;
 }
 
@@ -89,12 +89,16 @@ struct mgaproblem {
 	double Isp;
 	double mass;
 	double DVlaunch;
+
+	//Pre-allocated memory, in order to remove allocation of heap space in MGA calls (resized at the first call)
+	mutable std::vector<double> r;		// = std::vector<double>(3*n), positions of the planets
+	mutable std::vector<double> v;		// = std::vector<double>(3*n), velocities of the planets
 };
 
 int MGA( 
 		 //INPUTS
-		 std::vector<double>,
-		 mgaproblem, 
+		 const std::vector<double> &,
+		 const mgaproblem &, 
 		
 		 //OUTPUTS
 		 std::vector <double>&, std::vector<double>&, double&); 
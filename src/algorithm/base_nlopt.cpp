@@ -78,29 +78,12 @@ double base_nlopt::objfun_wrapper(const std::vector<double> &x, std::vector<doub
 	nlopt_wrapper_data *d = (nlopt_wrapper_data *)data;
 	pagmo_assert(d->f.size() == 1);
 
-	// Compute the gradient by central diffs if necessary TODO: also ipopt has this code (or similar)
-	// It should be moved elswhere in PaGMO. Plus be aware that here a chromsome outside the bounds
-	// can be created, thus invaidating its compatibility with the problem (exception will be thrown)
-
+	// Compute the gradient if necessary (analytically or by central differences, depending on the problem).
+	// Be aware that here a chromosome outside the bounds can be created, thus invalidating its
+	// compatibility with the problem (exception will be thrown)
 	if (!grad.empty()) {
-		std::copy(x.begin(),x.end(),d->dx.begin());
-		double central_diff;
-		const double h0=1e-8;
-		double h;
-		double mem;
-		for (size_t i =0; i < d->dx.size(); ++i)
-		{
-			h = h0 * std::max(1.,fabs(d->dx[i]));
-			mem = d->dx[i];
-			d->dx[i] += h;
-			d->prob->objfun(d->f,d->dx);
-			central_diff = d->f[0];
-			d->dx[i] -= 2*h;
-			d->prob->objfun(d->f,d->dx);
-			central_diff = (central_diff-d->f[0]) / 2 / h;
-			grad[i] = central_diff;
-			d->dx[i] = mem;
-		}
+		d->prob->objfun_gradient(d->dx,x);
+		std::copy(d->dx.begin(),d->dx.end(),grad.begin());
 	}
 
 	// Calculate the objective function.
@@ -120,7 +103,14 @@ double base_nlopt::constraints_wrapper(const std::vector<double> &x, std::vector
 	// It should be moved elswhere in PaGMO. Plus be aware that here a chromsome outside the bounds
 	// can be created, thus invaidating its compatibility with the problem (exception will be thrown)
 
-	if (!grad.empty()) {
+	if (!grad.empty() && d->prob->has_analytic_constraints_gradient()) {
+		// The whole jacobian is computed once per point and shared by all the constraints.
+		if (*d->jac_x != x) {
+			d->prob->constraints_gradient(*d->jac,x);
+			*d->jac_x = x;
+		}
+		std::copy(d->jac->begin() + d->c_comp * x.size(),d->jac->begin() + (d->c_comp + 1) * x.size(),grad.begin());
+	} else if (!grad.empty()) {
 		std::copy(x.begin(),x.end(),d->dx.begin());
 		double central_diff;
 		const double h0=1e-8;
@@ -186,7 +176,11 @@ void base_nlopt::evolve(population &pop) const
 	
 	// Structure to pass data to the constraint function wrapper.
 	std::vector<nlopt_wrapper_data> data_constrfun(boost::numeric_cast<std::vector<nlopt_wrapper_data>::size_type>(c_size));
+	std::vector<double> jac;
+	decision_vector jac_x;
 	for (problem::base::c_size_type i = 0; i < c_size; ++i) {
+		data_constrfun[i].jac = &jac;
+		data_constrfun[i].jac_x = &jac_x;
 		data_constrfun[i].prob = &problem;
 		data_constrfun[i].x.resize(problem.get_dimension());
 		data_constrfun[i].dx.resize(problem.get_dimension());
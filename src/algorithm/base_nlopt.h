@@ -70,6 +70,9 @@ class __PAGMO_VISIBLE base_nlopt: public base
 			fitness_vector			f;
 			constraint_vector		c;
 			problem::base::c_size_type	c_comp;
+			// Analytic jacobian of the constraints and the point where it was computed, shared by all the constraints.
+			std::vector<double>		*jac;
+			decision_vector			*jac_x;
 		};
 		int get_last_status() const;
 		static double objfun_wrapper(const std::vector<double> &, std::vector<double> &, void*);
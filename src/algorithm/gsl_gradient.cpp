@@ -121,8 +121,16 @@ void gsl_gradient::d_objfun_wrapper(const gsl_vector *v, void *params, gsl_vecto
 	for (problem::base::size_type i = 0; i < cont_size; ++i) {
 		par->x[i] = gsl_vector_get(v,i);
 	}
-	// Calculate the gradient.
-	objfun_numdiff_central(df,*par->p,par->x,par->step_size);
+	// Calculate the gradient, analytically if the problem provides it.
+	if (par->p->has_analytic_gradient()) {
+		decision_vector grad;
+		par->p->objfun_gradient(grad,par->x);
+		for (problem::base::size_type i = 0; i < cont_size; ++i) {
+			gsl_vector_set(df,i,grad[i]);
+		}
+	} else {
+		objfun_numdiff_central(df,*par->p,par->x,par->step_size);
+	}
 }
 
 // Simmultaneous function/derivative computation wrapper for the objective function.
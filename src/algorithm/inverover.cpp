@@ -24,6 +24,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <cstdlib>
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/uniform_real.hpp>
 #include <boost/random/variate_generator.hpp>
@@ -212,7 +213,9 @@ inverover::inverover(int gen, double ri, initialization_type ini_type)
 					pos2_c2 = (pos2_c1 == Nv-1? 0:pos2_c1+1);
 					pos1_c2 = std::find(tmp_tour.begin(),tmp_tour.end(),my_pop[i2][pos2_c2])-tmp_tour.begin();
 				}
-				stop = (abs(pos1_c1-pos1_c2)==1 || abs(pos1_c1-pos1_c2)==Nv-1);
+				// The positions are unsigned: take the distance on signed values, abs() of an unsigned difference is ambiguous.
+				const long dist = std::labs(static_cast<long>(pos1_c1) - static_cast<long>(pos1_c2));
+				stop = (dist == 1 || dist == static_cast<long>(Nv) - 1);
 				if(!stop){
 					changed = true;
 					if(pos1_c1<pos1_c2){
@@ -217,6 +217,12 @@ bool ipopt_problem::eval_grad_f(Ipopt::Index n, const Ipopt::Number* x, bool new
 	const double h0=1e-8;
 	double h;
 	std::copy(x,x+n,dv.begin());
+	if (m_pop->problem().has_analytic_gradient()) {
+		pagmo::decision_vector grad;
+		m_pop->problem().objfun_gradient(grad,dv);
+		std::copy(grad.begin(),grad.end(),grad_f);
+		return true;
+	}
 	for (pagmo::decision_vector::size_type i=0; i<dv.size();++i)
 	{
 		grad_f[i] = 0;
@@ -267,6 +273,15 @@ bool ipopt_problem::eval_jac_g(Ipopt::Index n, const Ipopt::Number* x, bool new_
 			jCol[i] = jJvar[i];
 		}
 	}
+	else if (m_pop->problem().has_analytic_constraints_gradient()) {
+		std::copy(x,x+n,dv.begin());
+		std::vector<double> jac;
+		m_pop->problem().constraints_gradient(jac,dv);
+		for (Ipopt::Index i=0;i<nele_jac;++i)
+		{
+			values[i] = jac[iJfun[i] * n + jJvar[i]];
+		}
+	}
 	else {
 		double central_diff;
 		const double h0 = 1e-8;
@@ -53,9 +53,6 @@ static int snopt_function_(integer    *Status, integer *n,    doublereal *x,
 	(void)n;
 	(void)needF;
 	(void)neF;
-	(void)needG;
-	(void)neG;
-	(void)G;
 	(void)lencu;
 	(void)iu;
 	(void)leniu;
@@ -86,6 +83,32 @@ static int snopt_function_(integer    *Status, integer *n,    doublereal *x,
 		*Status = -1; //signals to snopt that the evaluation of the objective function had numerical difficulties
 	}
 
+	//3 - the analytic derivatives, when the problem provides them. Elements of G left untouched are
+	//estimated by snopt (Derivative option 0)
+	if (*needG > 0 && *Status != -1) {
+		const pagmo::problem::base::size_type D = prob->get_dimension();
+		const bool grad = prob->has_analytic_gradient(), jac = prob->has_analytic_constraints_gradient();
+		try {
+			if (grad) {
+				prob->objfun_gradient(preallocated->grad,preallocated->x);
+			}
+			if (jac) {
+				prob->constraints_gradient(preallocated->jac,preallocated->x);
+			}
+			for (integer k = 0; k < *neG; ++k) {
+				const int row = preallocated->iGfun[k], col = preallocated->jGvar[k];
+				if (row == 0 && grad) {
+					G[k] = preallocated->grad[col];
+				} else if (row > 0 && jac) {
+					G[k] = preallocated->jac[(row - 1) * D + col];
+				}
+			}
+		}
+		catch (value_error) {
+			*Status = -1;
+		}
+	}
+
 	return 0;
 }
 
@@ -261,6 +284,8 @@ void snopt::evolve(population &pop) const
 
 	//We set the sparsity structure
 	int neG;
+	//snjac_ leaves the sparsity pattern in fortran style (starting from 1)
+	int index_base = 0;
 	try
 	{
 		std::vector<int> iGfun_vect, jGvar_vect;
@@ -279,9 +304,19 @@ void snopt::evolve(population &pop) const
 	{
 		SnoptProblem.computeJac();
 		neG = SnoptProblem.getNeG();
+		index_base = 1;
 	} //the user did not implement the sparsity in the problem
 
 
+	//The sparsity pattern (C style) is needed to fill in the analytic derivatives
+	di_comodo.iGfun.resize(neG);
+	di_comodo.jGvar.resize(neG);
+	for (int i=0;i < neG;i++)
+	{
+		di_comodo.iGfun[i] = iGfun[i] - index_base;
+		di_comodo.jGvar[i] = jGvar[i] - index_base;
+	}
+
 	if (m_screen_output)
 	{
 		std::cout << "PaGMO 4 SNOPT:" << std::endl << std::endl;
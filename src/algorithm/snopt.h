@@ -82,6 +82,11 @@ public:
 		decision_vector x;
 		constraint_vector c;
 		fitness_vector f;
+		// Sparsity pattern of G and workspace for the analytic derivatives (not serialized, set in evolve).
+		std::vector<int> iGfun;
+		std::vector<int> jGvar;
+		decision_vector grad;
+		std::vector<double> jac;
 		template <class Archive>
 		void serialize(Archive &ar, const unsigned int)
 		{
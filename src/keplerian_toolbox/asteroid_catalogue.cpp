@@ -0,0 +1,206 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2009 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/thread/once.hpp>
+#include <cmath>
+
+#include "asteroid_catalogue.h"
+#include "asteroid_gtoc2.h"
+#include "asteroid_gtoc5.h"
+#include "core_functions/convert_anomalies.h"
+#include "core_functions/par2ic.h"
+#include "exceptions.h"
+
+// Data tables compiled in asteroid_gtoc2.cpp ([id, a, e, i, Om, om, M, epoch, group], AU, deg, MJD) and in
+// asteroid_gtoc5.cpp ([epoch, a, e, i, Om, om, M], MJD, AU, deg)
+extern const double gtoc2_asteroids_data[911][9];
+extern const double gtoc5_asteroids_data[7076][7];
+
+namespace kep_toolbox {
+
+/// Returns the GTOC2 catalogue
+/**
+ * 911 rows: the asteroids of the four groups (rows 0 - 909) and the Earth (row 910), in the order of the original JPL data file.
+ */
+const asteroid_catalogue &asteroid_catalogue::gtoc2()
+{
+	// Statically initialised, so that the catalogue can be accessed during the initialisation of other static objects
+	static boost::once_flag flag = BOOST_ONCE_INIT;
+	static const asteroid_catalogue *cat = 0;
+	boost::call_once(flag,boost::bind(&asteroid_catalogue::build,GTOC2,&cat));
+	return *cat;
+}
+
+/// Returns the GTOC5 catalogue
+/**
+ * 7076 rows: the asteroids (rows 0 - 7074) and the Earth (row 7075), in the order of the original data file.
+ */
+const asteroid_catalogue &asteroid_catalogue::gtoc5()
+{
+	static boost::once_flag flag = BOOST_ONCE_INIT;
+	static const asteroid_catalogue *cat = 0;
+	boost::call_once(flag,boost::bind(&asteroid_catalogue::build,GTOC5,&cat));
+	return *cat;
+}
+
+// The catalogues are never destroyed, so that they can also be used during the destruction of static objects
+void asteroid_catalogue::build(const source_type &source, const asteroid_catalogue **cat)
+{
+	*cat = new asteroid_catalogue(source);
+}
+
+asteroid_catalogue::asteroid_catalogue(const source_type &source):m_source(source)
+{
+	const std::vector<double>::size_type n = (source == GTOC2) ? 911 : 7076;
+	m_a.resize(n); m_e.resize(n); m_i.resize(n); m_Om.resize(n); m_om.resize(n); m_M.resize(n);
+	m_epoch.resize(n); m_n.resize(n);
+	for (std::vector<double>::size_type k = 0; k < n; ++k) {
+		// Pointer to the keplerian elements (a,e,i,Om,om,M) in the data tables
+		const double *elem;
+		if (source == GTOC2) {
+			elem = &gtoc2_asteroids_data[k][1];
+			m_epoch[k] = epoch(gtoc2_asteroids_data[k][7],epoch::MJD).mjd2000();
+		} else {
+			elem = &gtoc5_asteroids_data[k][1];
+			m_epoch[k] = epoch(gtoc5_asteroids_data[k][0],epoch::MJD).mjd2000();
+		}
+		m_a[k] = elem[0] * ASTRO_AU;
+		m_e[k] = elem[1];
+		m_i[k] = elem[2] * ASTRO_DEG2RAD;
+		m_Om[k] = elem[3] * ASTRO_DEG2RAD;
+		m_om[k] = elem[4] * ASTRO_DEG2RAD;
+		m_M[k] = elem[5] * ASTRO_DEG2RAD;
+		// Same expression used by planet
+		m_n[k] = sqrt(ASTRO_MU_SUN / pow(m_a[k],3));
+	}
+}
+
+void asteroid_catalogue::check_index(const std::vector<double>::size_type &i) const
+{
+	if (i >= size()) {
+		throw_value_error("Asteroid index out of range");
+	}
+}
+
+/// Returns the keplerian elements (a,e,i,Om,om,M) of the i-th asteroid at its reference epoch (SI units)
+array6D asteroid_catalogue::get_elements(const std::vector<double>::size_type &i) const
+{
+	check_index(i);
+	array6D elem = {{m_a[i], m_e[i], m_i[i], m_Om[i], m_om[i], m_M[i]}};
+	return elem;
+}
+
+/// Returns the reference epoch of the elements of the i-th asteroid
+epoch asteroid_catalogue::get_ref_epoch(const std::vector<double>::size_type &i) const
+{
+	check_index(i);
+	return epoch(m_epoch[i]);
+}
+
+/// Returns the group of the i-th asteroid as defined in the GTOC2 data file (0 in the GTOC5 catalogue)
+int asteroid_catalogue::get_group(const std::vector<double>::size_type &i) const
+{
+	check_index(i);
+	return (m_source == GTOC2) ? static_cast<int>(gtoc2_asteroids_data[i][8]) : 0;
+}
+
+/// Returns the name of the i-th asteroid, as given by the corresponding planet
+std::string asteroid_catalogue::get_name(const std::vector<double>::size_type &i) const
+{
+	check_index(i);
+	if (m_source == GTOC2) {
+		return boost::lexical_cast<std::string>(gtoc2_asteroids_data[i][0]);
+	}
+	return std::string("GTOC5 asteroid row: ") + boost::lexical_cast<std::string>(i + 1);
+}
+
+/// Builds the i-th asteroid
+/**
+ * @return a kep_toolbox::asteroid_gtoc2 or a kep_toolbox::asteroid_gtoc5
+ */
+planet_ptr asteroid_catalogue::get_planet(const std::vector<double>::size_type &i) const
+{
+	check_index(i);
+	if (m_source == GTOC2) {
+		return planet_ptr(new asteroid_gtoc2(static_cast<int>(i)));
+	}
+	return planet_ptr(new asteroid_gtoc5(static_cast<int>(i + 1)));
+}
+
+/// Computes the ephemerides of the i-th asteroid
+/**
+ * \param[in] i row of the asteroid
+ * \param[in] when epoch in which ephemerides are required
+ * \param[out] r asteroid position at epoch (SI units)
+ * \param[out] v asteroid velocity at epoch (SI units)
+ */
+void asteroid_catalogue::get_eph(const std::vector<double>::size_type &i, const epoch &when, array3D &r, array3D &v) const
+{
+	check_index(i);
+	eph_row(i,when.mjd2000(),r,v);
+}
+
+/// Computes the ephemerides of the whole catalogue
+/**
+ * \param[in] when epoch in which ephemerides are required
+ * \param[out] r positions of all asteroids at epoch (SI units)
+ * \param[out] v velocities of all asteroids at epoch (SI units)
+ */
+void asteroid_catalogue::get_eph(const epoch &when, std::vector<array3D> &r, std::vector<array3D> &v) const
+{
+	const std::vector<double>::size_type n = size();
+	r.resize(n);
+	v.resize(n);
+	const double mjd2000 = when.mjd2000();
+	for (std::vector<double>::size_type i = 0; i < n; ++i) {
+		eph_row(i,mjd2000,r[i],v[i]);
+	}
+}
+
+// Same computations (and operations order) of planet::eph_impl()
+void asteroid_catalogue::eph_row(const std::vector<double>::size_type &i, const double &mjd2000, array3D &r, array3D &v) const
+{
+	const double dt = (mjd2000 - m_epoch[i]) * ASTRO_DAY2SEC;
+	array6D elem = {{m_a[i], m_e[i], m_i[i], m_Om[i], m_om[i], m2e(m_M[i] + m_n[i] * dt, m_e[i])}};
+	par2ic(elem, ASTRO_MU_SUN, r, v);
+}
+
+/// Constructor
+/**
+ * \param[in] cat catalogue of the asteroid
+ * \param[in] i row of the asteroid in the catalogue
+ *
+ * \throws value_error if i is out of range
+ */
+asteroid_ref::asteroid_ref(const asteroid_catalogue &cat, const std::vector<double>::size_type &i):m_cat(&cat),m_row(i)
+{
+	if (i >= cat.size()) {
+		throw_value_error("Asteroid index out of range");
+	}
+}
+
+} //namespaces
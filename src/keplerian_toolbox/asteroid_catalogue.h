@@ -0,0 +1,125 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2009 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef KEPLERIAN_TOOLBOX_ASTEROID_CATALOGUE_H
+#define KEPLERIAN_TOOLBOX_ASTEROID_CATALOGUE_H
+
+#include <string>
+#include <vector>
+
+#include "planet.h"
+#include "astro_constants.h"
+#include "epoch.h"
+#include "config.h"
+#include "serialization.h"
+
+namespace kep_toolbox {
+
+/// GTOC asteroids catalogue
+/**
+ * This class holds the asteroids of the Global Trajectory Optimization Competitions 2 and 5 in a compact structure
+ * of arrays: the keplerian elements (SI units, radians), their reference epochs and mean motions are converted
+ * once from the data tables compiled in the library, and shared by all users. The two catalogues are built at their
+ * first access by gtoc2() and gtoc5() (only once, also when several threads access them concurrently) and are
+ * immutable afterwards. Identifiers and groups are read directly from the data tables.
+ *
+ * The rows are 0-based: row i of gtoc2() is kep_toolbox::asteroid_gtoc2(i), row i of gtoc5() is
+ * kep_toolbox::asteroid_gtoc5(i + 1). The ephemerides computed by the catalogue are the same of the corresponding
+ * planets, but do not require to construct them (see also kep_toolbox::asteroid_ref).
+ *
+ * @author Dario Izzo (dario.izzo _AT_ googlemail.com)
+ */
+class __KEP_TOOL_VISIBLE asteroid_catalogue
+{
+	friend class asteroid_ref;
+public:
+	static const asteroid_catalogue &gtoc2();
+	static const asteroid_catalogue &gtoc5();
+	/// Returns the number of asteroids in the catalogue
+	std::vector<double>::size_type size() const {return m_a.size();}
+	array6D get_elements(const std::vector<double>::size_type &) const;
+	epoch get_ref_epoch(const std::vector<double>::size_type &) const;
+	int get_group(const std::vector<double>::size_type &) const;
+	std::string get_name(const std::vector<double>::size_type &) const;
+	planet_ptr get_planet(const std::vector<double>::size_type &) const;
+	void get_eph(const std::vector<double>::size_type &, const epoch &, array3D &, array3D &) const;
+	void get_eph(const epoch &, std::vector<array3D> &, std::vector<array3D> &) const;
+private:
+	enum source_type {GTOC2, GTOC5};
+	explicit asteroid_catalogue(const source_type &);
+	// Non copyable: the catalogues are only accessed by reference
+	asteroid_catalogue(const asteroid_catalogue &);
+	asteroid_catalogue &operator=(const asteroid_catalogue &);
+	static void build(const source_type &, const asteroid_catalogue **);
+	void eph_row(const std::vector<double>::size_type &, const double &, array3D &, array3D &) const;
+	void check_index(const std::vector<double>::size_type &) const;
+
+	source_type m_source;
+	// Keplerian elements (SI units, radians), reference epochs (MJD2000) and mean motions (rad/s)
+	std::vector<double> m_a, m_e, m_i, m_Om, m_om, m_M, m_epoch, m_n;
+};
+
+/// Lightweight reference to an asteroid of a catalogue
+/**
+ * This class only stores a pointer to the catalogue and a row, and computes the ephemerides from the catalogue data.
+ * It is meant for the cases where many asteroids are needed at once and constructing a kep_toolbox::planet for each of
+ * them (with its name and cache) would be wasteful. The catalogue must outlive the reference, which is always the case
+ * for asteroid_catalogue::gtoc2() and asteroid_catalogue::gtoc5(). Only the catalogue and the row are serialized.
+ */
+class __KEP_TOOL_VISIBLE asteroid_ref
+{
+public:
+	asteroid_ref(const asteroid_catalogue &, const std::vector<double>::size_type &);
+	/// Returns the catalogue of the asteroid
+	const asteroid_catalogue &get_catalogue() const {return *m_cat;}
+	/// Returns the row of the asteroid in its catalogue
+	std::vector<double>::size_type get_row() const {return m_row;}
+	/// Computes the asteroid position and velocity at epoch when (SI units)
+	void get_eph(const epoch &when, array3D &r, array3D &v) const {m_cat->get_eph(m_row,when,r,v);}
+	/// Returns the keplerian elements (a,e,i,Om,om,M) of the asteroid at its reference epoch (SI units)
+	array6D get_elements() const {return m_cat->get_elements(m_row);}
+	/// Returns the reference epoch of the asteroid elements
+	epoch get_ref_epoch() const {return m_cat->get_ref_epoch(m_row);}
+	/// Builds the corresponding planet
+	planet_ptr get_planet() const {return m_cat->get_planet(m_row);}
+private:
+	friend class boost::serialization::access;
+	template <class Archive>
+	void serialize(Archive &ar, const unsigned int)
+	{
+		int source = m_cat->m_source;
+		ar & source;
+		ar & m_row;
+		if (Archive::is_loading::value) {
+			m_cat = (source == asteroid_catalogue::GTOC2) ? &asteroid_catalogue::gtoc2() : &asteroid_catalogue::gtoc5();
+		}
+	}
+	const asteroid_catalogue *m_cat;
+	std::vector<double>::size_type m_row;
+};
+
+} //namespaces
+
+#endif // KEPLERIAN_TOOLBOX_ASTEROID_CATALOGUE_H
@@ -23,10 +23,12 @@
  *****************************************************************************/
 
 #include "asteroid_gtoc2.h"
+#include "asteroid_catalogue.h"
 #include "exceptions.h"
 #include "astro_constants.h"
 
-double gtoc2_asteroids_data[911][9] = {
+// Read only, converted once in asteroid_catalogue::gtoc2()
+extern const double gtoc2_asteroids_data[911][9] = {
 {2011542,3.9501468,0.2391642,6.87574,16.88982,48.9603,229.49648,54000,1},
 {2001038,3.9619932,0.227483,9.22988,58.20488,307.19412,201.38868,54000,1},
 {2000624,5.2272807,0.023528317,18.193628,342.80533,185.13006,151.0004,54000,1},
@@ -948,13 +950,13 @@ asteroid_gtoc2::asteroid_gtoc2(const int & astid)
 	if (astid < 0  || astid >910) {
 		throw_value_error("Wrong asteroid id ... check your code");
 	}
-	array6D elem = {{gtoc2_asteroids_data[astid][1] * ASTRO_AU, gtoc2_asteroids_data[astid][2], gtoc2_asteroids_data[astid][3] * ASTRO_DEG2RAD, gtoc2_asteroids_data[astid][4] * ASTRO_DEG2RAD, gtoc2_asteroids_data[astid][5] * ASTRO_DEG2RAD, gtoc2_asteroids_data[astid][6] * ASTRO_DEG2RAD}};
-	build_planet(epoch(gtoc2_asteroids_data[astid][7],epoch::MJD), elem, ASTRO_MU_SUN,
+	const asteroid_catalogue &cat = asteroid_catalogue::gtoc2();
+	build_planet(cat.get_ref_epoch(astid), cat.get_elements(astid), ASTRO_MU_SUN,
 		0, // the body gravitational parameter, undefined
 		0, // the body radius, undefined
 		0, // the body safe radius, undefined
-		boost::lexical_cast<std::string>(gtoc2_asteroids_data[astid][0]));
-	m_group = gtoc2_asteroids_data[astid][8];
+		cat.get_name(astid));
+	m_group = cat.get_group(astid);
 }
 
 int asteroid_gtoc2::get_group() const {
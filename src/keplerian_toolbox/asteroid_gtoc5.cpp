@@ -23,10 +23,12 @@
  *****************************************************************************/
 
 #include "asteroid_gtoc5.h"
+#include "asteroid_catalogue.h"
 #include "exceptions.h"
 #include "astro_constants.h"
 
-double gtoc5_asteroids_data[7076][7] = {
+// Read only, converted once in asteroid_catalogue::gtoc5()
+extern const double gtoc5_asteroids_data[7076][7] = {
 {55400,2.6932634,0.3160515,6.27657,321.51547,31.06329,350.70647},
 {55400,1.45815287,0.222828423,10.8289895,304.3704776,178.757943,55.6339111},
 {55400,2.62733293,0.55281282,11.5612345,184.0605239,155.8052301,30.3857143},
@@ -7108,16 +7110,16 @@ namespace kep_toolbox{
 
 asteroid_gtoc5::asteroid_gtoc5(const int &astid_)
 {
-	int astid = astid_ - 1;
 	if (astid_ < 1  || astid_ > 7076) {
 		throw_value_error("Wrong asteroid id ... check your code");
 	}
-	array6D elem = {{gtoc5_asteroids_data[astid][1] * ASTRO_AU, gtoc5_asteroids_data[astid][2], gtoc5_asteroids_data[astid][3] * ASTRO_DEG2RAD, gtoc5_asteroids_data[astid][4] * ASTRO_DEG2RAD, gtoc5_asteroids_data[astid][5] * ASTRO_DEG2RAD, gtoc5_asteroids_data[astid][6] * ASTRO_DEG2RAD}};
-	build_planet(epoch(gtoc5_asteroids_data[astid][0],epoch::MJD), elem, ASTRO_MU_SUN,
+	const asteroid_catalogue &cat = asteroid_catalogue::gtoc5();
+	const std::vector<double>::size_type astid = astid_ - 1;
+	build_planet(cat.get_ref_epoch(astid), cat.get_elements(astid), ASTRO_MU_SUN,
 		0, // the body gravitational parameter, undefined
 		0, // the body radius, undefined
 		0, // the body safe radius, undefined
-		std::string("GTOC5 asteroid row: ") + boost::lexical_cast<std::string>(astid_));
+		cat.get_name(astid));
 }
 
 planet_ptr asteroid_gtoc5::clone() const
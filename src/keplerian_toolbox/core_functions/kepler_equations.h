@@ -46,6 +46,15 @@ namespace kep_toolbox {
         return ( (1 + sigma0 / sqrta * sin(DE) - (1 - R / a) * cos(DE)) );
     }
 
+    //Equation and derivatives at once, for the Halley solver
+    inline void kepDE_dd(const double& DE, const double& DM, const double& sigma0, const double& sqrta, const double& a, const double& R,
+        double &f, double &df, double &ddf){
+        const double s = sin(DE), c = cos(DE), p = sigma0 / sqrta, q = 1 - R / a;
+        f = -DM + DE + p * (1 - c) - q * s;
+        df = 1 + p * s - q * c;
+        ddf = p * c + q * s;
+    }
+
     //With the hyperbolic anomaly difference (DH)
     inline double kepDH(const double& DH, const double& DN, const double& sigma0, const double& sqrta, const double& a, const double& R){
         return ( -DN -DH + sigma0/sqrta * (cosh(DH) - 1) + (1 - R / a) * sinh(DH) );
@@ -54,6 +63,15 @@ namespace kep_toolbox {
     inline double d_kepDH(const double& DH, const double& sigma0, const double& sqrta, const double& a, const double& R){
         return ( -1 + sigma0 / sqrta * sinh(DH) + (1 - R / a) * cosh(DH) );
     }
+
+    //Equation and derivatives at once, for the Halley solver
+    inline void kepDH_dd(const double& DH, const double& DN, const double& sigma0, const double& sqrta, const double& a, const double& R,
+        double &f, double &df, double &ddf){
+        const double s = sinh(DH), c = cosh(DH), p = sigma0 / sqrta, q = 1 - R / a;
+        f = -DN - DH + p * (c - 1) + q * s;
+        df = -1 + p * s + q * c;
+        ddf = p * c + q * s;
+    }
     //With the universal anomaly difference (DS)
     inline double kepDS(const double& DS, const double& DT, const double& r0, const double& vr0, const double& alpha, const double& mu){
         double S = stumpff_s(alpha*DS*DS);
@@ -67,5 +85,14 @@ namespace kep_toolbox {
         double retval = r0*vr0/sqrt(mu)*DS * (1-alpha*DS*DS*S) + (1-alpha*r0)*DS*DS*C + r0;
         return ( retval );
     }
+
+    //Equation and derivatives at once, for the Halley solver
+    inline void kepDS_dd(const double& DS, const double& DT, const double& r0, const double& vr0, const double& alpha, const double& mu,
+        double &f, double &df, double &ddf){
+        const double z = alpha*DS*DS, S = stumpff_s(z), C = stumpff_c(z), sigma0 = r0*vr0/sqrt(mu);
+        f = -sqrt(mu)*DT + sigma0*DS*DS*C + (1-alpha*r0)*DS*DS*DS*S + r0*DS;
+        df = sigma0*DS * (1-z*S) + (1-alpha*r0)*DS*DS*C + r0;
+        ddf = sigma0 * (1-z*C) + (1-alpha*r0)*DS * (1-z*S);
+    }
 }
 #endif // KEPLER_EQUATIONS_H
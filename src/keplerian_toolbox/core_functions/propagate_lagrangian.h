@@ -26,56 +26,51 @@
 #ifndef PROPAGATE_LAGRANGIAN_H
 #define PROPAGATE_LAGRANGIAN_H
 
+#include<algorithm>
 #include<boost/bind.hpp>
-#include<boost/math/tools/roots.hpp>
+#include<cfloat>
+#include<cmath>
+#include<vector>
 
 #include"../astro_constants.h"
-#include"../numerics/newton_raphson.h"
+#include"../numerics/halley.h"
 #include"kepler_equations.h"
 
 
 
 namespace kep_toolbox {
 
-/// Lagrangian propagation
+/// Lagrange coefficients of a keplerian propagation
 /**
- * This template function propagates an initial state for a time t assuming a central body and a keplerian
- * motion. Lagrange coefficients are used as basic numerical technique. All units systems can be used, as long
- * as the input parameters are all expressed in the same system.
+ * Solves Kepler's equation in the eccentric (hyperbolic) anomaly difference and computes the Lagrange coefficients
+ * F, G, Ft, Gt of a keplerian propagation for a time t, starting from a position of module R.
  *
- * \param[in,out] r0 initial position vector. On output contains the propagated position. (r0[1],r0[2],r0[3] need to be preallocated, suggested template type is boost::array<double,3))
- * \param[in,out] v0 initial velocity vector. On output contains the propagated velocity. (v0[1],v0[2],v0[3] need to be preallocated, suggested template type is boost::array<double,3))
+ * \param[in] R module of the initial position
+ * \param[in] sigma0 scalar product of initial position and velocity divided by sqrt(mu)
+ * \param[in] a semi-major axis
  * \param[in] t propagation time (can be negative)
  * \param[in] mu central body gravitational parameter
+ * \param[out] F,G,Ft,Gt Lagrange coefficients
+ * \param[out] DX solution of Kepler's equation (eccentric or hyperbolic anomaly difference)
  *
- * NOTE: The solver used for the kepler equation is a derivative free solver from the boost libraries.
- *
- * @author Dario Izzo (dario.izzo _AT_ googlemail.com)
+ * NOTE: Kepler's equation is solved by a safeguarded Halley method, started from one fixed point iteration
+ * (elliptical case) or from an asymptotic guess (hyperbolic case) within a bracket known to contain the root.
  */
-template<class T>
-void propagate_lagrangian(T& r0, T& v0, const double &t, const double &mu)
+inline void lagrangian_coefficients(const double &R, const double &sigma0, const double &a, const double &t, const double &mu,
+	double &F, double &G, double &Ft, double &Gt, double &DX)
 {
-    double R = sqrt(r0[0]*r0[0] + r0[1]*r0[1] + r0[2]*r0[2]);
-    double V = sqrt(v0[0]*v0[0] + v0[1]*v0[1] + v0[2]*v0[2]);
-    double energy = (V*V/2 - mu/R);
-    double a = - mu / 2.0 / energy;
+    const double tol = 4 * DBL_EPSILON;
     double sqrta;
-    double F,G,Ft,Gt;
-
-    double sigma0 = (r0[0]*v0[0] + r0[1]*v0[1] + r0[2]*v0[2]) / sqrt(mu);
 
     if (a > 0){	//Solve Kepler's equation, elliptical case
         sqrta = sqrt(a);
-        double DM = sqrt(mu / pow(a,3)) * t;
-        double DE = DM;
+        double DM = sqrt(mu / (a * a * a)) * t;
+        // The equation reads DE - e sin(E0 + DE) = DM - e sin(E0), so the root is within 2e from DM
+        double ecc = sqrt((1 - R / a) * (1 - R / a) + sigma0 * sigma0 / a);
+        double DE = DM - kepDE(DM,DM,sigma0,sqrta,a,R);
 
         //Solve Kepler Equation for ellipses in DE (eccentric anomaly difference)
-        //newton_raphson(DE,boost::bind(kepDE,_1,DM,sigma0,sqrta,a,R),boost::bind(d_kepDE,_1,sigma0,sqrta,a,R),100,ASTRO_TOLERANCE);
-        std::pair<double, double> result;
-        boost::uintmax_t iter = ASTRO_MAX_ITER;
-        boost::math::tools::eps_tolerance<double> tol(64);
-        result = boost::math::tools::bracket_and_solve_root(boost::bind(kepDE,_1,DM,sigma0,sqrta,a,R),DE,2.0,true,tol,iter);
-        DE = (result.first + result.second) / 2;
+        halley(DE,boost::bind(kepDE_dd,_1,DM,sigma0,sqrta,a,R,_2,_3,_4),DM - 2 * ecc,DM + 2 * ecc,ASTRO_MAX_ITER,tol);
         double r = a + (R - a) * cos(DE) + sigma0 * sqrta * sin(DE);
 
         //Lagrange coefficients
@@ -83,20 +78,27 @@ void propagate_lagrangian(T& r0, T& v0, const double &t, const double &mu)
         G  = a * sigma0 / sqrt(mu) * (1 - cos(DE)) + R * sqrt(a / mu) * sin(DE);
         Ft = -sqrt(mu * a) / (r * R) * sin(DE);
         Gt = 1 - a / r * (1 - cos(DE));
+        DX = DE;
     }
     else{	//Solve Kepler's equation, hyperbolic case
         sqrta = sqrt(-a);
-        double DN = sqrt(-mu / pow(a,3)) * t;
-        double DH;
-        t > 0 ? DH = 1 : DH = -1; // TODO: find a better initial guess. I tried with 0 and D (both have numercial problems and result in exceptions)
+        double DN = sqrt(-mu / (a * a * a)) * t;
+        // The equation reads e sinh(H) - H = N with H = H0 + DH and N = DN + e sinh(H0) - H0. For N > 0 its root lies in
+        // [asinh(N/e), min(asinh(N/(e-1)), cbrt(6N/e))] (and symmetrically for N < 0)
+        double ecc = sqrt(std::max((1 - R / a) * (1 - R / a) - sigma0 * sigma0 / (-a), 1.));
+        double H0 = asinh(sigma0 / sqrta / ecc);
+        double N = DN + ecc * sinh(H0) - H0;
+        double absN = std::fabs(N), sign = (N < 0) ? -1. : 1.;
+        double lo = asinh(absN / ecc);
+        double hi = pow(6 * absN / ecc,1. / 3);
+        if (ecc > 1) {
+            hi = std::min(hi,asinh(absN / (ecc - 1)));
+        }
+        hi = std::max(hi,lo);
+        double DH = sign * log(2 * absN / ecc + 1.8) - H0;
 
         //Solve Kepler Equation for hyperbolae in DH (hyperbolic anomaly difference)
-        //newton_raphson(DH,boost::bind(kepDH,_1,DN,sigma0,sqrta,a,R),boost::bind(d_kepDH,_1,sigma0,sqrta,a,R),100,ASTRO_TOLERANCE);
-        std::pair<double, double> result;
-        boost::uintmax_t iter = ASTRO_MAX_ITER;
-        boost::math::tools::eps_tolerance<double> tol(64);
-        result = boost::math::tools::bracket_and_solve_root(boost::bind(kepDH,_1,DN,sigma0,sqrta,a,R),DH,2.0,true,tol,iter);
-        DH = (result.first + result.second) / 2;
+        halley(DH,boost::bind(kepDH_dd,_1,DN,sigma0,sqrta,a,R,_2,_3,_4),(sign > 0 ? lo : -hi) - H0,(sign > 0 ? hi : -lo) - H0,ASTRO_MAX_ITER,tol);
         double r = a + (R - a) * cosh(DH) + sigma0 * sqrta * sinh(DH);
 
         //Lagrange coefficients
@@ -104,6 +106,137 @@ void propagate_lagrangian(T& r0, T& v0, const double &t, const double &mu)
         G  = a * sigma0 / sqrt(mu) * (1 - cosh(DH)) + R * sqrt(-a / mu) * sinh(DH);
         Ft = -sqrt(-mu * a) / (r * R) * sinh(DH);
         Gt = 1 - a / r * (1 - cosh(DH));
+        DX = DH;
+    }
+}
+
+/// Lagrange coefficients of a keplerian propagation
+/**
+ * As above, without returning the anomaly difference.
+ */
+inline void lagrangian_coefficients(const double &R, const double &sigma0, const double &a, const double &t, const double &mu,
+	double &F, double &G, double &Ft, double &Gt)
+{
+    double DX;
+    lagrangian_coefficients(R,sigma0,a,t,mu,F,G,Ft,Gt,DX);
+}
+
+/// Lagrangian propagation
+/**
+ * This template function propagates an initial state for a time t assuming a central body and a keplerian
+ * motion. Lagrange coefficients are used as basic numerical technique. All units systems can be used, as long
+ * as the input parameters are all expressed in the same system.
+ *
+ * \param[in,out] r0 initial position vector. On output contains the propagated position. (r0[1],r0[2],r0[3] need to be preallocated, suggested template type is boost::array<double,3))
+ * \param[in,out] v0 initial velocity vector. On output contains the propagated velocity. (v0[1],v0[2],v0[3] need to be preallocated, suggested template type is boost::array<double,3))
+ * \param[in] t propagation time (can be negative)
+ * \param[in] mu central body gravitational parameter
+ *
+ * NOTE: The solver used for the kepler equation is a safeguarded Halley method (see lagrangian_coefficients).
+ *
+ * @author Dario Izzo (dario.izzo _AT_ googlemail.com)
+ */
+template<class T>
+void propagate_lagrangian(T& r0, T& v0, const double &t, const double &mu)
+{
+    double R = sqrt(r0[0]*r0[0] + r0[1]*r0[1] + r0[2]*r0[2]);
+    double V = sqrt(v0[0]*v0[0] + v0[1]*v0[1] + v0[2]*v0[2]);
+    double energy = (V*V/2 - mu/R);
+    double a = - mu / 2.0 / energy;
+    double F,G,Ft,Gt;
+
+    double sigma0 = (r0[0]*v0[0] + r0[1]*v0[1] + r0[2]*v0[2]) / sqrt(mu);
+
+    lagrangian_coefficients(R,sigma0,a,t,mu,F,G,Ft,Gt);
+
+    double temp[3] = {r0[0],r0[1],r0[2]};
+    for (int i=0;i<3;i++){
+        r0[i] = F * r0[i] + G * v0[i];
+        v0[i] = Ft * temp[i] + Gt * v0[i];
+    }
+}
+
+/// Lagrangian propagation with state transition matrix
+/**
+ * Propagates an initial state as propagate_lagrangian and computes, in closed form, the state transition matrix
+ * \f$ \partial (\mathbf r, \mathbf v) / \partial (\mathbf r_0, \mathbf v_0) \f$ of the propagation. The Lagrange
+ * coefficients depend on the initial state only through \f$ R = |\mathbf r_0|\f$, \f$ \sigma_0 \f$ and \f$ a \f$
+ * (directly and through the solution of Kepler's equation, which is differentiated implicitly), so that
+ * \f$ \partial \mathbf r / \partial \mathbf r_0 = F \mathbf I + \mathbf r_0 \nabla F^T + \mathbf v_0 \nabla G^T \f$ and similarly
+ * for the other blocks.
+ *
+ * \param[in,out] r0 initial position vector. On output contains the propagated position.
+ * \param[in,out] v0 initial velocity vector. On output contains the propagated velocity.
+ * \param[in] t propagation time (can be negative)
+ * \param[in] mu central body gravitational parameter
+ * \param[out] stm state transition matrix, stored row-major in stm[0], ..., stm[35] (needs to be preallocated)
+ */
+template<class T, class M>
+void propagate_lagrangian_stm(T& r0, T& v0, const double &t, const double &mu, M& stm)
+{
+    const double sqrt_mu = sqrt(mu);
+    double R = sqrt(r0[0]*r0[0] + r0[1]*r0[1] + r0[2]*r0[2]);
+    double V = sqrt(v0[0]*v0[0] + v0[1]*v0[1] + v0[2]*v0[2]);
+    double a = - mu / 2.0 / (V*V/2 - mu/R);
+    double sigma0 = (r0[0]*v0[0] + r0[1]*v0[1] + r0[2]*v0[2]) / sqrt_mu;
+    double F,G,Ft,Gt,DX;
+
+    lagrangian_coefficients(R,sigma0,a,t,mu,F,G,Ft,Gt,DX);
+
+    // Elliptical (k = 1) and hyperbolic (k = -1) cases share the same expressions, with C = cos(DX), S = sin(DX)
+    // or C = cosh(DX), S = sinh(DX), sa = sqrt(k a), so that dC/dDX = -k S and dsa/da = k / (2 sa)
+    const double k = (a > 0) ? 1. : -1.;
+    const double sa = sqrt(k * a);
+    const double C = (a > 0) ? cos(DX) : cosh(DX), S = (a > 0) ? sin(DX) : sinh(DX);
+    const double r = a + (R - a) * C + sigma0 * sa * S;
+
+    // Partial derivatives with respect to (R, sigma0, a), the anomaly difference being held fixed ...
+    double dr[3] = {C, sa * S, 1 - C + k * sigma0 * S / (2 * sa)};
+    double dF[3] = {a * (1 - C) / (R * R), 0., - (1 - C) / R};
+    double dG[3] = {sa * S / sqrt_mu, a * (1 - C) / sqrt_mu, (sigma0 * (1 - C) + k * R * S / (2 * sa)) / sqrt_mu};
+    double dN[3] = {0., 0., - k * sqrt_mu * S / (2 * sa)};
+    double dc[3] = {0., 0., 0.};
+    double da[3] = {0., 0., 1.};
+    // ... and with respect to the anomaly difference (N = - sqrt(mu) sa S is the numerator of Ft, c = 1 - C)
+    const double dr_x = - k * (R - a) * S + sigma0 * sa * C;
+    const double dF_x = - k * a * S / R;
+    const double dG_x = (k * a * sigma0 * S + R * sa * C) / sqrt_mu;
+    const double dN_x = - sqrt_mu * sa * C;
+    const double dc_x = k * S;
+
+    // Implicit differentiation of Kepler's equation g = DX - sigma0 / sa (C - 1) - (1 - R / a) S - k sqrt(mu) t / sa^3 = 0,
+    // whose derivative with respect to DX is r / a
+    const double dg[3] = {S / a, - (C - 1) / sa, k * sigma0 * (C - 1) / (2 * sa * sa * sa) - R * S / (a * a) + 3 * sqrt_mu * t / (2 * pow(sa,5))};
+    double dFt[3], dGt[3];
+    for (int p = 0; p < 3; ++p) {
+        const double dx = - dg[p] * a / r;
+        dr[p] += dr_x * dx;
+        dF[p] += dF_x * dx;
+        dG[p] += dG_x * dx;
+        dN[p] += dN_x * dx;
+        dc[p] += dc_x * dx;
+        dFt[p] = dN[p] / (r * R) - Ft * (dr[p] / r + (p == 0 ? 1. / R : 0.));
+        dGt[p] = - (da[p] * (1 - C) + a * dc[p]) / r + a * (1 - C) * dr[p] / (r * r);
+    }
+
+    // Chain rule through R, sigma0 and a (via the energy) to the initial state
+    double gr[4][3], gv[4][3];
+    const double *d[4] = {dF, dG, dFt, dGt};
+    for (int q = 0; q < 4; ++q) {
+        for (int j = 0; j < 3; ++j) {
+            gr[q][j] = d[q][0] * r0[j] / R + d[q][1] * v0[j] / sqrt_mu + d[q][2] * 2 * a * a * r0[j] / (R * R * R);
+            gv[q][j] = d[q][1] * r0[j] / sqrt_mu + d[q][2] * 2 * a * a * v0[j] / mu;
+        }
+    }
+    const double coeff[4] = {F, G, Ft, Gt};
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            const double delta = (i == j) ? 1. : 0.;
+            stm[i * 6 + j] = coeff[0] * delta + r0[i] * gr[0][j] + v0[i] * gr[1][j];
+            stm[i * 6 + j + 3] = coeff[1] * delta + r0[i] * gv[0][j] + v0[i] * gv[1][j];
+            stm[(i + 3) * 6 + j] = coeff[2] * delta + r0[i] * gr[2][j] + v0[i] * gr[3][j];
+            stm[(i + 3) * 6 + j + 3] = coeff[3] * delta + r0[i] * gv[2][j] + v0[i] * gv[3][j];
+        }
     }
 
     double temp[3] = {r0[0],r0[1],r0[2]};
@@ -112,6 +245,44 @@ void propagate_lagrangian(T& r0, T& v0, const double &t, const double &mu)
         v0[i] = Ft * temp[i] + Gt * v0[i];
     }
 }
+
+/// Batch Lagrangian propagation
+/**
+ * Propagates n = r0.size() initial states, each for its own time t[i], around the same central body. The computation is
+ * split in passes over the whole batch: the orbital invariants and the final states are computed in loops free of
+ * branches (which the compiler can vectorise), the Kepler's equations are solved one by one in between.
+ *
+ * \param[in,out] r0 initial position vectors. On output contains the propagated positions.
+ * \param[in,out] v0 initial velocity vectors. On output contains the propagated velocities.
+ * \param[in] t propagation times (can be negative)
+ * \param[in] mu central body gravitational parameter
+ */
+template<class T>
+void propagate_lagrangian_batch(std::vector<T>& r0, std::vector<T>& v0, const std::vector<double> &t, const double &mu)
+{
+    const std::size_t n = r0.size();
+    const double sqrt_mu = sqrt(mu);
+    std::vector<double> R(n), sigma0(n), a(n), F(n), G(n), Ft(n), Gt(n);
+
+    for (std::size_t k = 0; k < n; ++k) {
+        const T &r = r0[k], &v = v0[k];
+        R[k] = sqrt(r[0]*r[0] + r[1]*r[1] + r[2]*r[2]);
+        const double V = sqrt(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
+        a[k] = - mu / 2.0 / (V*V/2 - mu/R[k]);
+        sigma0[k] = (r[0]*v[0] + r[1]*v[1] + r[2]*v[2]) / sqrt_mu;
+    }
+    for (std::size_t k = 0; k < n; ++k) {
+        lagrangian_coefficients(R[k],sigma0[k],a[k],t[k],mu,F[k],G[k],Ft[k],Gt[k]);
+    }
+    for (std::size_t k = 0; k < n; ++k) {
+        T &r = r0[k], &v = v0[k];
+        for (int i=0;i<3;i++){
+            const double temp = r[i];
+            r[i] = F[k] * temp + G[k] * v[i];
+            v[i] = Ft[k] * temp + Gt[k] * v[i];
+        }
+    }
+}
 }
 
 #endif // PROPAGATE_LAGRANGIAN_H
@@ -27,10 +27,11 @@
 #define PROPAGATE_LAGRANGIAN_U_H
 
 #include<boost/bind.hpp>
-#include<boost/math/tools/roots.hpp>
+#include<cfloat>
+#include<cmath>
 
 #include"../astro_constants.h"
-#include"../numerics/newton_raphson.h"
+#include"../numerics/halley.h"
 #include"kepler_equations.h"
 #include"stumpff.h"
 
@@ -76,13 +77,22 @@ void propagate_lagrangian_u(T& r0, T& v0, const double &t, const double &mu = 1)
 
     //solve kepler's equation in universal variables
     double DS = 1;
-    alpha > 0 ? DS = sqrt(mu)*t_copy*std::abs(alpha) : DS = 1; //initial guess for the universal anomaly. For hyperbolas it is 1.... can be better?
-    //newton_raphson(DS,boost::bind(kepDS,_1,t_copy,R0,VR0,alpha,mu),boost::bind(d_kepDS,_1,R0,V0,alpha,mu),100,ASTRO_TOLERANCE);
-    std::pair<double, double> result;
-    boost::uintmax_t iter = ASTRO_MAX_ITER;
-    boost::math::tools::eps_tolerance<double> tol(64);
-    result = boost::math::tools::bracket_and_solve_root(boost::bind(kepDS,_1,t_copy,R0,VR0,alpha,mu),DS,2.0,true,tol,iter);
-    DS = (result.first + result.second) / 2;
+    if (alpha > 0) {
+        DS = sqrt(mu)*t_copy*alpha; //initial guess for the universal anomaly, elliptical case
+    } else if (alpha < 0) {
+        //initial guess for the universal anomaly, hyperbolic case (Vallado)
+        double arg = -2*mu*alpha*t_copy / (R0*VR0 + sqrt(-mu/alpha)*(1 - R0*alpha));
+        if (arg > 1) {
+            DS = sqrt(-1/alpha)*log(arg);
+        }
+    }
+    //the universal Kepler's equation is monotonically increasing in DS and negative in zero: find a bracket by doubling
+    double lo = 0, hi = std::max(DS,1.);
+    for (int i = 0; i < ASTRO_MAX_ITER && kepDS(hi,t_copy,R0,VR0,alpha,mu) < 0; ++i) {
+        lo = hi;
+        hi *= 2;
+    }
+    halley(DS,boost::bind(kepDS_dd,_1,t_copy,R0,VR0,alpha,mu,_2,_3,_4),lo,hi,ASTRO_MAX_ITER,4 * DBL_EPSILON);
 
     //evaluate the lagrangian coefficients F and G
     double S = stumpff_s(alpha*DS*DS);
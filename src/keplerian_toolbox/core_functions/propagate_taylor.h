@@ -29,6 +29,7 @@
 #include<algorithm>
 #include<cmath>
 #include<boost/array.hpp>
+#include<vector>
 
 #include"../exceptions.h"
 
@@ -147,10 +148,112 @@ double propagate_taylor_step(T& r0, T& v0, double &m0, const double &h, const in
     return step;
 }
 
+/// Taylor integrator of constant thrust trajectories
+/**
+ * This class propagates states along keplerian motions perturbed by an inertially constant thrust, exactly as
+ * propagate_taylor, but holds the workspace storing the Taylor coefficients. The workspace is sized to the
+ * polynomial order required by the tolerances and reused by all subsequent propagations, which do not allocate
+ * memory as long as the tolerances are not tightened.
+ *
+ * An integrator must not be shared among threads: each thread should use its own instance.
+ *
+ * @author Dario Izzo (dario.izzo _AT_ googlemail.com)
+ */
+class taylor_integrator
+{
+public:
+    /// Constructor
+    /**
+     * \param[in] log10tolerance logarithm of the desired absolute tolerance
+     * \param[in] log10rtolerance logarithm of the desired relative tolerance
+     * \param[in] max_iter maximum number of iteration allowed
+     * \param[in] max_order maximum order for the polynomial expansion
+     */
+    taylor_integrator(const int &log10tolerance=-10, const int &log10rtolerance=-10, const int &max_iter = 10000, const int &max_order = 3000):
+        m_eps_a(pow(10.,log10tolerance)),m_eps_r(pow(10.,log10rtolerance)),m_max_iter(max_iter),m_max_order(max_order) {}
+
+    /// Sets the tolerances
+    /**
+     * \param[in] log10tolerance logarithm of the desired absolute tolerance
+     * \param[in] log10rtolerance logarithm of the desired relative tolerance
+     */
+    void set_tolerances(const int &log10tolerance, const int &log10rtolerance) {
+        m_eps_a = pow(10.,log10tolerance);
+        m_eps_r = pow(10.,log10rtolerance);
+    }
+
+    /// Propagates a state
+    /**
+     * See propagate_taylor for the meaning of the parameters.
+     *
+     * \throw value_error if max_iter is hit.....
+     * \throw value_error if max_order is exceeded.....
+     */
+    template<class T>
+    void propagate(T& r0, T& v0, double &m0, const T& u, const double &t0, const double &mu = 1, const double &veff = 1) {
+        double step = t0;
+        double eps_m,xm;
+        int j;
+        for (j=0; j< m_max_iter; ++j) {
+            //We follow the method described by Jorba in "A software package ...."
+            //1 - We determine eps_m from Eq. (7)
+            xm = std::max(std::abs(r0[0]),std::abs(r0[1]));
+            xm = std::max(xm,std::abs(r0[2]));
+            xm = std::max(xm,std::abs(v0[0]));
+            xm = std::max(xm,std::abs(v0[1]));
+            xm = std::max(xm,std::abs(v0[2]));
+            xm = std::max(xm,std::abs(m0));
+
+            //2 - We evaluate the polynomial order
+            (m_eps_r*xm < m_eps_a) ? eps_m = m_eps_a : eps_m = m_eps_r;
+            int order = (int) ( ceil(-0.5*log(eps_m) + 1) );
+            if (order > m_max_order) throw_value_error("Polynomial order is too high.....");
+
+            //3 - We grow the workspace if necessary and reset the coefficients used by the step
+            if (m_x.size() < static_cast<std::vector< boost::array<double,7> >::size_type>(order+1)) {
+                m_x.resize(order+1);
+                m_u.resize(order);
+            }
+            for (int k=0; k<=order; ++k) m_x[k].assign(0);
+            for (int k=0; k<order; ++k) m_u[k].assign(0);
+            double h = propagate_taylor_step(r0,v0,m0,step,order,u,mu,veff,xm,m_eps_a,m_eps_r,m_x,m_u);
+            if (std::abs(h)>=std::abs(step)) break; else {
+                step = step - h;
+            }
+        }
+        if (j>m_max_iter-1) throw_value_error("Maximum number of iteration reached");
+    }
+
+    /// Propagates many independent states
+    /**
+     * Propagates the i-th state (r0[i], v0[i], m0[i]) with thrust u[i] for the time t0[i], reusing the same workspace.
+     *
+     * \throw value_error if the sizes of the inputs differ
+     */
+    template<class T>
+    void propagate_batch(std::vector<T>& r0, std::vector<T>& v0, std::vector<double> &m0, const std::vector<T>& u, const std::vector<double> &t0, const double &mu = 1, const double &veff = 1) {
+        if (v0.size() != r0.size() || m0.size() != r0.size() || u.size() != r0.size() || t0.size() != r0.size()) {
+            throw_value_error("Inconsistent sizes in the Taylor propagations batch");
+        }
+        for (typename std::vector<T>::size_type i=0; i<r0.size(); ++i) {
+            propagate(r0[i],v0[i],m0[i],u[i],t0[i],mu,veff);
+        }
+    }
+
+private:
+    double m_eps_a;
+    double m_eps_r;
+    int m_max_iter;
+    int m_max_order;
+    std::vector< boost::array<double,7> > m_x;   // x[order][var]
+    std::vector< boost::array<double,21> > m_u;   // u[order][var]
+};
+
 /// Taylor series propagation of a constant thrust trajectory
 /**
  * This template function propagates an initial state for a time t assuming a central body and a keplerian
- * motion perturbed by an inertially constant thrust u
+ * motion perturbed by an inertially constant thrust u. When many propagations are needed, a taylor_integrator
+ * avoids allocating the workspace at each call.
  *
  * \param[in,out] r0 initial position vector. On output contains the propagated position. (r0[1],r0[2],r0[3] need to be preallocated, suggested template type is boost::array<double,3))
  * \param[in,out] v0 initial velocity vector. On output contains the propagated velocity. (v0[1],v0[2],v0[3] need to be preallocated, suggested template type is boost::array<double,3))
@@ -171,44 +274,7 @@ double propagate_taylor_step(T& r0, T& v0, double &m0, const double &h, const in
  */
 template<class T>
 void propagate_taylor(T& r0, T& v0, double &m0, const T& u, const double &t0, const double &mu = 1, const double &veff = 1, const int &log10tolerance=-10, const int &log10rtolerance=-10, const int &max_iter = 10000, const int &max_order = 3000){
-
-    boost::array<double,7> dumb;
-    boost::array<double,21> dumb2;
-    for (int i=0;i<7;++i) dumb[i]=0;
-    for (int i=0;i<21;++i) dumb2[i]=0;
-
-    std::vector< boost::array<double,7> > _x;   // x[order][var]
-    std::vector< boost::array<double,21> > _u;   // u[order][var]
-
-    double step = t0;
-    double eps_a = pow(10.,log10tolerance);
-    double eps_r = pow(10.,log10rtolerance);
-    double eps_m,xm;
-    int j;
-    for (j=0; j< max_iter; ++j) {
-        //We follow the method described by Jorba in "A software package ...."
-        //1 - We determine eps_m from Eq. (7)
-        xm = std::max(std::abs(r0[0]),std::abs(r0[1]));
-        xm = std::max(xm,std::abs(r0[2]));
-        xm = std::max(xm,std::abs(v0[0]));
-        xm = std::max(xm,std::abs(v0[1]));
-        xm = std::max(xm,std::abs(v0[2]));
-        xm = std::max(xm,std::abs(m0));
-
-        //2 - We evaluate the polynomial order
-        (eps_r*xm < eps_a) ? eps_m = eps_a : eps_m = eps_r;
-        int order = (int) ( ceil(-0.5*log(eps_m) + 1) );
-        if (order > max_order) throw_value_error("Polynomial order is too high.....");
-
-        //3 - We allocate or deallocate memory if necessary
-        _x.assign(order+1,dumb);
-        _u.assign(order,dumb2);
-        double h = propagate_taylor_step(r0,v0,m0,step,order,u,mu,veff,xm, eps_a, eps_r,_x,_u);
-        if (std::abs(h)>=std::abs(step)) break; else {
-            step = step - h;
-        }
-    }
-    if (j>max_iter-1) throw_value_error("Maximum number of iteration reached");
+    taylor_integrator(log10tolerance,log10rtolerance,max_iter,max_order).propagate(r0,v0,m0,u,t0,mu,veff);
 }
 
 } //Namespace
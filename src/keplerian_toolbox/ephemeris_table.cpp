@@ -0,0 +1,92 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2009 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <algorithm>
+#include <cmath>
+
+#include "ephemeris_table.h"
+#include "planet.h"
+#include "core_functions/array3D_operations.h"
+#include "exceptions.h"
+
+namespace kep_toolbox {
+
+/// Constructor
+/** Builds the ephemeris table of a planet.
+ *
+ * \param[in] body planet whose ephemerides are tabulated
+ * \param[in] start first epoch of the table window
+ * \param[in] end last epoch of the table window
+ * \param[in] tol maximum relative error allowed on both position and velocity
+ *
+ * \throws value_error if the window is empty, if tol is not positive or if tol cannot be reached with at most max_nodes nodes
+ */
+ephemeris_table::ephemeris_table(const planet &body, const epoch &start, const epoch &end, const double &tol):m_start(start.mjd2000()),m_max_error(0)
+{
+	const double window = end.mjd2000() - start.mjd2000();
+	if (!(window > 0)) {
+		throw_value_error("The ephemeris table window must have a positive length");
+	}
+	if (!(tol > 0)) {
+		throw_value_error("The ephemeris table tolerance must be positive");
+	}
+	// The exact ephemerides, from a copy of the planet without its table (if any)
+	const planet_ptr exact = body.clone();
+	exact->clear_ephemeris_table();
+	// Start from 64 nodes per orbital period (and at least four nodes) and double until the tolerance is met
+	const double n_start = std::max(3., std::ceil(window / (body.compute_period() * ASTRO_SEC2DAY / 64)));
+	if (!(n_start < max_nodes)) {
+		throw_value_error("The ephemeris table window is too long: the table would exceed the maximum number of nodes");
+	}
+	std::vector<double>::size_type n_int = static_cast<std::vector<double>::size_type>(n_start);
+	array3D r, v, ri, vi, dr, dv;
+	for (; n_int + 1 <= max_nodes; n_int *= 2) {
+		m_n = n_int + 1;
+		m_step = window / n_int;
+		m_data.resize(6 * m_n);
+		for (std::vector<double>::size_type k = 0; k < m_n; ++k) {
+			exact->get_eph(epoch(m_start + k * m_step),r,v);
+			std::copy(r.begin(),r.end(),m_data.begin() + 6 * k);
+			std::copy(v.begin(),v.end(),m_data.begin() + 6 * k + 3);
+		}
+		m_max_error = 0;
+		for (std::vector<double>::size_type k = 0; k < n_int; ++k) {
+			for (int q = 1; q < 8; ++q) {
+				const double mjd = m_start + (k + q / 8.) * m_step;
+				exact->get_eph(epoch(mjd),r,v);
+				get_eph(mjd,ri,vi);
+				diff(dr,ri,r);
+				diff(dv,vi,v);
+				m_max_error = std::max(m_max_error,std::max(norm(dr) / norm(r),norm(dv) / norm(v)));
+			}
+		}
+		if (m_max_error <= tol) {
+			return;
+		}
+	}
+	throw_value_error("The ephemeris table tolerance could not be reached within the maximum number of nodes");
+}
+
+} //namespaces
@@ -0,0 +1,128 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2009 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef KEPLERIAN_TOOLBOX_EPHEMERIS_TABLE_H
+#define KEPLERIAN_TOOLBOX_EPHEMERIS_TABLE_H
+
+#include <algorithm>
+#include <vector>
+
+// Serialization code
+#include "serialization.h"
+// Serialization code (END)
+#include "astro_constants.h"
+#include "epoch.h"
+#include "config.h"
+
+namespace kep_toolbox {
+
+// Forward declaration.
+class planet;
+
+/// Ephemeris interpolation table
+/**
+ * This class tabulates the ephemerides of a planet over an epoch window on equally spaced nodes and
+ * interpolates position and velocity with piecewise cubic Lagrange polynomials over four consecutive nodes.
+ * A lookup costs a few multiply-adds, independently of the planet type. Position and velocity are interpolated
+ * independently, as the velocity of some ephemerides models (e.g. planet_ss) is not exactly the derivative of
+ * the position.
+ *
+ * The node spacing is halved until the interpolation error is below the requested relative tolerance. The error
+ * is measured at seven equally spaced points inside every interval, so it is an estimate: between these points it can
+ * be slightly larger. Tables are limited to max_nodes nodes.
+ *
+ * Tables are immutable once built and are shared (via boost::shared_ptr) among copies of the planet, so
+ * that lookups are thread safe.
+ *
+ * @author Dario Izzo (dario.izzo _AT_ googlemail.com)
+ */
+class __KEP_TOOL_VISIBLE ephemeris_table
+{
+public:
+	ephemeris_table(const planet &body, const epoch &start, const epoch &end, const double &tol = 1e-9);
+	/// Maximum number of nodes of a table (48 bytes each)
+	static const std::vector<double>::size_type max_nodes = 1u << 20;
+	/// Interpolates the ephemerides
+	/**
+	 * \param[in] mjd2000 epoch in which ephemerides are required (MJD2000)
+	 * \param[out] r position at epoch (SI units)
+	 * \param[out] v velocity at epoch (SI units)
+	 *
+	 * @return false if the epoch is outside the table window (r and v are then left untouched)
+	 */
+	bool get_eph(const double &mjd2000, array3D &r, array3D &v) const {
+		const double s = (mjd2000 - m_start) / m_step;
+		if (!(s >= 0 && s <= m_n - 1)) {
+			return false;
+		}
+		// The four nodes stencil is centred on the interval containing the epoch, except at the window ends
+		std::vector<double>::size_type k = static_cast<std::vector<double>::size_type>(s);
+		k = (k == 0) ? 0 : std::min(k - 1, m_n - 4);
+		const double t = s - k, t1 = t - 1, t2 = t - 2, t3 = t - 3;
+		const double w0 = -t1 * t2 * t3 / 6, w1 = t * t2 * t3 / 2, w2 = -t * t1 * t3 / 2, w3 = t * t1 * t2 / 6;
+		// Node layout: r, v
+		const double *n0 = &m_data[6 * k], *n1 = n0 + 6, *n2 = n1 + 6, *n3 = n2 + 6;
+		for (int i = 0; i < 6; ++i) {
+			const double y = w0 * n0[i] + w1 * n1[i] + w2 * n2[i] + w3 * n3[i];
+			if (i < 3) {
+				r[i] = y;
+			} else {
+				v[i - 3] = y;
+			}
+		}
+		return true;
+	}
+	/// Returns the first epoch of the table window
+	epoch get_start() const {return epoch(m_start);}
+	/// Returns the last epoch of the table window
+	epoch get_end() const {return epoch(m_start + (m_n - 1) * m_step);}
+	/// Returns the node spacing (days)
+	double get_step() const {return m_step;}
+	/// Returns the maximum relative error measured while building the table
+	double get_max_error() const {return m_max_error;}
+private:
+	ephemeris_table():m_start(0),m_step(1),m_n(0),m_max_error(0) {}
+// Serialization code
+	friend class boost::serialization::access;
+	template <class Archive>
+	void serialize(Archive &ar, const unsigned int)
+	{
+		ar & m_start;
+		ar & m_step;
+		ar & m_n;
+		ar & m_max_error;
+		ar & m_data;
+	}
+// Serialization code (END)
+	double m_start;
+	double m_step;
+	std::vector<double>::size_type m_n;
+	double m_max_error;
+	std::vector<double> m_data;
+};
+
+} //namespaces
+
+#endif // KEPLERIAN_TOOLBOX_EPHEMERIS_TABLE_H
@@ -26,13 +26,18 @@
 #define KEPLERIAN_TOOLBOX_H
 
 #include"epoch.h"
+#include"ephemeris_table.h"
 #include"planet.h"
 #include"planet_ss.h"
 #include"planet_js.h"
 #include"planet_mpcorb.h"
+#include"mpcorb_catalogue.h"
+#include"orbit_index.h"
+#include"asteroid_catalogue.h"
 #include"asteroid_gtoc2.h"
 #include"asteroid_gtoc5.h"
 #include"lambert_problem.h"
+#include"porkchop.h"
 #include"core_functions/array3D_operations.h"
 #include"core_functions/convert_anomalies.h"
 #include"core_functions/convert_dates.h"
@@ -48,48 +48,14 @@ const array3D lambert_problem::default_r2 = {{0.0,1.0,0.0}};
 lambert_problem::lambert_problem(const array3D &r1, const array3D &r2, const double &tof, const double& mu, const int &cw, const int &multi_revs) :
 				m_r1(r1), m_r2(r2),m_tof(tof),m_mu(mu),m_has_converged(true), m_multi_revs(multi_revs)
 {
-	// 0 - Sanity checks
-	if (tof <= 0) {
-		throw_value_error("Time of flight is negative!");
-	}
-	if (mu <= 0) {
-		throw_value_error("Gravity parameter is zero or negative!");
-	}
 	// 1 - Getting lambda and T
-	m_c = sqrt( (r2[0]-r1[0])*(r2[0]-r1[0]) + (r2[1]-r1[1])*(r2[1]-r1[1]) + (r2[2]-r1[2])*(r2[2]-r1[2]));
-	double R1 = norm(m_r1);
-	double R2 = norm(m_r2);
-	m_s = (m_c+R1+R2) / 2.0;
-	array3D ir1,ir2,ih,it1,it2;
-	vers(ir1,r1);
-	vers(ir2,r2);
-	cross(ih,ir1,ir2);
-	vers(ih,ih);
-	if (ih[2] == 0) {
-		throw_value_error("The angular momentum vector has no z component, impossible to define automatically clock or counterclockwise");
-	}
-	double lambda2 = 1.0 - m_c/m_s;
-	m_lambda = sqrt(lambda2);
-
-	if (ih[2] < 0.0) // Transfer angle is larger than 180 degrees as seen from abive the z axis
-	{
-		m_lambda = -m_lambda;
-		cross(it1,ir1,ih);
-		cross(it2,ir2,ih);
-	} else {
-		cross(it1,ih,ir1);
-		cross(it2,ih,ir2);
-	}
-	vers(it1,it1);
-	vers(it2,it2);
-
-	if (cw) { // Retrograde motion
-		m_lambda = -m_lambda;
-		it1[0] = -it1[0]; it1[1] = -it1[1]; it1[2] = -it1[2];
-		it2[0] = -it2[0]; it2[1] = -it2[1]; it2[2] = -it2[2];
-	}
-	double lambda3 = m_lambda*lambda2;
-	double T = sqrt(2.0*m_mu/m_s/m_s/m_s) * m_tof;
+	geometry g;
+	compute_geometry(g,r1,r2,tof,mu,cw);
+	m_c = g.c;
+	m_s = g.s;
+	m_lambda = g.lambda;
+	double lambda2 = m_lambda*m_lambda;
+	double T = g.T;
 
 	// 2 - We now have lambda, T and we will find all x
 	// 2.1 - Let us first detect the maximum number of revolutions for which there exists a solution
@@ -97,7 +63,7 @@ lambert_problem::lambert_problem(const array3D &r1, const array3D &r2, const dou
 	m_Nmax = std::min(m_multi_revs,m_Nmax);
 	double T00 = acos(m_lambda) + m_lambda*sqrt(1.0-lambda2);
 	double T0 = (T00 + m_Nmax*M_PI);
-	double T1 = 2.0/3.0 * (1.0 - lambda3),DT=0.0,DDT=0.0,DDDT=0.0;
+	double DT=0.0,DDT=0.0,DDDT=0.0;
 	if (m_Nmax >0) {
 		if (T < T0) { // We use Halley iterations to find xM and TM
 			int it=0;
@@ -105,7 +71,7 @@ lambert_problem::lambert_problem(const array3D &r1, const array3D &r2, const dou
 			double T_min=T0;
 			double x_old=0.0,x_new = 0.0;
 			while (1) {
-				dTdx(DT,DDT,DDDT,x_old,T_min);
+				dTdx(DT,DDT,DDDT,x_old,T_min,m_lambda);
 				if (!(DT == 0.0)) {
 						x_new = x_old - DT * DDT / (DDT * DDT - DT * DDDT / 2.0);
 				}
@@ -113,7 +79,7 @@ lambert_problem::lambert_problem(const array3D &r1, const array3D &r2, const dou
 				if ( (err<1e-13) || (it>12) ) {
 					break;
 				}
-				x2tof(T_min,x_new,m_Nmax);
+				x2tof(T_min,x_new,m_Nmax,m_lambda);
 				x_old=x_new;
 				it++;
 			}
@@ -134,15 +100,9 @@ lambert_problem::lambert_problem(const array3D &r1, const array3D &r2, const dou
 	// 3 - We may now find all solutions in x,y
 	// 3.1 0 rev solution
 	// 3.1.1 initial guess
-	if (T>=T00) {
-		m_x[0] = pow((T00/T),2.0/3.0) - 1.0;
-	} else if (T<=T1) {
-		m_x[0] = 2.0*T1/T - 1.0;
-	} else {
-		m_x[0] = pow((T/T00),0.69314718055994529 / log(T1/T00)) - 1.0;
-	}
+	m_x[0] = zero_rev_guess(T,m_lambda);
 	// 3.1.2 Householder iterations
-	m_iters[0] = householder(T, m_x[0], 0.0, 1e-5, 15);
+	m_iters[0] = householder(T, m_x[0], 0.0, 1e-5, 15, m_lambda);
 	// 3.2 multi rev solutions
 	double tmp;
 	for (int i=1;i<m_Nmax+1;++i)
@@ -150,41 +110,167 @@ lambert_problem::lambert_problem(const array3D &r1, const array3D &r2, const dou
 		//3.2.1 left Householder iterations
 		tmp = pow((i*M_PI+M_PI) / (8.0*T), 2.0/3.0);
 		m_x[2*i-1] = (tmp-1)/(tmp+1);
-		m_iters[2*i-1] = householder(T, m_x[2*i-1], i, 1e-8, 15);
+		m_iters[2*i-1] = householder(T, m_x[2*i-1], i, 1e-8, 15, m_lambda);
 		//3.2.1 right Householder iterations
 		tmp = pow((8.0*T)/(i*M_PI), 2.0/3.0);
 		m_x[2*i] = (tmp-1)/(tmp+1);
-		m_iters[2*i] = householder(T, m_x[2*i], i, 1e-8, 15);
+		m_iters[2*i] = householder(T, m_x[2*i], i, 1e-8, 15, m_lambda);
 	}
 
 	// 4 - For each found x value we reconstruct the terminal velocities
-	double gamma = sqrt(m_mu*m_s/2.0);
-	double rho = (R1-R2) / m_c;
-	double sigma = sqrt(1-rho*rho);
-	double vr1,vt1,vr2,vt2,y;
 	for (size_t i=0;i< m_x.size();++i)
 	{
-		y = sqrt(1.0-lambda2+lambda2*m_x[i]*m_x[i]);
-		vr1 = gamma *((m_lambda*y-m_x[i])-rho*(m_lambda*y+m_x[i]))/R1;
-		vr2 = -gamma*((m_lambda*y-m_x[i])+rho*(m_lambda*y+m_x[i]))/R2;
-		double vt = gamma*sigma*(y+m_lambda*m_x[i]);
-		vt1 = vt/R1;
-		vt2 = vt/R2;
-		for (int j=0; j<3;++j) m_v1[i][j] = vr1 * ir1[j] + vt1 * it1[j];
-		for (int j=0; j<3;++j) m_v2[i][j] = vr2 * ir2[j] + vt2 * it2[j];
+		compute_velocities(m_v1[i],m_v2[i],g,m_x[i],m_mu);
+	}
+}
+
+/// Zero revolutions solution
+/** Solves a Lambert problem for its zero revolutions solution only, without instantiating a lambert_problem and
+ * without allocating memory. The result is the same as get_v1()[0] and get_v2()[0] of the corresponding lambert_problem.
+ *
+ * \param[out] v1 velocity at r1
+ * \param[out] v2 velocity at r2
+ * \param[in] r1 first cartesian position
+ * \param[in] r2 second cartesian position
+ * \param[in] tof time of flight
+ * \param[in] mu gravity parameter
+ * \param[in] cw when 1 a retrograde orbit is assumed
+ *
+ * \return the number of Householder iterations
+ */
+int lambert_problem::solve(array3D &v1, array3D &v2, const array3D &r1, const array3D &r2, const double &tof, const double& mu, const int &cw)
+{
+	geometry g;
+	compute_geometry(g,r1,r2,tof,mu,cw);
+	double x = zero_rev_guess(g.T,g.lambda);
+	int iters = householder(g.T, x, 0, 1e-5, 15, g.lambda);
+	compute_velocities(v1,v2,g,x,mu);
+	return iters;
+}
+
+/// Zero revolutions solutions of many Lambert problems
+/** Solves n = r1.size() Lambert problems (r1[i], r2[i], tof[i]) around the same central body for their zero revolutions
+ * solution. Each step of the solution is carried out on the whole batch before moving to the next one, so that the
+ * loops not involving the Householder iterations are free of branches (and the compiler can vectorise them).
+ *
+ * \param[out] v1 velocities at r1 (resized to n)
+ * \param[out] v2 velocities at r2 (resized to n)
+ * \param[in] r1 first cartesian positions
+ * \param[in] r2 second cartesian positions
+ * \param[in] tof times of flight
+ * \param[in] mu gravity parameter
+ * \param[in] cw when 1 a retrograde orbit is assumed
+ */
+void lambert_problem::solve_batch(std::vector<array3D> &v1, std::vector<array3D> &v2, const std::vector<array3D> &r1, const std::vector<array3D> &r2,
+	const std::vector<double> &tof, const double& mu, const int &cw)
+{
+	const size_t n = r1.size();
+	if (r2.size() != n || tof.size() != n) {
+		throw_value_error("Inconsistent sizes in the Lambert problems batch");
+	}
+	std::vector<geometry> g(n);
+	std::vector<double> x(n);
+	v1.resize(n);
+	v2.resize(n);
+	for (size_t i = 0; i < n; ++i) {
+		compute_geometry(g[i],r1[i],r2[i],tof[i],mu,cw);
+	}
+	for (size_t i = 0; i < n; ++i) {
+		x[i] = zero_rev_guess(g[i].T,g[i].lambda);
+	}
+	for (size_t i = 0; i < n; ++i) {
+		householder(g[i].T, x[i], 0, 1e-5, 15, g[i].lambda);
+	}
+	for (size_t i = 0; i < n; ++i) {
+		compute_velocities(v1[i],v2[i],g[i],x[i],mu);
+	}
+}
+
+void lambert_problem::compute_geometry(geometry &g, const array3D &r1, const array3D &r2, const double &tof, const double &mu, const int &cw)
+{
+	// 0 - Sanity checks
+	if (tof <= 0) {
+		throw_value_error("Time of flight is negative!");
+	}
+	if (mu <= 0) {
+		throw_value_error("Gravity parameter is zero or negative!");
+	}
+	g.c = sqrt( (r2[0]-r1[0])*(r2[0]-r1[0]) + (r2[1]-r1[1])*(r2[1]-r1[1]) + (r2[2]-r1[2])*(r2[2]-r1[2]));
+	g.R1 = norm(r1);
+	g.R2 = norm(r2);
+	g.s = (g.c+g.R1+g.R2) / 2.0;
+	array3D ih;
+	vers(g.ir1,r1);
+	vers(g.ir2,r2);
+	cross(ih,g.ir1,g.ir2);
+	vers(ih,ih);
+	if (ih[2] == 0) {
+		throw_value_error("The angular momentum vector has no z component, impossible to define automatically clock or counterclockwise");
+	}
+	double lambda2 = 1.0 - g.c/g.s;
+	g.lambda = sqrt(lambda2);
+
+	if (ih[2] < 0.0) // Transfer angle is larger than 180 degrees as seen from abive the z axis
+	{
+		g.lambda = -g.lambda;
+		cross(g.it1,g.ir1,ih);
+		cross(g.it2,g.ir2,ih);
+	} else {
+		cross(g.it1,ih,g.ir1);
+		cross(g.it2,ih,g.ir2);
 	}
+	vers(g.it1,g.it1);
+	vers(g.it2,g.it2);
+
+	if (cw) { // Retrograde motion
+		g.lambda = -g.lambda;
+		g.it1[0] = -g.it1[0]; g.it1[1] = -g.it1[1]; g.it1[2] = -g.it1[2];
+		g.it2[0] = -g.it2[0]; g.it2[1] = -g.it2[1]; g.it2[2] = -g.it2[2];
+	}
+	g.T = sqrt(2.0*mu/g.s/g.s/g.s) * tof;
+}
+
+double lambert_problem::zero_rev_guess(const double T, const double lambda)
+{
+	double lambda2 = lambda*lambda;
+	double lambda3 = lambda*lambda2;
+	double T00 = acos(lambda) + lambda*sqrt(1.0-lambda2);
+	double T1 = 2.0/3.0 * (1.0 - lambda3);
+	if (T>=T00) {
+		return pow((T00/T),2.0/3.0) - 1.0;
+	} else if (T<=T1) {
+		return 2.0*T1/T - 1.0;
+	} else {
+		return pow((T/T00),0.69314718055994529 / log(T1/T00)) - 1.0;
+	}
+}
+
+void lambert_problem::compute_velocities(array3D &v1, array3D &v2, const geometry &g, const double x, const double mu)
+{
+	double lambda2 = g.lambda*g.lambda;
+	double gamma = sqrt(mu*g.s/2.0);
+	double rho = (g.R1-g.R2) / g.c;
+	double sigma = sqrt(1-rho*rho);
+	double y = sqrt(1.0-lambda2+lambda2*x*x);
+	double vr1 = gamma *((g.lambda*y-x)-rho*(g.lambda*y+x))/g.R1;
+	double vr2 = -gamma*((g.lambda*y-x)+rho*(g.lambda*y+x))/g.R2;
+	double vt = gamma*sigma*(y+g.lambda*x);
+	double vt1 = vt/g.R1;
+	double vt2 = vt/g.R2;
+	for (int j=0; j<3;++j) v1[j] = vr1 * g.ir1[j] + vt1 * g.it1[j];
+	for (int j=0; j<3;++j) v2[j] = vr2 * g.ir2[j] + vt2 * g.it2[j];
 }
 
 int lambert_problem::householder(const double T, double& x0, const int N,
-						const double eps, const int iter_max) {
+						const double eps, const int iter_max, const double lambda) {
 	int it=0;
 	double err = 1.0;
 	double xnew=0.0;
 	double tof=0.0, delta=0.0,DT=0.0,DDT=0.0,DDDT=0.0;
 	while ( (err>eps) && (it < iter_max) )
 	{
-			x2tof(tof,x0,N);
-			dTdx(DT,DDT,DDDT,x0,tof);
+			x2tof(tof,x0,N,lambda);
+			dTdx(DT,DDT,DDDT,x0,tof,lambda);
 			delta = tof-T;
 			double DT2 = DT*DT;
 			xnew = x0 - delta * (DT2-delta*DDT/2.0) / (DT*(DT2-delta*DDT) + DDDT*delta*delta/6.0);
@@ -196,10 +282,10 @@ int lambert_problem::householder(const double T, double& x0, const int N,
 }
 
 void lambert_problem::dTdx(double &DT,double &DDT,double &DDDT,const double x,
-							 const double T)
+							 const double T, const double lambda)
 {
-	double l2 = m_lambda*m_lambda;
-	double l3 = l2*m_lambda;
+	double l2 = lambda*lambda;
+	double l3 = l2*lambda;
 	double umx2 = 1.0-x*x;
 	double y = sqrt(1.0-l2*umx2);
 	double y2 = y*y;
@@ -209,57 +295,57 @@ void lambert_problem::dTdx(double &DT,double &DDT,double &DDDT,const double x,
 	DDDT = 1.0 / umx2 * (7.0*x*DDT+8.0*DT-6.0*(1.0-l2)*l2*l3*x/y3/y2);
 }
 
-void lambert_problem::x2tof2(double &tof,const double x, const int N)
+void lambert_problem::x2tof2(double &tof,const double x, const int N, const double lambda)
 {
 	double a = 1.0 / (1.0-x*x);
 	if (a>0)	//ellipse
 	{
 		double alfa = 2.0*acos(x);
-		double beta = 2.0 * asin (sqrt(m_lambda*m_lambda/a));
-		if (m_lambda<0.0) beta = -beta;
+		double beta = 2.0 * asin (sqrt(lambda*lambda/a));
+		if (lambda<0.0) beta = -beta;
 		tof =  ((a * sqrt (a)* ( (alfa - sin(alfa)) - (beta - sin(beta)) + 2.0*M_PI*N)) / 2.0);
 	}
 	else
 	{
 		double alfa = 2.0*boost::math::acosh(x);
-		double beta = 2.0 * boost::math::asinh(sqrt(-m_lambda*m_lambda/a));
-		if (m_lambda<0.0) beta = -beta;
+		double beta = 2.0 * boost::math::asinh(sqrt(-lambda*lambda/a));
+		if (lambda<0.0) beta = -beta;
 		tof =  ( -a * sqrt (-a)* ( (beta - sinh(beta)) - (alfa - sinh(alfa)) ) / 2.0);
 	}
 }
 
-void lambert_problem::x2tof(double &tof,const double x, const int N)
+void lambert_problem::x2tof(double &tof,const double x, const int N, const double lambda)
 {
 	double battin = 0.01;
 	double lagrange = 0.2;
 	double dist = fabs(x-1);
 	if (dist < lagrange && dist > battin) { // We use Lagrange tof expression
-		x2tof2(tof,x,N);
+		x2tof2(tof,x,N,lambda);
 		return;
 	}
-	double K = m_lambda*m_lambda;
+	double K = lambda*lambda;
 	double E = x*x-1.0;
 	double rho = fabs(E);
 	double z = sqrt(1+K*E);
 	if (dist < battin) { // We use Battin series tof expression
-		double eta = z-m_lambda*x;
-		double S1 = 0.5*(1.0-m_lambda-x*eta);
+		double eta = z-lambda*x;
+		double S1 = 0.5*(1.0-lambda-x*eta);
 		double Q = hypergeometricF(S1,1e-11);
 		Q = 4.0/3.0*Q;
-		tof = (eta*eta*eta*Q+4.0*m_lambda*eta)/2.0 + N*M_PI / pow(rho,1.5);
+		tof = (eta*eta*eta*Q+4.0*lambda*eta)/2.0 + N*M_PI / pow(rho,1.5);
 		return;
 	} else { // We use Lancaster tof expresion
 		double y=sqrt(rho);
-		double g = x*z - m_lambda*E;
+		double g = x*z - lambda*E;
 		double d = 0.0;
 		if (E<0) {
 			double l = acos(g);
 			d=N*M_PI+l;
 		} else {
-			double f = y*(z-m_lambda*x);
+			double f = y*(z-lambda*x);
 			d=log(f+g);
 		}
-		tof = (x-m_lambda*z-d/y)/E;
+		tof = (x-lambda*z-d/y)/E;
 		return;
 	}
 }
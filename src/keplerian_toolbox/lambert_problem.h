@@ -49,6 +49,9 @@ namespace kep_toolbox {
  * by lambert_test.cpp). With respect to Gooding algorithm it is 1.3 - 1.5 times faster (zero revs - multi revs).
  * The algorithm is described in detail in the publication below and its original with the author.
  *
+ * When only the zero revolutions solution is needed, the static methods solve() and solve_batch() compute it
+ * without instantiating the class and without any heap allocation (solve_batch() only allocates its outputs).
+ *
  * @author Dario Izzo (dario.izzo _AT_ googlemail.com)
  */
 
@@ -68,12 +71,23 @@ public:
 	const std::vector<double>& get_x() const;
 	const std::vector<int>& get_iters() const;
 	int get_Nmax() const;
+	static int solve(array3D &v1, array3D &v2, const array3D &r1, const array3D &r2, const double &tof, const double& mu = 1., const int &cw = 0);
+	static void solve_batch(std::vector<array3D> &v1, std::vector<array3D> &v2, const std::vector<array3D> &r1, const std::vector<array3D> &r2,
+		const std::vector<double> &tof, const double& mu = 1., const int &cw = 0);
 private:
-	int householder(const double T, double& x0, const int N, const double eps, const int itermax);
-	void dTdx(double &DT,double &DDT,double &DDDT,const double x0, const double tof);
-	void x2tof(double &tof,const double x0, const int N);
-	void x2tof2(double &tof,const double x0, const int N);
-	double hypergeometricF(double z, double tol);
+	// Geometry of a Lambert problem (chord, semi-perimeter, lambda, non dimensional time of flight, radii and reference frames)
+	struct geometry {
+		double c, s, lambda, T, R1, R2;
+		array3D ir1, ir2, it1, it2;
+	};
+	static void compute_geometry(geometry &g, const array3D &r1, const array3D &r2, const double &tof, const double &mu, const int &cw);
+	static double zero_rev_guess(const double T, const double lambda);
+	static void compute_velocities(array3D &v1, array3D &v2, const geometry &g, const double x, const double mu);
+	static int householder(const double T, double& x0, const int N, const double eps, const int itermax, const double lambda);
+	static void dTdx(double &DT,double &DDT,double &DDDT,const double x0, const double tof, const double lambda);
+	static void x2tof(double &tof,const double x0, const int N, const double lambda);
+	static void x2tof2(double &tof,const double x0, const int N, const double lambda);
+	static double hypergeometricF(double z, double tol);
 	friend class boost::serialization::access;
 	template <class Archive>
 	void serialize(Archive &ar, const unsigned int)
@@ -0,0 +1,347 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2009 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <algorithm>
+#include <boost/algorithm/string.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#include "mpcorb_catalogue.h"
+#include "planet_mpcorb.h"
+#include "core_functions/convert_anomalies.h"
+#include "core_functions/par2ic.h"
+#include "exceptions.h"
+
+// Same record layout used by planet_mpcorb
+static const int mpcorb_format[12][2] =
+{
+	{92,11},	// a (AU)
+	{70,9},		// e
+	{59,9},		// i (deg)
+	{48,9},		// Omega (deg)
+	{37,9},		// omega (deg)
+	{26,9},		// M (deg)
+	{20,5},		// Epoch (packed format)
+	{166,28},	// Asteroid readable name
+	{8,5},		// Absolute Magnitude
+	{117,5},	// Number of observations
+	{123,3},	// Number of oppositions
+	{0,7},		// Packed designation
+};
+
+// Minimum length of a record (all numerical fields must be present)
+static const std::string::size_type mpcorb_min_length = 131;
+
+// Copies a fixed width field into a null terminated buffer (the fields are at most 28 characters long)
+static void copy_field(char *buf, const char *line, const int &field)
+{
+	std::memcpy(buf,line + mpcorb_format[field][0],mpcorb_format[field][1]);
+	buf[mpcorb_format[field][1]] = '\0';
+}
+
+// Parses a fixed width numerical field, returns false if the field does not contain a number
+static bool parse_field(double &out, const char *line, const int &field)
+{
+	char buf[32], *end;
+	copy_field(buf,line,field);
+	out = std::strtod(buf,&end);
+	if (end == buf) {
+		return false;
+	}
+	while (*end == ' ') {
+		++end;
+	}
+	return *end == '\0';
+}
+
+namespace kep_toolbox {
+
+// Static mutex protecting the lazy construction of the indices
+boost::mutex mpcorb_catalogue::m_index_mutex;
+
+/// Constructor
+/**
+ * Loads an MPCORB.DAT file.
+ *
+ * \param[in] filename name of the MPCORB file
+ * \param[in] n_threads number of threads used to parse the records
+ *
+ * \throws value_error if the file cannot be read, if n_threads is zero or if a record is malformed
+ */
+mpcorb_catalogue::mpcorb_catalogue(const std::string &filename, const unsigned int &n_threads):m_n_threads(n_threads)
+{
+	if (n_threads == 0) {
+		throw_value_error("The number of threads must be at least one");
+	}
+	// Bulk read of the whole file
+	std::ifstream f(filename.c_str(), std::ios::in | std::ios::binary);
+	if (!f) {
+		throw_value_error("Could not open the MPCORB file " + filename);
+	}
+	f.seekg(0, std::ios::end);
+	std::vector<char> buffer(static_cast<std::vector<char>::size_type>(f.tellg()) + 1);
+	f.seekg(0, std::ios::beg);
+	f.read(&buffer[0], buffer.size() - 1);
+	buffer.back() = '\n';
+	// Split in lines and select the records
+	std::vector<const char *> lines;
+	std::vector<std::string::size_type> lengths;
+	const char *p = &buffer[0], *const last = &buffer[0] + buffer.size();
+	while (p < last) {
+		const char *eol = static_cast<const char *>(std::memchr(p, '\n', last - p));
+		std::string::size_type len = eol - p;
+		if (len > 0 && p[len - 1] == '\r') {
+			--len;
+		}
+		if (len >= 5 && std::strncmp(p, "-----", 5) == 0) {
+			// End of the header: what has been found so far is not a record
+			lines.clear();
+			lengths.clear();
+		} else if (len >= mpcorb_min_length) {
+			lines.push_back(p);
+			lengths.push_back(len);
+		}
+		p = eol + 1;
+	}
+	const std::vector<double>::size_type n = lines.size();
+	m_a.resize(n); m_e.resize(n); m_i.resize(n); m_Om.resize(n); m_om.resize(n); m_M.resize(n);
+	m_epoch.resize(n); m_H.resize(n); m_n_observations.resize(n); m_n_oppositions.resize(n);
+	m_name.resize(n); m_designation.resize(n);
+	// Parallel parsing, each thread fills a contiguous slice of the arrays
+	const unsigned int n_workers = std::max(1u, std::min<unsigned int>(n_threads, n));
+	std::vector<std::vector<double>::size_type> bad(n_workers, n);
+	if (n_workers == 1) {
+		parse_lines(lines, lengths, 0, n, bad[0]);
+	} else {
+		boost::thread_group threads;
+		for (unsigned int k = 0; k < n_workers; ++k) {
+			threads.create_thread(boost::bind(&mpcorb_catalogue::parse_lines, this, boost::cref(lines), boost::cref(lengths),
+				(n * k) / n_workers, (n * (k + 1)) / n_workers, boost::ref(bad[k])));
+		}
+		threads.join_all();
+	}
+	const std::vector<double>::size_type first_bad = *std::min_element(bad.begin(), bad.end());
+	if (first_bad != n) {
+		throw_value_error("Malformed MPCORB record: " + std::string(lines[first_bad], std::min<std::string::size_type>(lengths[first_bad], 40)));
+	}
+}
+
+// Parses the records [begin, end), bad is set to the first malformed record (if any)
+void mpcorb_catalogue::parse_lines(const std::vector<const char *> &lines, const std::vector<std::string::size_type> &lengths, std::vector<double>::size_type begin,
+	const std::vector<double>::size_type &end, std::vector<double>::size_type &bad)
+{
+	// Records usually share few epochs, their conversion is cached
+	std::string packed, last_packed;
+	double last_mjd2000 = 0;
+	char buf[32];
+	double tmp;
+	for (; begin < end; ++begin) {
+		const char *line = lines[begin];
+		const std::vector<double>::size_type i = begin;
+		if (!(parse_field(m_a[i], line, 0) && parse_field(m_e[i], line, 1) && parse_field(m_i[i], line, 2) && parse_field(m_Om[i], line, 3) &&
+			parse_field(m_om[i], line, 4) && parse_field(m_M[i], line, 5) && parse_field(m_H[i], line, 8) && parse_field(tmp, line, 9))) {
+			bad = i;
+			return;
+		}
+		m_n_observations[i] = static_cast<unsigned int>(tmp);
+		if (!parse_field(tmp, line, 10)) {
+			bad = i;
+			return;
+		}
+		m_n_oppositions[i] = static_cast<unsigned int>(tmp);
+		// Converting orbital elements to the dictatorial PaGMO units.
+		m_a[i] *= ASTRO_AU;
+		m_i[i] *= ASTRO_DEG2RAD;
+		m_Om[i] *= ASTRO_DEG2RAD;
+		m_om[i] *= ASTRO_DEG2RAD;
+		m_M[i] *= ASTRO_DEG2RAD;
+		copy_field(buf, line, 6);
+		packed = buf;
+		boost::algorithm::trim(packed);
+		if (packed != last_packed) {
+			try {
+				last_mjd2000 = planet_mpcorb::packed_date2epoch(packed).mjd2000();
+			} catch (...) {
+				bad = i;
+				return;
+			}
+			last_packed = packed;
+		}
+		m_epoch[i] = last_mjd2000;
+		copy_field(buf, line, 11);
+		m_designation[i] = buf;
+		boost::algorithm::trim(m_designation[i]);
+		// The name may be truncated in short records
+		const std::string::size_type start = mpcorb_format[7][0];
+		m_name[i] = (lengths[i] > start) ? std::string(line + start, std::min<std::string::size_type>(lengths[i] - start, mpcorb_format[7][1])) : std::string();
+		boost::algorithm::trim(m_name[i]);
+		boost::algorithm::to_lower(m_name[i]);
+	}
+}
+
+void mpcorb_catalogue::check_index(const std::vector<double>::size_type &i) const
+{
+	if (i >= size()) {
+		throw_value_error("Minor planet index out of range");
+	}
+}
+
+/// Finds a minor planet
+/**
+ * \param[in] id lower case name (as in planet_mpcorb::get_name()) or packed designation of the minor planet
+ *
+ * @return the index of the minor planet in the catalogue
+ *
+ * \throws value_error if the minor planet is not in the catalogue
+ */
+std::vector<double>::size_type mpcorb_catalogue::find(const std::string &id) const
+{
+	{
+		// The index is built at the first lookup, as screening the whole catalogue does not need it
+		boost::lock_guard<boost::mutex> lock(m_index_mutex);
+		if (m_index.empty()) {
+			m_index.reserve(2 * size());
+			for (std::vector<double>::size_type i = 0; i < size(); ++i) {
+				m_index.insert(std::make_pair(m_designation[i], i));
+				m_index.insert(std::make_pair(m_name[i], i));
+			}
+		}
+	}
+	boost::unordered_map<std::string, std::vector<double>::size_type>::const_iterator it = m_index.find(id);
+	if (it == m_index.end()) {
+		throw_value_error("Minor planet " + id + " not found in the catalogue");
+	}
+	return it->second;
+}
+
+/// Returns the keplerian elements (a,e,i,Om,om,M) of the i-th minor planet at its reference epoch (SI units)
+array6D mpcorb_catalogue::get_elements(const std::vector<double>::size_type &i) const
+{
+	check_index(i);
+	array6D elem = {{m_a[i], m_e[i], m_i[i], m_Om[i], m_om[i], m_M[i]}};
+	return elem;
+}
+
+/// Returns the reference epoch of the elements of the i-th minor planet
+epoch mpcorb_catalogue::get_ref_epoch(const std::vector<double>::size_type &i) const
+{
+	check_index(i);
+	return epoch(m_epoch[i]);
+}
+
+/// Returns the absolute magnitude of the i-th minor planet
+double mpcorb_catalogue::get_H(const std::vector<double>::size_type &i) const
+{
+	check_index(i);
+	return m_H[i];
+}
+
+/// Returns the number of observations used to compute the orbit of the i-th minor planet
+unsigned int mpcorb_catalogue::get_n_observations(const std::vector<double>::size_type &i) const
+{
+	check_index(i);
+	return m_n_observations[i];
+}
+
+/// Returns the number of oppositions used to compute the orbit of the i-th minor planet
+unsigned int mpcorb_catalogue::get_n_oppositions(const std::vector<double>::size_type &i) const
+{
+	check_index(i);
+	return m_n_oppositions[i];
+}
+
+/// Returns the (lower case) name of the i-th minor planet
+const std::string &mpcorb_catalogue::get_name(const std::vector<double>::size_type &i) const
+{
+	check_index(i);
+	return m_name[i];
+}
+
+/// Returns the packed designation of the i-th minor planet
+const std::string &mpcorb_catalogue::get_designation(const std::vector<double>::size_type &i) const
+{
+	check_index(i);
+	return m_designation[i];
+}
+
+/// Builds the i-th minor planet
+/**
+ * The planet has the same elements and physical parameters of the planet_mpcorb built from the same MPCORB record.
+ */
+planet_ptr mpcorb_catalogue::get_planet(const std::vector<double>::size_type &i) const
+{
+	check_index(i);
+	// Same hyper simplified assumptions as in planet_mpcorb
+	const double radius = 1329000 * std::pow(10,-m_H[i] * 0.2);
+	const double mu_planet = 4./3. * M_PI * std::pow(radius,3) * 2800 * ASTRO_CAVENDISH;
+	return planet_ptr(new planet(epoch(m_epoch[i]), get_elements(i), ASTRO_MU_SUN, mu_planet, radius, radius * 1.1, m_name[i]));
+}
+
+/// Computes the ephemerides of the whole catalogue
+/**
+ * \param[in] when epoch in which ephemerides are required
+ * \param[out] r positions of all minor planets at epoch (SI units)
+ * \param[out] v velocities of all minor planets at epoch (SI units)
+ */
+void mpcorb_catalogue::get_eph(const epoch &when, std::vector<array3D> &r, std::vector<array3D> &v) const
+{
+	const std::vector<double>::size_type n = size();
+	r.resize(n);
+	v.resize(n);
+	const unsigned int n_workers = std::max(1u, std::min<unsigned int>(m_n_threads, n));
+	if (n_workers == 1) {
+		eph_range(when.mjd2000(), r, v, 0, n);
+	} else {
+		boost::thread_group threads;
+		for (unsigned int k = 0; k < n_workers; ++k) {
+			threads.create_thread(boost::bind(&mpcorb_catalogue::eph_range, this, when.mjd2000(), boost::ref(r), boost::ref(v),
+				(n * k) / n_workers, (n * (k + 1)) / n_workers));
+		}
+		threads.join_all();
+	}
+}
+
+void mpcorb_catalogue::eph_range(const double &mjd2000, std::vector<array3D> &r, std::vector<array3D> &v, const std::vector<double>::size_type &begin,
+	const std::vector<double>::size_type &end) const
+{
+	array6D elem;
+	for (std::vector<double>::size_type i = begin; i < end; ++i) {
+		const double n = std::sqrt(ASTRO_MU_SUN / (m_a[i] * m_a[i] * m_a[i]));
+		elem[0] = m_a[i];
+		elem[1] = m_e[i];
+		elem[2] = m_i[i];
+		elem[3] = m_Om[i];
+		elem[4] = m_om[i];
+		elem[5] = m2e(m_M[i] + n * (mjd2000 - m_epoch[i]) * ASTRO_DAY2SEC, m_e[i]);
+		par2ic(elem, ASTRO_MU_SUN, r[i], v[i]);
+	}
+}
+
+} //namespaces
@@ -0,0 +1,91 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2009 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef KEPLERIAN_TOOLBOX_MPCORB_CATALOGUE_H
+#define KEPLERIAN_TOOLBOX_MPCORB_CATALOGUE_H
+
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
+#include <string>
+#include <vector>
+
+#include "planet.h"
+#include "astro_constants.h"
+#include "epoch.h"
+#include "config.h"
+
+namespace kep_toolbox {
+
+/// MPCORB catalogue
+/**
+ * This class loads a whole MPCORB.DAT file into a compact structure of arrays holding, for each minor planet,
+ * the keplerian elements, their epoch and the few physical data also stored by kep_toolbox::planet_mpcorb.
+ * The file is read with a single bulk read and its lines are parsed by n_threads threads. Header lines
+ * (everything before the dashed separator, when present) and blank lines are skipped.
+ *
+ * Minor planets can be looked up by their (lower case) name or by their packed designation (the first field
+ * of the record), the lookup index being built at the first lookup, and the ephemerides of the whole catalogue can be computed at once.
+ *
+ * @author Dario Izzo (dario.izzo _AT_ googlemail.com)
+ */
+class __KEP_TOOL_VISIBLE mpcorb_catalogue
+{
+public:
+	mpcorb_catalogue(const std::string &filename = "MPCORB.DAT", const unsigned int &n_threads = 1);
+	/// Returns the number of minor planets in the catalogue
+	std::vector<double>::size_type size() const {return m_a.size();}
+	std::vector<double>::size_type find(const std::string &) const;
+	planet_ptr get_planet(const std::vector<double>::size_type &) const;
+	array6D get_elements(const std::vector<double>::size_type &) const;
+	epoch get_ref_epoch(const std::vector<double>::size_type &) const;
+	double get_H(const std::vector<double>::size_type &) const;
+	unsigned int get_n_observations(const std::vector<double>::size_type &) const;
+	unsigned int get_n_oppositions(const std::vector<double>::size_type &) const;
+	const std::string &get_name(const std::vector<double>::size_type &) const;
+	const std::string &get_designation(const std::vector<double>::size_type &) const;
+	void get_eph(const epoch &, std::vector<array3D> &, std::vector<array3D> &) const;
+private:
+	void parse_lines(const std::vector<const char *> &, const std::vector<std::string::size_type> &, std::vector<double>::size_type, const std::vector<double>::size_type &,
+		std::vector<double>::size_type &);
+	void eph_range(const double &, std::vector<array3D> &, std::vector<array3D> &, const std::vector<double>::size_type &, const std::vector<double>::size_type &) const;
+	void check_index(const std::vector<double>::size_type &) const;
+
+	unsigned int m_n_threads;
+	// Keplerian elements (SI units, radians), reference epochs (MJD2000) and absolute magnitudes
+	std::vector<double> m_a, m_e, m_i, m_Om, m_om, m_M, m_epoch, m_H;
+	// Number of observations and of oppositions the orbits were computed from
+	std::vector<unsigned int> m_n_observations;
+	std::vector<unsigned int> m_n_oppositions;
+	std::vector<std::string> m_name;
+	std::vector<std::string> m_designation;
+	// Name and designation index, built at the first lookup
+	mutable boost::unordered_map<std::string, std::vector<double>::size_type> m_index;
+	static boost::mutex m_index_mutex;
+};
+
+} //namespaces
+
+#endif // KEPLERIAN_TOOLBOX_MPCORB_CATALOGUE_H
@@ -0,0 +1,80 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2009 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef HALLEY_H
+#define HALLEY_H
+#include <algorithm>
+#include <cmath>
+
+namespace kep_toolbox
+{
+	/// Safeguarded Halley method
+	/**
+	 * Halley's method (cubic convergence) to solve a non-linear equation F(x) = 0, for F monotonically increasing in
+	 * the bracket [lo,hi] containing the root. Whenever a step would leave the current bracket, a bisection step is taken
+	 * instead and the bracket is shrunk at every iteration, so that convergence is guaranteed.
+	 *
+	 * \param[in,out] x Starting point (clamped into the bracket). On output contains the root.
+	 * \param[in] F equation to be solved in the form F = 0, together with its first and second derivatives. Needs to be
+	 * callable as F(x,f,df,ddf), writing the three values in f, df and ddf (so that common terms are computed only once)
+	 * \param[in] lo lower end of the bracket (F(lo) <= 0)
+	 * \param[in] hi upper end of the bracket (F(hi) >= 0)
+	 * \param[in] max_loop maximum number of iterations
+	 * \param[in] accuracy relative accuracy requested on x
+	 *
+	 * \return the number of iterations left (0 if the loop limit was reached)
+	 */
+	template <class my_function>
+			int halley(double &x, my_function F, double lo, double hi, int max_loop, const double& accuracy)
+	{
+		x = std::min(std::max(x,lo),hi);
+		double term, f, df, ddf;
+		do
+		{
+			(F)(x,f,df,ddf);
+			if (f == 0) {
+				break;
+			}
+			// Shrink the bracket
+			if (f < 0) {
+				lo = x;
+			} else {
+				hi = x;
+			}
+			const double den = 2 * df * df - f * ddf;
+			double x_new = (den != 0) ? x - 2 * f * df / den : lo - 1;
+			// Bisection if Halley's step leaves the bracket
+			if (!(x_new > lo && x_new < hi)) {
+				x_new = (lo + hi) / 2;
+			}
+			term = x_new - x;
+			x = x_new;
+		}
+		// check if term is within required accuracy or loop limit is exceeded
+		while ((std::fabs(term / std::max(std::fabs(x), 1.)) > accuracy) && (--max_loop));
+		return max_loop;
+	}
+}
+#endif // HALLEY_H
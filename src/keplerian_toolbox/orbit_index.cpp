@@ -0,0 +1,272 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2009 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <utility>
+
+#include "orbit_index.h"
+#include "exceptions.h"
+
+namespace kep_toolbox {
+
+namespace {
+
+// Orders the bodies by one coordinate of their points
+struct coordinate_less
+{
+	coordinate_less(const std::vector<double> &points, const unsigned int &dim, const unsigned int &d):m_points(points),m_dim(dim),m_d(d) {}
+	bool operator()(const std::vector<double>::size_type &i, const std::vector<double>::size_type &j) const
+	{
+		return m_points[i * m_dim + m_d] < m_points[j * m_dim + m_d];
+	}
+	const std::vector<double> &m_points;
+	const unsigned int m_dim, m_d;
+};
+
+// Keeps the k closest bodies in a max-heap
+struct knn_visitor
+{
+	typedef std::pair<double, std::vector<double>::size_type> item;
+	knn_visitor(const unsigned int &k):m_k(k) {}
+	double bound() const
+	{
+		return (m_heap.size() < m_k) ? std::numeric_limits<double>::infinity() : m_heap.top().first;
+	}
+	void operator()(const double &d2, const std::vector<double>::size_type &i)
+	{
+		if (m_heap.size() < m_k) {
+			m_heap.push(item(d2, i));
+		} else if (d2 < m_heap.top().first) {
+			m_heap.pop();
+			m_heap.push(item(d2, i));
+		}
+	}
+	const unsigned int m_k;
+	std::priority_queue<item> m_heap;
+};
+
+// Collects all bodies within a given distance
+struct ball_visitor
+{
+	typedef std::pair<double, std::vector<double>::size_type> item;
+	ball_visitor(const double &radius):m_r2(radius * radius) {}
+	double bound() const
+	{
+		return m_r2;
+	}
+	void operator()(const double &d2, const std::vector<double>::size_type &i)
+	{
+		if (d2 <= m_r2) {
+			m_found.push_back(item(d2, i));
+		}
+	}
+	const double m_r2;
+	std::vector<item> m_found;
+};
+
+}
+
+/// Constructor from a set of bodies
+/**
+ * \param[in] bodies the bodies to be indexed
+ * \param[in] when epoch of the states
+ * \param[in] metric the metric to be used (EUCLIDEAN or ORBITAL)
+ * \param[in] T characteristic transfer time of the ORBITAL metric (days)
+ *
+ * \throws value_error if T is not positive
+ */
+orbit_index::orbit_index(const std::vector<planet_ptr> &bodies, const epoch &when, const metric_type &metric, const double &T):m_metric(metric),m_T(T * ASTRO_DAY2SEC)
+{
+	std::vector<array3D> r(bodies.size()), v(bodies.size());
+	for (size_type i = 0; i < bodies.size(); ++i) {
+		bodies[i]->get_eph(when, r[i], v[i]);
+	}
+	build(r, v);
+}
+
+/// Constructor from a set of states
+/**
+ * \param[in] r positions of the bodies (e.g. as computed by mpcorb_catalogue::get_eph())
+ * \param[in] v velocities of the bodies
+ * \param[in] metric the metric to be used (EUCLIDEAN or ORBITAL)
+ * \param[in] T characteristic transfer time of the ORBITAL metric (days)
+ *
+ * \throws value_error if the sizes of r and v differ or if T is not positive
+ */
+orbit_index::orbit_index(const std::vector<array3D> &r, const std::vector<array3D> &v, const metric_type &metric, const double &T):m_metric(metric),m_T(T * ASTRO_DAY2SEC)
+{
+	if (r.size() != v.size()) {
+		throw_value_error("Positions and velocities must have the same size");
+	}
+	build(r, v);
+}
+
+void orbit_index::build(const std::vector<array3D> &r, const std::vector<array3D> &v)
+{
+	if (!(m_T > 0)) {
+		throw_value_error("The characteristic transfer time must be positive");
+	}
+	m_dim = (m_metric == EUCLIDEAN) ? 3 : 6;
+	m_n = r.size();
+	m_points.resize(m_n * m_dim);
+	for (size_type i = 0; i < m_n; ++i) {
+		to_point(&m_points[i * m_dim], r[i], v[i]);
+	}
+	m_perm.resize(m_n);
+	for (size_type i = 0; i < m_n; ++i) {
+		m_perm[i] = i;
+	}
+	m_split.resize(m_n);
+	build_tree(0, m_n);
+}
+
+// Splits the range [lo,hi) at its median along the coordinate of largest spread
+void orbit_index::build_tree(const size_type &lo, const size_type &hi)
+{
+	if (hi - lo < 2) {
+		if (hi > lo) {
+			m_split[lo] = 0;
+		}
+		return;
+	}
+	unsigned int best = 0;
+	double best_spread = -1;
+	for (unsigned int d = 0; d < m_dim; ++d) {
+		double min = std::numeric_limits<double>::infinity(), max = -min;
+		for (size_type k = lo; k < hi; ++k) {
+			const double x = m_points[m_perm[k] * m_dim + d];
+			min = std::min(min, x);
+			max = std::max(max, x);
+		}
+		if (max - min > best_spread) {
+			best_spread = max - min;
+			best = d;
+		}
+	}
+	const size_type mid = (lo + hi) / 2;
+	std::nth_element(m_perm.begin() + lo, m_perm.begin() + mid, m_perm.begin() + hi, coordinate_less(m_points, m_dim, best));
+	m_split[mid] = static_cast<unsigned char>(best);
+	build_tree(lo, mid);
+	build_tree(mid + 1, hi);
+}
+
+void orbit_index::to_point(double *p, const array3D &r, const array3D &v) const
+{
+	if (m_metric == EUCLIDEAN) {
+		std::copy(r.begin(), r.end(), p);
+	} else {
+		for (int i = 0; i < 3; ++i) {
+			p[i] = r[i] / m_T;
+			p[3 + i] = v[i];
+		}
+	}
+}
+
+double orbit_index::distance2(const double *p, const size_type &i) const
+{
+	const double *q = &m_points[i * m_dim];
+	double d2 = 0;
+	for (unsigned int d = 0; d < m_dim; ++d) {
+		d2 += (p[d] - q[d]) * (p[d] - q[d]);
+	}
+	return d2;
+}
+
+template <class Visitor>
+void orbit_index::search(const size_type &lo, const size_type &hi, const double *q, Visitor &visit) const
+{
+	if (lo >= hi) {
+		return;
+	}
+	const size_type mid = (lo + hi) / 2, i = m_perm[mid];
+	visit(distance2(q, i), i);
+	const unsigned int d = m_split[mid];
+	const double delta = q[d] - m_points[i * m_dim + d];
+	// Visit first the half containing the query, then the other one only if it may contain closer points
+	if (delta < 0) {
+		search(lo, mid, q, visit);
+		if (delta * delta <= visit.bound()) {
+			search(mid + 1, hi, q, visit);
+		}
+	} else {
+		search(mid + 1, hi, q, visit);
+		if (delta * delta <= visit.bound()) {
+			search(lo, mid, q, visit);
+		}
+	}
+}
+
+/// k-nearest neighbours query
+/**
+ * \param[out] idx indices of the (at most) k bodies closest to the query state, sorted by increasing distance
+ * \param[out] dist the corresponding distances (m for EUCLIDEAN, m/s for ORBITAL)
+ * \param[in] r position of the query state
+ * \param[in] v velocity of the query state (not used by the EUCLIDEAN metric)
+ * \param[in] k number of neighbours
+ */
+void orbit_index::find_knn(std::vector<size_type> &idx, std::vector<double> &dist, const array3D &r, const array3D &v, const unsigned int &k) const
+{
+	double q[6];
+	to_point(q, r, v);
+	knn_visitor visit(k);
+	if (k > 0) {
+		search(0, m_n, q, visit);
+	}
+	idx.resize(visit.m_heap.size());
+	dist.resize(visit.m_heap.size());
+	for (size_type j = idx.size(); j > 0; --j) {
+		idx[j - 1] = visit.m_heap.top().second;
+		dist[j - 1] = std::sqrt(visit.m_heap.top().first);
+		visit.m_heap.pop();
+	}
+}
+
+/// Radius query
+/**
+ * \param[out] idx indices of the bodies within radius from the query state, sorted by increasing distance
+ * \param[out] dist the corresponding distances (m for EUCLIDEAN, m/s for ORBITAL)
+ * \param[in] r position of the query state
+ * \param[in] v velocity of the query state (not used by the EUCLIDEAN metric)
+ * \param[in] radius query radius (m for EUCLIDEAN, m/s for ORBITAL)
+ */
+void orbit_index::find_ball(std::vector<size_type> &idx, std::vector<double> &dist, const array3D &r, const array3D &v, const double &radius) const
+{
+	double q[6];
+	to_point(q, r, v);
+	ball_visitor visit(radius);
+	search(0, m_n, q, visit);
+	std::sort(visit.m_found.begin(), visit.m_found.end());
+	idx.resize(visit.m_found.size());
+	dist.resize(visit.m_found.size());
+	for (size_type j = 0; j < idx.size(); ++j) {
+		idx[j] = visit.m_found[j].second;
+		dist[j] = std::sqrt(visit.m_found[j].first);
+	}
+}
+
+} //namespaces
@@ -0,0 +1,89 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2009 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef KEPLERIAN_TOOLBOX_ORBIT_INDEX_H
+#define KEPLERIAN_TOOLBOX_ORBIT_INDEX_H
+
+#include <vector>
+
+#include "planet.h"
+#include "astro_constants.h"
+#include "epoch.h"
+#include "config.h"
+
+namespace kep_toolbox {
+
+/// Spatial index over the states of a set of bodies
+/**
+ * This class builds a k-d tree over the states of a set of bodies (e.g. the asteroids of a GTOC problem or
+ * of an mpcorb_catalogue) at a given epoch and answers k-nearest neighbours and radius queries.
+ *
+ * Two metrics are available:
+ * - EUCLIDEAN: the distance between the body positions (m).
+ * - ORBITAL: the distance between the points [r/T, v], where T is a characteristic transfer time. This is a
+ *   linear approximation of the DV (m/s) needed to move from one body to the other in a time T, and is thus a
+ *   cheap proxy of the Lambert DV to prune target selection.
+ *
+ * Queries return the indices of the bodies (in the order they were given to the constructor) sorted by
+ * increasing distance. The index is immutable once built and can be queried from several threads.
+ *
+ * @author Dario Izzo (dario.izzo _AT_ googlemail.com)
+ */
+class __KEP_TOOL_VISIBLE orbit_index
+{
+public:
+	/// Metric types
+	enum metric_type {EUCLIDEAN, ORBITAL};
+	orbit_index(const std::vector<planet_ptr> &bodies, const epoch &when, const metric_type &metric = ORBITAL, const double &T = 365.25);
+	orbit_index(const std::vector<array3D> &r, const std::vector<array3D> &v, const metric_type &metric = ORBITAL, const double &T = 365.25);
+	/// Returns the number of indexed bodies
+	std::vector<double>::size_type size() const {return m_n;}
+	void find_knn(std::vector<std::vector<double>::size_type> &idx, std::vector<double> &dist, const array3D &r, const array3D &v, const unsigned int &k) const;
+	void find_ball(std::vector<std::vector<double>::size_type> &idx, std::vector<double> &dist, const array3D &r, const array3D &v, const double &radius) const;
+private:
+	typedef std::vector<double>::size_type size_type;
+	void build(const std::vector<array3D> &r, const std::vector<array3D> &v);
+	void build_tree(const size_type &lo, const size_type &hi);
+	void to_point(double *p, const array3D &r, const array3D &v) const;
+	double distance2(const double *p, const size_type &i) const;
+	template <class Visitor>
+	void search(const size_type &lo, const size_type &hi, const double *q, Visitor &visit) const;
+
+	metric_type m_metric;
+	// Characteristic transfer time (seconds)
+	double m_T;
+	// Dimension of the points (3 or 6)
+	unsigned int m_dim;
+	size_type m_n;
+	// Points, m_dim coordinates per body
+	std::vector<double> m_points;
+	// Implicit tree: the node of the range [lo,hi) is m_perm[(lo+hi)/2], its split dimension m_split[(lo+hi)/2]
+	std::vector<size_type> m_perm;
+	std::vector<unsigned char> m_split;
+};
+
+} //namespaces
+
+#endif // KEPLERIAN_TOOLBOX_ORBIT_INDEX_H
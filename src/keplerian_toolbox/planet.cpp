@@ -75,7 +75,7 @@ void planet::build_planet(const epoch& ref_epoch, const array6D& orbital_element
 	mean_motion = sqrt(mu_central_body / pow(keplerian_elements[0],3));
 }
 
-void planet::get_eph(const epoch& when, array3D &r, array3D &v) const{
+void planet::eph_impl(const epoch& when, array3D &r, array3D &v) const{
 	if(when.mjd2000() != cached_epoch.mjd2000() || cached_epoch.mjd2000() == 0) {
 		double elements[6];
 		std::copy(keplerian_elements.begin(), keplerian_elements.end(), elements);
@@ -127,6 +127,30 @@ double planet::compute_period() const {
 
 }
 
+/// Sets an ephemeris table
+/**
+ * Tabulates the planet ephemerides in the window [start, end] (see kep_toolbox::ephemeris_table). Afterwards get_eph()
+ * interpolates the table for all epochs in the window. The table is shared with all copies (and clones) of the planet
+ * made after this call.
+ *
+ * \param[in] start first epoch of the table window
+ * \param[in] end last epoch of the table window
+ * \param[in] tol maximum relative error allowed on both position and velocity
+ */
+void planet::set_ephemeris_table(const epoch &start, const epoch &end, const double &tol) {
+	m_table.reset(new ephemeris_table(*this,start,end,tol));
+}
+
+/// Removes the ephemeris table
+void planet::clear_ephemeris_table() {
+	m_table.reset();
+}
+
+/// Returns the ephemeris table (a null pointer if no table has been set)
+boost::shared_ptr<const ephemeris_table> planet::get_ephemeris_table() const {
+	return m_table;
+}
+
 }
 
 /// Overload the stream operator for kep_toolbox::planet
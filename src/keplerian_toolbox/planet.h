@@ -37,6 +37,7 @@
 #include"exceptions.h"
 #include "astro_constants.h"
 #include "epoch.h"
+#include "ephemeris_table.h"
 
 namespace kep_toolbox{
 
@@ -72,7 +73,7 @@ public:
 		* \param[in] name C++ string containing the planet name. Default value is "Unknown"
 		*/
 	planet(const epoch& ref_epoch, const array6D& elem, const double & mu_central_body, const double &mu_self, const double &radius, const double &safe_radius, const std::string &name = "Unknown");
-	planet():mean_motion(0),ref_mjd2000(0), radius(0), safe_radius(0), mu_self(0), mu_central_body(0), cached_epoch(epoch(0)), cached_r(array3D()), cached_v(array3D()) {}
+	planet():mean_motion(0),ref_mjd2000(0), radius(0), safe_radius(0), mu_self(0), mu_central_body(0), cached_epoch(epoch(0)), cached_r(array3D()), cached_v(array3D()), m_table() {}
 	/// Polymorphic copy constructor.
 	virtual planet_ptr clone() const;
 	virtual ~planet();
@@ -80,11 +81,19 @@ public:
 	//@{
 	/// Gets the planet position and velocity
 	/**
+		* If an ephemeris table has been set and covers the requested epoch, the ephemerides are interpolated
+		* from the table, otherwise they are computed by eph_impl(). Derived classes should reimplement eph_impl():
+		* those reimplementing this method instead bypass the ephemeris tables.
+		*
 		* \param[in] when Epoch in which ephemerides are required
 		* \param[out] r Planet position at epoch (SI units)
 		* \param[out] v Planet velocity at epoch (SI units)
 		*/
-	virtual void get_eph(const epoch& when, array3D &r, array3D &v) const;
+	virtual void get_eph(const epoch& when, array3D &r, array3D &v) const {
+		if (!m_table || !m_table->get_eph(when.mjd2000(),r,v)) {
+			eph_impl(when,r,v);
+		}
+	}
 
 	/// Getter for the central body gravitational parameter
 	/**
@@ -185,7 +194,23 @@ public:
 	/// Computes the orbital period
 	double compute_period() const;
 
+	/** @name Ephemeris tables */
+	//@{
+	void set_ephemeris_table(const epoch &start, const epoch &end, const double &tol = 1e-9);
+	void clear_ephemeris_table();
+	boost::shared_ptr<const ephemeris_table> get_ephemeris_table() const;
+	//@}
+
 protected:
+	/// Computes the planet position and velocity
+	/**
+		* Reimplement this method in derived classes to change the ephemerides model.
+		*
+		* \param[in] when Epoch in which ephemerides are required
+		* \param[out] r Planet position at epoch (SI units)
+		* \param[out] v Planet velocity at epoch (SI units)
+		*/
+	virtual void eph_impl(const epoch& when, array3D &r, array3D &v) const;
 	/// Builds the planet assiging all values to members
 	/**
 	* Constructs a planet from its elements and its phyisical parameters
@@ -215,6 +240,7 @@ private:
 		ar & cached_r;
 		ar & cached_v;
 		ar & m_name;
+		ar & m_table;
 	}
 // Serialization code (END)
 
@@ -231,6 +257,8 @@ protected:
 	mutable array3D cached_v;
 
 	std::string m_name;
+	// Optional ephemeris table, shared among copies
+	boost::shared_ptr<ephemeris_table> m_table;
 
 };
 
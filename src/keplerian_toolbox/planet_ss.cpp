@@ -159,7 +159,7 @@ planet_ss::planet_ss(const std::string& name)
 	build_planet(epoch(2451545.0,epoch::JD),keplerian_elements_,mu_central_body_,mu_self_,radius_,safe_radius_,lower_case_name);
 }
 
-void planet_ss::get_eph(const epoch& when, array3D &r, array3D &v) const{
+void planet_ss::eph_impl(const epoch& when, array3D &r, array3D &v) const{
 	if (when.mjd2000() <=-73048.0 || when.mjd2000()>=18263.0) {
 		throw_value_error("Ephemeris of planet_ss are out of range [1800-2050]");
 	}
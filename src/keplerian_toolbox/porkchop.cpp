@@ -0,0 +1,308 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2009 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/ref.hpp>
+#include <boost/thread/thread.hpp>
+#include <cmath>
+#include <exception>
+#include <iomanip>
+#include <limits>
+
+#include "porkchop.h"
+#include "lambert_problem.h"
+#include "core_functions/array3D_operations.h"
+#include "exceptions.h"
+
+namespace kep_toolbox {
+
+/// Constructor
+/** Constructs the departure and arrival epoch grids and computes the pork-chop data.
+ *
+ * \param[in] departure planet at departure
+ * \param[in] arrival planet at arrival
+ * \param[in] t0_start first departure epoch
+ * \param[in] t0_end last departure epoch
+ * \param[in] n_t0 number of departure epochs
+ * \param[in] t1_start first arrival epoch
+ * \param[in] t1_end last arrival epoch
+ * \param[in] n_t1 number of arrival epochs
+ * \param[in] multi_revs maximum number of multiple revolutions to be considered (0 = only the direct transfer)
+ * \param[in] n_threads number of threads the grid rows are distributed on
+ *
+ * \throws value_error if the planets do not orbit the same body, if the grids are empty or not increasing, or if n_threads is zero.
+ * Ill-defined Lambert problems do not throw, the corresponding grid points are set to NaN.
+ */
+porkchop::porkchop(const planet &departure, const planet &arrival, const epoch &t0_start, const epoch &t0_end, const unsigned int &n_t0,
+	const epoch &t1_start, const epoch &t1_end, const unsigned int &n_t1, const int &multi_revs, const unsigned int &n_threads)
+	:m_mu(departure.get_mu_central_body()),m_multi_revs(multi_revs)
+{
+	if (departure.get_mu_central_body() != arrival.get_mu_central_body()) {
+		throw_value_error("Departure and arrival planets must orbit the same central body");
+	}
+	if (n_t0 == 0 || n_t1 == 0) {
+		throw_value_error("The number of departure and arrival epochs must be at least one");
+	}
+	if (t0_end.mjd2000() < t0_start.mjd2000() || t1_end.mjd2000() < t1_start.mjd2000()) {
+		throw_value_error("Epoch ranges must be increasing");
+	}
+	if (multi_revs < 0) {
+		throw_value_error("The number of multiple revolutions must be non negative");
+	}
+	if (n_threads == 0) {
+		throw_value_error("The number of threads must be at least one");
+	}
+	// Epoch grids and ephemerides, computed once per row / column. The planet objects
+	// cache their last ephemeris and are therefore only queried from this thread.
+	m_t0.resize(n_t0);
+	m_r0.resize(n_t0);
+	m_v0.resize(n_t0);
+	for (unsigned int i = 0; i < n_t0; ++i) {
+		m_t0[i] = (n_t0 == 1) ? t0_start.mjd2000() : t0_start.mjd2000() + i * (t0_end.mjd2000() - t0_start.mjd2000()) / (n_t0 - 1);
+		departure.get_eph(epoch(m_t0[i]),m_r0[i],m_v0[i]);
+	}
+	m_t1.resize(n_t1);
+	m_r1.resize(n_t1);
+	m_v1.resize(n_t1);
+	for (unsigned int j = 0; j < n_t1; ++j) {
+		m_t1[j] = (n_t1 == 1) ? t1_start.mjd2000() : t1_start.mjd2000() + j * (t1_end.mjd2000() - t1_start.mjd2000()) / (n_t1 - 1);
+		arrival.get_eph(epoch(m_t1[j]),m_r1[j],m_v1[j]);
+	}
+	m_dv_departure.resize(n_t0 * n_t1);
+	m_dv_arrival.resize(n_t0 * n_t1);
+	if (n_threads == 1) {
+		compute_rows(0,1);
+	} else {
+		// Errors in the worker threads are reported back and thrown from here
+		std::vector<std::string> errors(std::min(n_threads,n_t0));
+		boost::thread_group threads;
+		for (unsigned int k = 0; k < errors.size(); ++k) {
+			threads.create_thread(boost::bind(&porkchop::compute_rows_nothrow,this,k,n_threads,boost::ref(errors[k])));
+		}
+		threads.join_all();
+		for (unsigned int k = 0; k < errors.size(); ++k) {
+			if (!errors[k].empty()) {
+				throw_value_error(errors[k]);
+			}
+		}
+	}
+}
+
+// As compute_rows, but errors are reported in error instead of being thrown (to be run in a separate thread)
+void porkchop::compute_rows_nothrow(const unsigned int &first, const unsigned int &stride, std::string &error)
+{
+	try {
+		compute_rows(first,stride);
+	} catch (const std::exception &e) {
+		error = e.what();
+	} catch (...) {
+		error = "Unknown error while computing the porkchop grid";
+	}
+}
+
+// Computes the grid rows first, first + stride, first + 2 * stride, ...
+void porkchop::compute_rows(const unsigned int &first, const unsigned int &stride)
+{
+	const unsigned int n_t1 = m_t1.size();
+	std::vector<array3D> r1, v1, r2, v2;
+	std::vector<double> tof;
+	std::vector<unsigned int> idx;
+	std::vector<char> solved;
+	array3D dv1, dv2;
+	for (unsigned int i = first; i < m_t0.size(); i += stride) {
+		// Only arrival epochs after the departure are solved
+		r1.clear(); r2.clear(); tof.clear(); idx.clear();
+		for (unsigned int j = 0; j < n_t1; ++j) {
+			const double dt = (m_t1[j] - m_t0[i]) * ASTRO_DAY2SEC;
+			if (dt > 0) {
+				r1.push_back(m_r0[i]);
+				r2.push_back(m_r1[j]);
+				tof.push_back(dt);
+				idx.push_back(j);
+			} else {
+				m_dv_departure[i * n_t1 + j] = std::numeric_limits<double>::quiet_NaN();
+				m_dv_arrival[i * n_t1 + j] = std::numeric_limits<double>::quiet_NaN();
+			}
+		}
+		solved.assign(idx.size(),1);
+		try {
+			lambert_problem::solve_batch(v1,v2,r1,r2,tof,m_mu);
+		} catch (const std::exception &) {
+			// Some Lambert problem of the row is ill-defined: solve them one by one to find out which
+			v1.resize(idx.size());
+			v2.resize(idx.size());
+			for (unsigned int k = 0; k < idx.size(); ++k) {
+				try {
+					lambert_problem::solve(v1[k],v2[k],r1[k],r2[k],tof[k],m_mu);
+				} catch (const std::exception &) {
+					solved[k] = 0;
+				}
+			}
+		}
+		for (unsigned int k = 0; k < idx.size(); ++k) {
+			const unsigned int j = idx[k];
+			if (!solved[k]) {
+				m_dv_departure[i * n_t1 + j] = std::numeric_limits<double>::quiet_NaN();
+				m_dv_arrival[i * n_t1 + j] = std::numeric_limits<double>::quiet_NaN();
+				continue;
+			}
+			diff(dv1,v1[k],m_v0[i]);
+			diff(dv2,v2[k],m_v1[j]);
+			double dep = norm(dv1), arr = norm(dv2);
+			// Multiple revolutions are only possible if the non dimensional time of flight
+			// exceeds pi, in which case the full Lambert problem is solved
+			if (m_multi_revs > 0) {
+				diff(dv1,r2[k],r1[k]);
+				const double s = (norm(r1[k]) + norm(r2[k]) + norm(dv1)) / 2.;
+				if (tof[k] * std::sqrt(2 * m_mu / s / s / s) >= M_PI) {
+					lambert_problem lp(r1[k],r2[k],tof[k],m_mu,0,m_multi_revs);
+					for (std::vector<array3D>::size_type n = 1; n < lp.get_v1().size(); ++n) {
+						diff(dv1,lp.get_v1()[n],m_v0[i]);
+						diff(dv2,lp.get_v2()[n],m_v1[j]);
+						if (norm(dv1) + norm(dv2) < dep + arr) {
+							dep = norm(dv1);
+							arr = norm(dv2);
+						}
+					}
+				}
+			}
+			m_dv_departure[i * n_t1 + j] = dep;
+			m_dv_arrival[i * n_t1 + j] = arr;
+		}
+	}
+}
+
+/// Gets the number of departure epochs
+unsigned int porkchop::get_n_t0() const {
+	return m_t0.size();
+}
+
+/// Gets the number of arrival epochs
+unsigned int porkchop::get_n_t1() const {
+	return m_t1.size();
+}
+
+/// Gets the departure epochs (MJD2000)
+const std::vector<double>& porkchop::get_t0() const {
+	return m_t0;
+}
+
+/// Gets the arrival epochs (MJD2000)
+const std::vector<double>& porkchop::get_t1() const {
+	return m_t1;
+}
+
+/// Gets the departure hyperbolic excess velocities (row-major, departure epochs along the rows)
+const std::vector<double>& porkchop::get_dv_departure() const {
+	return m_dv_departure;
+}
+
+/// Gets the arrival hyperbolic excess velocities (row-major, departure epochs along the rows)
+const std::vector<double>& porkchop::get_dv_arrival() const {
+	return m_dv_arrival;
+}
+
+/// Gets the departure hyperbolic excess velocity at departure epoch i and arrival epoch j
+double porkchop::get_dv_departure(const unsigned int &i, const unsigned int &j) const {
+	if (i >= m_t0.size() || j >= m_t1.size()) {
+		throw_value_error("Grid index out of range");
+	}
+	return m_dv_departure[i * m_t1.size() + j];
+}
+
+/// Gets the arrival hyperbolic excess velocity at departure epoch i and arrival epoch j
+double porkchop::get_dv_arrival(const unsigned int &i, const unsigned int &j) const {
+	if (i >= m_t0.size() || j >= m_t1.size()) {
+		throw_value_error("Grid index out of range");
+	}
+	return m_dv_arrival[i * m_t1.size() + j];
+}
+
+/// Gets the departure C3 at departure epoch i and arrival epoch j
+double porkchop::get_c3(const unsigned int &i, const unsigned int &j) const {
+	const double dv = get_dv_departure(i,j);
+	return dv * dv;
+}
+
+/// Writes the grid as CSV
+/**
+ * One line per grid point with departure epoch (MJD2000), arrival epoch (MJD2000), time of flight (days),
+ * departure DV, arrival DV and departure C3 (SI units).
+ */
+void porkchop::write_csv(std::ostream &s) const {
+	s << "t0,t1,tof,dv_departure,dv_arrival,c3" << std::endl;
+	s << std::setprecision(14);
+	for (unsigned int i = 0; i < m_t0.size(); ++i) {
+		for (unsigned int j = 0; j < m_t1.size(); ++j) {
+			const double dv = m_dv_departure[i * m_t1.size() + j];
+			s << m_t0[i] << "," << m_t1[j] << "," << m_t1[j] - m_t0[i] << "," << dv << ","
+				<< m_dv_arrival[i * m_t1.size() + j] << "," << dv * dv << "\n";
+		}
+	}
+}
+
+/// Writes the grid in a compact binary format
+/**
+ * The stream (to be opened in binary mode) receives the 8 characters "PORKCHOP", the number of departure and arrival epochs
+ * as 32 bits unsigned integers, the departure epochs, the arrival epochs and the two row-major grids of departure and
+ * arrival DVs, all as native doubles.
+ */
+void porkchop::write_binary(std::ostream &s) const {
+	const boost::uint32_t n_t0 = m_t0.size(), n_t1 = m_t1.size();
+	s.write("PORKCHOP",8);
+	s.write(reinterpret_cast<const char *>(&n_t0),sizeof(n_t0));
+	s.write(reinterpret_cast<const char *>(&n_t1),sizeof(n_t1));
+	s.write(reinterpret_cast<const char *>(&m_t0[0]),sizeof(double) * m_t0.size());
+	s.write(reinterpret_cast<const char *>(&m_t1[0]),sizeof(double) * m_t1.size());
+	s.write(reinterpret_cast<const char *>(&m_dv_departure[0]),sizeof(double) * m_dv_departure.size());
+	s.write(reinterpret_cast<const char *>(&m_dv_arrival[0]),sizeof(double) * m_dv_arrival.size());
+}
+
+std::ostream &operator<<(std::ostream &s, const porkchop &pc) {
+	double best = std::numeric_limits<double>::infinity();
+	unsigned int bi = 0, bj = 0;
+	for (unsigned int i = 0; i < pc.get_n_t0(); ++i) {
+		for (unsigned int j = 0; j < pc.get_n_t1(); ++j) {
+			const double dv = pc.get_dv_departure(i,j) + pc.get_dv_arrival(i,j);
+			if (dv < best) {
+				best = dv;
+				bi = i;
+				bj = j;
+			}
+		}
+	}
+	s << std::setprecision(14) << "Pork-chop grid:" << std::endl;
+	s << "Departure epochs: " << pc.get_n_t0() << " [" << pc.get_t0().front() << ", " << pc.get_t0().back() << "] MJD2000" << std::endl;
+	s << "Arrival epochs: " << pc.get_n_t1() << " [" << pc.get_t1().front() << ", " << pc.get_t1().back() << "] MJD2000" << std::endl;
+	if (best < std::numeric_limits<double>::infinity()) {
+		s << "Best total DV: " << best << " (departure " << pc.get_t0()[bi] << ", arrival " << pc.get_t1()[bj] << ")" << std::endl;
+		s << "C3: " << pc.get_c3(bi,bj) << std::endl;
+	}
+	return s;
+}
+
+} //namespaces
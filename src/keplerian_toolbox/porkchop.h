@@ -0,0 +1,90 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2009 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef KEPLERIAN_TOOLBOX_PORKCHOP_H
+#define KEPLERIAN_TOOLBOX_PORKCHOP_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "planet.h"
+#include "epoch.h"
+#include "astro_constants.h"
+#include "config.h"
+
+namespace kep_toolbox {
+
+/// Pork-chop plot (launch window) grid
+/**
+ * This class scans a grid of departure and arrival epochs for a direct transfer between two planets
+ * orbiting the same central body. For each grid point a Lambert problem is solved and the hyperbolic excess
+ * velocities at departure and arrival are stored (the departure C3 is the square of the former).
+ *
+ * The ephemerides of the two planets are computed only once per grid row / column, the Lambert problems of each row
+ * are solved with lambert_problem::solve_batch() and rows are distributed among n_threads threads. When multiple
+ * revolutions are requested, they are only computed on those grid points where the time of flight is long enough to allow them,
+ * and the solution having the lowest total DV is retained.
+ *
+ * Grid points where the arrival epoch is not after the departure epoch, or whose Lambert problem is ill-defined
+ * (e.g. the direction of motion cannot be determined), are set to NaN.
+ *
+ * @author Dario Izzo (dario.izzo _AT_ googlemail.com)
+ */
+class __KEP_TOOL_VISIBLE porkchop
+{
+public:
+	porkchop(const planet &departure, const planet &arrival, const epoch &t0_start, const epoch &t0_end, const unsigned int &n_t0,
+		const epoch &t1_start, const epoch &t1_end, const unsigned int &n_t1, const int &multi_revs = 0, const unsigned int &n_threads = 1);
+	unsigned int get_n_t0() const;
+	unsigned int get_n_t1() const;
+	const std::vector<double>& get_t0() const;
+	const std::vector<double>& get_t1() const;
+	const std::vector<double>& get_dv_departure() const;
+	const std::vector<double>& get_dv_arrival() const;
+	double get_dv_departure(const unsigned int &i, const unsigned int &j) const;
+	double get_dv_arrival(const unsigned int &i, const unsigned int &j) const;
+	double get_c3(const unsigned int &i, const unsigned int &j) const;
+	void write_csv(std::ostream &) const;
+	void write_binary(std::ostream &) const;
+private:
+	void compute_rows(const unsigned int &first, const unsigned int &stride);
+	void compute_rows_nothrow(const unsigned int &first, const unsigned int &stride, std::string &error);
+
+	std::vector<double> m_t0;
+	std::vector<double> m_t1;
+	std::vector<array3D> m_r0, m_v0;
+	std::vector<array3D> m_r1, m_v1;
+	double m_mu;
+	int m_multi_revs;
+	// Row-major n_t0 x n_t1 grids
+	std::vector<double> m_dv_departure;
+	std::vector<double> m_dv_arrival;
+};
+
+__KEP_TOOL_VISIBLE std::ostream &operator<<(std::ostream &, const porkchop &);
+} //namespaces
+
+#endif // KEPLERIAN_TOOLBOX_PORKCHOP_H
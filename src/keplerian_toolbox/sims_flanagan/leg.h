@@ -25,9 +25,15 @@
 #ifndef LEG_H
 #define LEG_H
 
+#include <boost/array.hpp>
+#include <boost/bind.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/thread/thread.hpp>
 #include <boost/utility.hpp>
 #include <boost/type_traits/is_same.hpp>
+#include <algorithm>
 #include <iterator>
+#include <string>
 #include <vector>
 #include "spacecraft.h"
 #include "../core_functions/array3D_operations.h"
@@ -78,7 +84,7 @@ public:
 	* Default constructor. Constructs a meaningless leg that will need to be properly initialized
 	* using the various setters....
 	*/
-	leg():t_i(),x_i(),throttles(),t_f(),x_f(),m_sc(),m_mu(0),m_hf(false),m_tol(-10) {}
+	leg():t_i(),x_i(),throttles(),t_f(),x_f(),m_sc(),m_mu(0),m_hf(false),m_tol(-10),m_concurrent(false) {}
 
 	/// Constructs the leg from epochs, sc_states and cartesian components of throttles
 	/**
@@ -93,7 +99,7 @@ public:
 	*
 	*/
 	leg(const epoch& epoch_i, const sc_state& state_i, const std::vector<double>& thrott,
-	    const epoch& epoch_f, const sc_state& state_f, const spacecraft& sc, const double mu):m_sc(sc),m_hf(false),m_tol(-10) {
+	    const epoch& epoch_f, const sc_state& state_f, const spacecraft& sc, const double mu):m_sc(sc),m_hf(false),m_tol(-10),m_concurrent(false) {
 		set_leg(epoch_i, state_i,thrott.begin(),thrott.end(),epoch_f, state_f,mu);
 	}
 
@@ -288,6 +294,15 @@ public:
 	*/
 	void set_high_fidelity(bool state) { m_hf = state; }
 
+	/// Sets the concurrent propagation of the half legs
+	/**
+	* Activates the propagation of the backward half leg in a separate thread, concurrently with the forward
+	* half leg. Only used by the high-fidelity model, where each segment is numerically integrated, and
+	* worth it for legs with many segments.
+	*
+	*/
+	void set_concurrent(bool state) { m_concurrent = state; }
+
 
 	/** @name Getters*/
 	//@{
@@ -362,6 +377,7 @@ public:
 	*/
 	const sc_state& get_x_i() const {return x_i;}
 	bool get_high_fidelity() const { return m_hf; }
+	bool get_concurrent() const { return m_concurrent; }
 	//@}
 
 	/** @name Leg Feasibility*/
@@ -388,7 +404,142 @@ public:
 		}
 	}
 
+	/// Evaluate the jacobian of the state mismatch
+	/**
+	* Computes analytically the jacobian of the state mismatch returned by get_mismatch_con with respect to the initial
+	* sc_state, the cartesian components of the throttles and the final sc_state. The state transition matrices of the
+	* keplerian arcs (see propagate_lagrangian_stm) are chained with the jacobians of the impulses from the mid-point back
+	* to the two ends of the leg, so that the cost is linear in the number of segments. Only the impulsive model is supported.
+	*
+	* The jacobian is stored row-major, one row per mismatch component, with \f$ 7 + 3n + 7 \f$ columns corresponding to
+	* \f$ \mathbf r_i, \mathbf v_i, m_i, x_1,y_1,z_1, ..., x_n,y_n,z_n, \mathbf r_f, \mathbf v_f, m_f \f$.
+	*
+	* @param[out] begin iterator pointing to the beginning of the memory where the jacobian will be stored
+	* @param[out] end iterator pointing to the end of the memory where the jacobian will be stored
+	*
+	* @throws value_error if the high fidelity model is active or if the iterators distance is not \f$ 7 (14 + 3n) \f$
+	*/
+	template<typename it_type>
+	void get_mismatch_con_gradient(it_type begin, it_type end) const
+	{
+		if (m_hf) {
+			throw_value_error("The analytic jacobian of the state mismatch is not available for the high fidelity model");
+		}
+		if ((size_t)(end - begin) != 7 * (14 + 3 * throttles.size())) {
+			throw_value_error("Iterators distance is incompatible with the throttles size");
+		}
+		std::fill(begin,end,0.);
+		get_mismatch_con_gradient_half(begin,true);
+		get_mismatch_con_gradient_half(begin,false);
+	}
+
 protected:
+	// Accumulates in jac the contribution of the forward (first half of the segments, from x_i) or of the backward
+	// (second half, from x_f) half leg to the jacobian of the state mismatch (see get_mismatch_con_gradient)
+	template<typename it_type>
+	void get_mismatch_con_gradient_half(it_type jac, const bool &forward) const
+	{
+		const size_t n_seg = throttles.size();
+		const size_t n_seg_back = n_seg / 2, n_half = forward ? (n_seg + 1) / 2 : n_seg_back;
+		const size_t n_col = 14 + 3 * n_seg;
+		const double sign = forward ? 1. : -1.;
+		const double max_thrust = m_sc.get_thrust();
+		const double veff = m_sc.get_isp() * ASTRO_G0;
+
+		// Propagation, storing the state transition matrices of the arcs and the masses around the impulses
+		const sc_state &x0 = forward ? x_i : x_f;
+		array3D r = x0.get_position(), v = x0.get_velocity();
+		double m = x0.get_mass();
+		std::vector<boost::array<double,36> > stm(n_half + 1);
+		std::vector<double> m_before(n_half), m_after(n_half), c(n_half);
+		std::vector<bool> clamped(n_half,false);
+		double current_time = (forward ? t_i : t_f).mjd2000() * ASTRO_DAY2SEC;
+		for (size_t i = 0; i < n_half; ++i) {
+			const throttle &thr = forward ? throttles[i] : throttles[n_seg - i - 1];
+			const double thrust_duration = (thr.get_end().mjd2000() - thr.get_start().mjd2000()) * ASTRO_DAY2SEC;
+			const double manouver_time = (thr.get_start().mjd2000() + thr.get_end().mjd2000()) / 2. * ASTRO_DAY2SEC;
+			propagate_lagrangian_stm(r, v, manouver_time - current_time, m_mu, stm[i]);
+			current_time = manouver_time;
+			c[i] = sign * max_thrust * thrust_duration;
+			array3D dv;
+			for (int j = 0; j < 3; ++j) {
+				dv[j] = c[i] / m * thr.get_value()[j];
+			}
+			sum(v,v,dv);
+			m_before[i] = m;
+			m *= exp( -sign * norm(dv) / veff );
+			if (forward && m < 1) {
+				m = 1;
+				clamped[i] = true;
+			}
+			m_after[i] = m;
+		}
+
+		// Adjoint of the mismatch with respect to the current state (rows are the mismatch components)
+		double A[7][7];
+		for (int row = 0; row < 7; ++row) {
+			for (int col = 0; col < 7; ++col) {
+				A[row][col] = (row == col) ? sign : 0.;
+			}
+		}
+		if (forward) {
+			// Final keplerian arc, up to the epoch of the last backward impulse
+			double time_back = t_f.mjd2000() * ASTRO_DAY2SEC;
+			if (n_seg_back) {
+				const throttle &thr = throttles[n_seg - n_seg_back];
+				time_back = (thr.get_start().mjd2000() + thr.get_end().mjd2000()) / 2. * ASTRO_DAY2SEC;
+			}
+			propagate_lagrangian_stm(r, v, time_back - current_time, m_mu, stm[n_half]);
+			chain_stm(A,stm[n_half]);
+		}
+		for (size_t i = n_half; i-- > 0;) {
+			const size_t idx = forward ? i : n_seg - i - 1;
+			const array3D &u = throttles[idx].get_value();
+			const double u_norm = norm(u), dv_norm = std::fabs(c[i]) * u_norm / m_before[i];
+			// Impulse: v += c u / m, m *= exp(-sign |dv| / veff)
+			double dm_du[3] = {0., 0., 0.}, dm_dm = 0.;
+			if (!clamped[i]) {
+				dm_dm = m_after[i] / m_before[i] * (1 + sign * dv_norm / veff);
+				if (u_norm > 0) {
+					for (int j = 0; j < 3; ++j) {
+						dm_du[j] = - sign * m_after[i] * std::fabs(c[i]) / (m_before[i] * veff) * u[j] / u_norm;
+					}
+				}
+			}
+			for (int row = 0; row < 7; ++row) {
+				double dm = A[row][6] * dm_dm;
+				for (int j = 0; j < 3; ++j) {
+					jac[row * n_col + 7 + 3 * idx + j] += A[row][3 + j] * c[i] / m_before[i] + A[row][6] * dm_du[j];
+					dm -= A[row][3 + j] * c[i] * u[j] / (m_before[i] * m_before[i]);
+				}
+				A[row][6] = dm;
+			}
+			// Keplerian arc
+			chain_stm(A,stm[i]);
+		}
+		const size_t first_col = forward ? 0 : 7 + 3 * n_seg;
+		for (int row = 0; row < 7; ++row) {
+			for (int col = 0; col < 7; ++col) {
+				jac[row * n_col + first_col + col] += A[row][col];
+			}
+		}
+	}
+
+	// Right-multiplies the position-velocity block of the adjoint A by a state transition matrix
+	static void chain_stm(double A[7][7], const boost::array<double,36> &stm)
+	{
+		for (int row = 0; row < 7; ++row) {
+			double tmp[6];
+			for (int col = 0; col < 6; ++col) {
+				tmp[col] = 0.;
+				for (int k = 0; k < 6; ++k) {
+					tmp[col] += A[row][k] * stm[k * 6 + col];
+				}
+			}
+			std::copy(tmp,tmp + 6,A[row]);
+		}
+	}
+
 	template<typename it_type>
 	void get_mismatch_con_chemical(it_type begin, it_type end) const
 	{
@@ -466,48 +617,72 @@ protected:
 	}
 
 
-	template<typename it_type>
-	void get_mismatch_con_low_thrust(it_type begin, it_type end) const
+	// Propagates the forward (first half of the segments, from x_i) or backward (second half, from x_f) half leg
+	void propagate_half_low_thrust(array3D &r, array3D &v, double &m, const bool &forward, taylor_integrator &ti) const
 	{
-		assert(end - begin == 7);
-		(void)end;
-		size_t n_seg = throttles.size();
-		const int n_seg_fwd = (n_seg + 1) / 2, n_seg_back = n_seg / 2;
+		const size_t n_seg = throttles.size();
+		const size_t n_seg_half = forward ? (n_seg + 1) / 2 : n_seg / 2;
 
 		//Aux variables
 		double max_thrust = m_sc.get_thrust();
 		double veff = m_sc.get_isp()*ASTRO_G0;
 		array3D thrust;
+		ti.set_tolerances(m_tol,m_tol);
+
+		for (size_t i = 0; i < n_seg_half; i++) {
+			const throttle &thr = forward ? throttles[i] : throttles[n_seg - i - 1];
+			double thrust_duration = (thr.get_end().mjd2000() - thr.get_start().mjd2000()) * ASTRO_DAY2SEC;
+			for (int j=0;j<3;j++){
+				thrust[j] = max_thrust * thr.get_value()[j];
+			}
+			ti.propagate(r,v,m,thrust,forward ? thrust_duration : -thrust_duration,m_mu,veff);
+		}
+	}
+
+	// As above, but exceptions are stored in error instead of being thrown (to be run in a separate thread)
+	void propagate_half_low_thrust_nothrow(array3D &r, array3D &v, double &m, const bool &forward, taylor_integrator &ti, boost::exception_ptr &error) const
+	{
+		try {
+			propagate_half_low_thrust(r,v,m,forward,ti);
+		} catch (...) {
+			error = boost::current_exception();
+		}
+	}
+
+	template<typename it_type>
+	void get_mismatch_con_low_thrust(it_type begin, it_type end) const
+	{
+		assert(end - begin == 7);
+		(void)end;
 
 		//Initial state
 		array3D rfwd = x_i.get_position();
 		array3D vfwd = x_i.get_velocity();
 		double mfwd = x_i.get_mass();
 
-		//Forward Propagation
-		for (int i = 0; i < n_seg_fwd; i++) {
-			double thrust_duration = (throttles[i].get_end().mjd2000() -
-						  throttles[i].get_start().mjd2000()) * ASTRO_DAY2SEC;
-
-			for (int j=0;j<3;j++){
-				thrust[j] = max_thrust * throttles[i].get_value()[j];
-			}
-			propagate_taylor(rfwd,vfwd,mfwd,thrust,thrust_duration,m_mu,veff,m_tol,m_tol);
-		}
-
 		//Final state
 		array3D rback = x_f.get_position();
 		array3D vback = x_f.get_velocity();
 		double mback = x_f.get_mass();
 
-		//Backward Propagation
-		for (int i = 0; i < n_seg_back; i++) {
-			double thrust_duration = (throttles[throttles.size() - i - 1].get_end().mjd2000() -
-						  throttles[throttles.size() - i - 1].get_start().mjd2000()) * ASTRO_DAY2SEC;
-			for (int j=0;j<3;j++){
-				thrust[j] = max_thrust * throttles[throttles.size() - i - 1].get_value()[j];
+		//Forward and backward propagations (each with its own integrator workspace)
+		if (m_concurrent) {
+			boost::exception_ptr error;
+			boost::thread back(boost::bind(&leg::propagate_half_low_thrust_nothrow,this,boost::ref(rback),boost::ref(vback),boost::ref(mback),false,
+				boost::ref(m_taylor_back),boost::ref(error)));
+			try {
+				propagate_half_low_thrust(rfwd,vfwd,mfwd,true,m_taylor);
+			} catch (...) {
+				back.join();
+				throw;
 			}
-			propagate_taylor(rback,vback,mback,thrust,-thrust_duration,m_mu,veff,m_tol,m_tol);
+			back.join();
+			if (error) {
+				boost::rethrow_exception(error);
+			}
+		} else {
+			propagate_half_low_thrust(rfwd,vfwd,mfwd,true,m_taylor);
+			propagate_half_low_thrust(rback,vback,mback,false,m_taylor_back);
 		}
 
 		//Return the mismatch
@@ -593,6 +768,7 @@ private:
 			ar & m_mu;
 			ar & m_hf;
 			ar & m_tol;
+			ar & m_concurrent;
 		}
 // Serialization code (END)
 		epoch t_i;
@@ -604,6 +780,10 @@ private:
 		double m_mu;
 		bool m_hf;
 		int m_tol;
+		bool m_concurrent;
+		// Workspaces of the high fidelity forward and backward propagations (not serialized)
+		mutable taylor_integrator m_taylor;
+		mutable taylor_integrator m_taylor_back;
 	};
 
 std::ostream &operator<<(std::ostream &s, const leg &in );
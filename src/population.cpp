@@ -89,9 +89,9 @@ population::population(const problem::base &p, int n, const boost::uint32_t &see
 		m_container.back().best_x.resize(p_size);
 		m_container.back().best_c.resize(c_size);
 		m_container.back().best_f.resize(f_size);
-		// Initialise randomly the individual.
-		reinit(i);
 	}
+	// Initialise randomly the individuals.
+	reinit_batch(0,size);
 }
 
 /// Copy constructor.
@@ -217,10 +217,7 @@ double population::mean_velocity() const {
  */
 void population::reinit()
 {
-	for (size_type i = 0; i < size(); ++i)
-	{
-		reinit(i);
-	}
+	reinit_batch(0,size());
 }
 
 /// Re-initialise individual at position idx.
@@ -238,17 +235,7 @@ void population::reinit(const size_type &idx)
 	if (idx >= size()) {
 		pagmo_throw(index_error,"invalid index");
 	}
-	const decision_vector::size_type p_size = m_prob->get_dimension(), i_size = m_prob->get_i_dimension();
-	// Initialise randomly the continuous part of the decision vector.
-	for (decision_vector::size_type j = 0; j < p_size - i_size; ++j) {
-		m_container[idx].cur_x[j] = boost::uniform_real<double>(m_prob->get_lb()[j],m_prob->get_ub()[j])(m_drng);
-	}
-	// Initialise randomly the integer part of the decision vector.
-	for (decision_vector::size_type j = p_size - i_size; j < p_size; ++j) {
-		m_container[idx].cur_x[j] = boost::uniform_int<int>(m_prob->get_lb()[j],m_prob->get_ub()[j])(m_urng);
-	}
-	// Initialise randomly the velocity vector.
-	init_velocity(idx);
+	init_x(idx);
 	// Fill in the constraints.
 	m_prob->compute_constraints(m_container[idx].cur_c,m_container[idx].cur_x);
 	// Compute the fitness.
@@ -263,6 +250,50 @@ void population::reinit(const size_type &idx)
 	update_dom(idx);
 }
 
+// Re-initialise the individuals in the range [first,last[, computing their fitnesses with a single call
+// to problem::base::objfun_batch(). The random sequence and the final state are the same as calling
+// reinit() on each individual.
+void population::reinit_batch(const size_type &first, const size_type &last)
+{
+	pagmo_assert(first <= last && last <= size());
+	std::vector<decision_vector> x;
+	x.reserve(last - first);
+	for (size_type i = first; i < last; ++i) {
+		init_x(i);
+		x.push_back(m_container[i].cur_x);
+	}
+	std::vector<fitness_vector> f;
+	m_prob->objfun_batch(f,x);
+	for (size_type i = first; i < last; ++i) {
+		m_prob->compute_constraints(m_container[i].cur_c,m_container[i].cur_x);
+		m_container[i].cur_f.swap(f[i - first]);
+		m_container[i].best_x = m_container[i].cur_x;
+		m_container[i].best_f = m_container[i].cur_f;
+		m_container[i].best_c = m_container[i].cur_c;
+		update_champion(i);
+	}
+	// The domination lists are updated once all the individuals have their final values.
+	for (size_type i = first; i < last; ++i) {
+		update_dom(i);
+	}
+}
+
+// Init randomly the decision and velocity vectors of the individual in position idx.
+void population::init_x(const size_type &idx)
+{
+	const decision_vector::size_type p_size = m_prob->get_dimension(), i_size = m_prob->get_i_dimension();
+	// Initialise randomly the continuous part of the decision vector.
+	for (decision_vector::size_type j = 0; j < p_size - i_size; ++j) {
+		m_container[idx].cur_x[j] = boost::uniform_real<double>(m_prob->get_lb()[j],m_prob->get_ub()[j])(m_drng);
+	}
+	// Initialise randomly the integer part of the decision vector.
+	for (decision_vector::size_type j = p_size - i_size; j < p_size; ++j) {
+		m_container[idx].cur_x[j] = boost::uniform_int<int>(m_prob->get_lb()[j],m_prob->get_ub()[j])(m_urng);
+	}
+	// Initialise randomly the velocity vector.
+	init_velocity(idx);
+}
+
 
 /// Get constant reference to individual at position n.
 /**
@@ -919,6 +950,47 @@ void population::set_x(const size_type &idx, const decision_vector &x)
 	update_dom(idx);
 }
 
+/// Set the decision vectors of all the individuals.
+/**
+ * The i-th individual is given the decision vector x[i], with the same semantics as set_x(const size_type &, const decision_vector &).
+ * The fitnesses are computed with a single call to problem::base::objfun_batch().
+ *
+ * @param[in] x decision vectors, one per individual.
+ *
+ * @throws value_error if the number of decision vectors is different from the population size, or if problem::base::verify_x()
+ * returns false on any of them.
+ */
+void population::set_x(const std::vector<decision_vector> &x)
+{
+	if (x.size() != size()) {
+		pagmo_throw(value_error,"the number of decision vectors must be equal to the population size");
+	}
+	for (size_type i = 0; i < x.size(); ++i) {
+		if (!m_prob->verify_x(x[i])) {
+			pagmo_throw(value_error,"decision vector is not compatible with problem");
+		}
+	}
+	std::vector<fitness_vector> f;
+	m_prob->objfun_batch(f,x);
+	for (size_type i = 0; i < x.size(); ++i) {
+		m_container[i].cur_x = x[i];
+		m_container[i].cur_f.swap(f[i]);
+		m_prob->compute_constraints(m_container[i].cur_c,x[i]);
+		if (!m_container[i].best_x.size() ||
+			m_prob->compare_fc(m_container[i].cur_f,m_container[i].cur_c,m_container[i].best_f,m_container[i].best_c))
+		{
+			m_container[i].best_x = m_container[i].cur_x;
+			m_container[i].best_f = m_container[i].cur_f;
+			m_container[i].best_c = m_container[i].cur_c;
+		}
+		update_champion(i);
+	}
+	// The domination lists are updated once all the individuals have their final values.
+	for (size_type i = 0; i < x.size(); ++i) {
+		update_dom(i);
+	}
+}
+
 /// Erase individual idx
 /**
  * The individual occupying position idx in the population will be erased from the population.
@@ -220,6 +220,7 @@ class __PAGMO_VISIBLE population
 		std::vector<size_type> get_best_idx(const size_type & N) const;
 		size_type get_worst_idx() const;
 		void set_x(const size_type &, const decision_vector &);
+		void set_x(const std::vector<decision_vector> &);
 		void set_v(const size_type &, const decision_vector &);
 		void push_back(const decision_vector &);
 		void erase(const size_type &);
@@ -259,7 +260,9 @@ class __PAGMO_VISIBLE population
 		};
 
 	private:
+		void init_x(const size_type &);
 		void init_velocity(const size_type &);
+		void reinit_batch(const size_type &, const size_type &);
 		void update_champion(const size_type &);
 
 		// Multi-objective stuff
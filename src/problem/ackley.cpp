@@ -25,6 +25,7 @@
 #include <boost/math/constants/constants.hpp>
 #include <cmath>
 #include <string>
+#include <vector>
 
 
 #include "../exceptions.h"
@@ -73,6 +74,27 @@ void ackley::objfun_impl(fitness_vector &f, const decision_vector &x) const
 	f[0] = -20*exp(-0.2 * sqrt(1.0/n * s1))-exp(1.0/n*s2)+ 20 + nepero;
 }
 
+/// Implementation of the batch objective function.
+void ackley::objfun_batch_impl(std::vector<double> &f, const std::vector<double> &x, size_type n) const
+{
+	pagmo_assert(f.size() == n);
+	const size_type dim = get_dimension();
+	const double omega = 2.0 * M_PI;
+	const double nepero = exp(1.0);
+	std::vector<double> s1(n,0.0), s2(n,0.0);
+
+	for (size_type j = 0; j < dim; ++j) {
+		const double *xj = &x[j * n];
+		for (size_type i = 0; i < n; ++i) {
+			s1[i] += xj[i] * xj[i];
+			s2[i] += cos(omega * xj[i]);
+		}
+	}
+	for (size_type i = 0; i < n; ++i) {
+		f[i] = -20 * exp(-0.2 * sqrt(1.0 / dim * s1[i])) - exp(1.0 / dim * s2[i]) + 20 + nepero;
+	}
+}
+
 std::string ackley::get_name() const
 {
 	return "Ackley";
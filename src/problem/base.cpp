@@ -607,6 +607,172 @@ void base::objfun(fitness_vector &f, const decision_vector &x) const
 	}
 }
 
+/// Return fitness vectors of a batch of pagmo::decision_vector.
+/**
+ * Equivalent to calling objfun_batch() on a newly-created vector of fitness vectors.
+ *
+ * @param[in] x decision vectors whose fitnesses will be calculated.
+ *
+ * @return the fitness vectors of the decision vectors in x.
+ *
+ * @throws value_error if the dimension of at least one of the decision vectors is different from the problem's.
+ */
+std::vector<fitness_vector> base::objfun_batch(const std::vector<decision_vector> &x) const
+{
+	std::vector<fitness_vector> f;
+	objfun_batch(f,x);
+	return f;
+}
+
+/// Write fitnesses of a batch of pagmo::decision_vector into a vector of pagmo::fitness_vector.
+/**
+ * Will call objfun_batch_impl() once for the whole batch. The decision vectors are transposed into a contiguous
+ * structure-of-arrays block, so that problems reimplementing objfun_batch_impl() can evaluate all the candidates
+ * in loops running over contiguous memory. The caches are not searched, but they are refreshed with the last evaluated
+ * decision vectors, so that a following objfun() call on any of them will not trigger a new evaluation.
+ *
+ * @param[out] f fitness vectors to which the fitnesses will be written. It will be resized to the size of x.
+ * @param[in] x decision vectors whose fitnesses will be calculated.
+ *
+ * @throws value_error if the dimension of at least one of the decision vectors is different from the problem's,
+ * or if objfun_batch_impl() changed the dimension of the fitness block.
+ */
+void base::objfun_batch(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x) const
+{
+	const size_type n = x.size(), dim = get_dimension();
+	for (size_type i = 0; i < n; ++i) {
+		if (x[i].size() != dim) {
+			pagmo_throw(value_error,"wrong decision vector size when calling batch objective function");
+		}
+	}
+	f.resize(n);
+	if (!n) {
+		return;
+	}
+	// Transpose the decision vectors into a structure-of-arrays block.
+	std::vector<double> x_block(dim * n), f_block(m_f_dimension * n);
+	for (size_type i = 0; i < n; ++i) {
+		for (size_type j = 0; j < dim; ++j) {
+			x_block[j * n + i] = x[i][j];
+		}
+	}
+	objfun_batch_impl(f_block,x_block,n);
+	m_fevals += boost::numeric_cast<unsigned int>(n);
+	if (f_block.size() != m_f_dimension * n) {
+		pagmo_throw(value_error,"fitness dimension was changed inside objfun_batch_impl()");
+	}
+	for (size_type i = 0; i < n; ++i) {
+		f[i].resize(m_f_dimension);
+		for (f_size_type k = 0; k < m_f_dimension; ++k) {
+			f[i][k] = f_block[k * n + i];
+		}
+	}
+	// Refresh the caches with the last evaluated decision vectors.
+	for (size_type i = n - std::min<size_type>(n,cache_capacity); i < n; ++i) {
+		m_decision_vector_cache_f.push_front(x[i]);
+		m_fitness_vector_cache.push_front(f[i]);
+	}
+}
+
+/// Batch objective function implementation.
+/**
+ * Takes as input a block of n decision vectors stored as structure-of-arrays (the j-th component of the i-th decision vector
+ * is x[j * n + i]) and writes the fitnesses in the same layout into f (the k-th objective of the i-th decision vector
+ * is f[k * n + i]). f is already sized to get_f_dimension() * n. This function is not to be called directly, it is invoked
+ * by objfun_batch().
+ *
+ * The default implementation calls objfun_impl() on each decision vector of the block. Problems whose objective function
+ * can be computed with simple arithmetics should reimplement it with loops running over the candidates, which the compiler
+ * is able to vectorise. Loops calling transcendental functions (exp, cos, sin, ...) are not vectorised unless the compiler
+ * is allowed to use a vector math library (e.g., GCC with -ffast-math and glibc's libmvec): without it the batched version
+ * only saves the per-call overhead and benefits from the contiguous memory layout.
+ *
+ * @param[out] f fitness block into which the fitnesses will be written.
+ * @param[in] x decision vector block.
+ * @param[in] n number of decision vectors in the block.
+ */
+void base::objfun_batch_impl(std::vector<double> &f, const std::vector<double> &x, size_type n) const
+{
+	const size_type dim = get_dimension();
+	decision_vector tmp_x(dim);
+	fitness_vector tmp_f(m_f_dimension);
+	for (size_type i = 0; i < n; ++i) {
+		for (size_type j = 0; j < dim; ++j) {
+			tmp_x[j] = x[j * n + i];
+		}
+		objfun_impl(tmp_f,tmp_x);
+		if (tmp_f.size() != m_f_dimension) {
+			pagmo_throw(value_error,"fitness dimension was changed inside objfun_impl()");
+		}
+		for (f_size_type k = 0; k < m_f_dimension; ++k) {
+			f[k * n + i] = tmp_f[k];
+		}
+	}
+}
+
+/// Gradient of the objective function.
+/**
+ * Will write into grad the gradient of the (single) objective function at x, calling objfun_gradient_impl() internally.
+ *
+ * @param[out] grad vector to which the gradient will be written. It will be resized to the problem dimension.
+ * @param[in] x decision vector at which the gradient will be calculated.
+ *
+ * @throws value_error if x's dimension is different from the problem's, or if the problem is multi-objective.
+ */
+void base::objfun_gradient(decision_vector &grad, const decision_vector &x) const
+{
+	if (x.size() != get_dimension()) {
+		pagmo_throw(value_error,"wrong decision vector size when calling objective function gradient");
+	}
+	if (m_f_dimension != 1) {
+		pagmo_throw(value_error,"the gradient of the objective function is defined only for single-objective problems");
+	}
+	grad.resize(get_dimension());
+	objfun_gradient_impl(grad,x);
+}
+
+/// Availability of an analytic gradient.
+/**
+ * Default implementation returns false. Problems reimplementing objfun_gradient_impl() with an analytic expression
+ * should reimplement this method to return true, so that algorithms can prefer objfun_gradient() to their own
+ * numerical differentiation schemes.
+ *
+ * @return true if objfun_gradient() does not rely on numerical differentiation.
+ */
+bool base::has_analytic_gradient() const
+{
+	return false;
+}
+
+/// Objective function gradient implementation.
+/**
+ * Takes a pagmo::decision_vector x as input and writes the gradient of the objective function in grad (already sized to
+ * the problem dimension). This function is not to be called directly, it is invoked by objfun_gradient().
+ *
+ * The default implementation uses central differences with a step \f$ 10^{-8} \max(1,|x_i|) \f$ on every component.
+ *
+ * @param[out] grad gradient vector.
+ * @param[in] x decision vector.
+ */
+void base::objfun_gradient_impl(decision_vector &grad, const decision_vector &x) const
+{
+	const double h0 = 1e-8;
+	decision_vector dx(x);
+	fitness_vector f(1);
+	for (size_type i = 0; i < dx.size(); ++i) {
+		const double h = h0 * std::max(1.,std::fabs(dx[i]));
+		const double mem = dx[i];
+		dx[i] += h;
+		objfun(f,dx);
+		double central_diff = f[0];
+		dx[i] -= 2 * h;
+		objfun(f,dx);
+		central_diff = (central_diff - f[0]) / 2 / h;
+		grad[i] = central_diff;
+		dx[i] = mem;
+	}
+}
+
 /// Compare fitness vectors.
 /**
  * Will perform sanity checks on v_f1 and v_f2 and then will call base::compare_fitness_impl().
@@ -936,6 +1102,88 @@ constraint_vector base::compute_constraints(const decision_vector &x) const
 	return c;
 }
 
+/// Jacobian of the constraints.
+/**
+ * Will write into jac the jacobian of the constraint vector at x, calling constraints_gradient_impl() internally. The jacobian is
+ * stored row-major: the derivative of the i-th constraint with respect to the j-th component of x is jac[i * n + j], n being the
+ * problem dimension.
+ *
+ * @param[out] jac vector to which the jacobian will be written. It will be resized to the product of the constraint and problem dimensions.
+ * @param[in] x decision vector at which the jacobian will be calculated.
+ *
+ * @throws value_error if x's dimension is different from the problem's.
+ */
+void base::constraints_gradient(std::vector<double> &jac, const decision_vector &x) const
+{
+	if (x.size() != get_dimension()) {
+		pagmo_throw(value_error,"wrong decision vector size when calling constraints gradient");
+	}
+	jac.resize(get_c_dimension() * get_dimension());
+	if (!m_c_dimension) {
+		return;
+	}
+	constraints_gradient_impl(jac,x);
+}
+
+/// Availability of an analytic jacobian of the constraints.
+/**
+ * Default implementation returns false. Problems reimplementing constraints_gradient_impl() with analytic expressions
+ * should reimplement this method to return true, so that algorithms can prefer constraints_gradient() to their own
+ * numerical differentiation schemes.
+ *
+ * @return true if constraints_gradient() does not rely (entirely) on numerical differentiation.
+ */
+bool base::has_analytic_constraints_gradient() const
+{
+	return false;
+}
+
+/// Jacobian of the constraints implementation.
+/**
+ * Takes a pagmo::decision_vector x as input and writes the row-major jacobian of the constraints in jac (already sized). This function
+ * is not to be called directly, it is invoked by constraints_gradient().
+ *
+ * The default implementation uses central differences on every component of x (see estimate_constraints_gradient()).
+ *
+ * @param[out] jac jacobian of the constraints.
+ * @param[in] x decision vector.
+ */
+void base::constraints_gradient_impl(std::vector<double> &jac, const decision_vector &x) const
+{
+	estimate_constraints_gradient(jac,x,0,get_dimension());
+}
+
+/// Numerical jacobian of the constraints.
+/**
+ * Computes by central differences, with a step \f$ 10^{-8} \max(1,|x_j|) \f$, the columns j in [begin, end) of the row-major
+ * jacobian of the constraints, leaving the other columns untouched. Problems with an analytic expression for only part of the
+ * jacobian can use it for the remaining columns.
+ *
+ * @param[out] jac jacobian of the constraints (already sized).
+ * @param[in] x decision vector.
+ * @param[in] begin first column to compute.
+ * @param[in] end column after the last one to compute.
+ */
+void base::estimate_constraints_gradient(std::vector<double> &jac, const decision_vector &x, const size_type &begin, const size_type &end) const
+{
+	const double h0 = 1e-8;
+	const size_type n = get_dimension();
+	decision_vector dx(x);
+	constraint_vector c_plus(get_c_dimension()), c_minus(get_c_dimension());
+	for (size_type j = begin; j < end; ++j) {
+		const double h = h0 * std::max(1.,std::fabs(dx[j]));
+		const double mem = dx[j];
+		dx[j] += h;
+		compute_constraints(c_plus,dx);
+		dx[j] -= 2 * h;
+		compute_constraints(c_minus,dx);
+		for (c_size_type i = 0; i < c_plus.size(); ++i) {
+			jac[i * n + j] = (c_plus[i] - c_minus[i]) / 2 / h;
+		}
+		dx[j] = mem;
+	}
+}
+
 /// Test feasibility of decision vector.
 /**
  * This method will compute the constraint vector associated to x and test it with feasibility_c().
@@ -414,6 +414,8 @@ class __PAGMO_VISIBLE base
 		//@}
 		constraint_vector compute_constraints(const decision_vector &) const;
 		void compute_constraints(constraint_vector &, const decision_vector &) const;
+		void constraints_gradient(std::vector<double> &, const decision_vector &) const;
+		virtual bool has_analytic_constraints_gradient() const;
 		bool compare_constraints(const constraint_vector &, const constraint_vector &) const;
 		bool test_constraint(const constraint_vector &, const c_size_type &) const;
 		bool feasibility_x(const decision_vector &) const;
@@ -442,6 +444,8 @@ return base_ptr(new derived_problem(*this));
 	protected:
 		virtual bool equality_operator_extra(const base &) const;
 		virtual void compute_constraints_impl(constraint_vector &, const decision_vector &) const;
+		virtual void constraints_gradient_impl(std::vector<double> &, const decision_vector &) const;
+		void estimate_constraints_gradient(std::vector<double> &, const decision_vector &, const size_type &, const size_type &) const;
 		virtual bool compare_constraints_impl(const constraint_vector &, const constraint_vector &) const;
 		virtual bool compare_fc_impl(const fitness_vector &, const constraint_vector &, const fitness_vector &, const constraint_vector &) const;
 		void estimate_sparsity(const decision_vector &, int& lenG, std::vector<int>& iGfun, std::vector<int>& jGvar) const;
@@ -454,6 +458,10 @@ return base_ptr(new derived_problem(*this));
 		//@{
 		fitness_vector objfun(const decision_vector &) const;
 		void objfun(fitness_vector &, const decision_vector &) const;
+		std::vector<fitness_vector> objfun_batch(const std::vector<decision_vector> &) const;
+		void objfun_batch(std::vector<fitness_vector> &, const std::vector<decision_vector> &) const;
+		void objfun_gradient(decision_vector &, const decision_vector &) const;
+		virtual bool has_analytic_gradient() const;
 		bool compare_fitness(const fitness_vector &, const fitness_vector &) const;
 		void reset_caches() const;
 	public:
@@ -472,6 +480,8 @@ return base_ptr(new derived_problem(*this));
 		 * @param[in] x decision vector whose fitness will be calculated.
 		 */
 		virtual void objfun_impl(fitness_vector &f, const decision_vector &x) const = 0;
+		virtual void objfun_batch_impl(std::vector<double> &, const std::vector<double> &, size_type) const;
+		virtual void objfun_gradient_impl(decision_vector &, const decision_vector &) const;
 		//@}
 	private:
 		void normalise_bounds();
@@ -23,6 +23,7 @@
  *****************************************************************************/
 
 #include <boost/math/constants/constants.hpp>
+#include <boost/thread/locks.hpp>
 #include <boost/lexical_cast.hpp>
 #include <cmath>
 #include <string>
@@ -67,156 +68,188 @@ cec2013::cec2013(unsigned int fun_id, problem::base::size_type d, const std::str
 	data_file_name.append("M_D");
 	data_file_name.append(boost::lexical_cast<std::string>(d));
 	data_file_name.append(".txt");
-	// And we read all datas into m_rotation_matrix
-	{
-	std::ifstream data_file(data_file_name.c_str());
-	if (!data_file.is_open()) {
-		pagmo_throw(io_error, std::string("Error: file not found. I was looking for (") + data_file_name.c_str() + ")");
-	}
-	std::istream_iterator<double> start(data_file), end;
-	m_rotation_matrix = std::vector<double>(start,end);
-	data_file.close();
-	}
+	m_rotation_matrix = load_shared_data(data_file_name);
 
 	// We create the full file name for the shift vector
 	data_file_name = dir;
 	data_file_name.append("shift_data.txt");
-	// And we read all data into m_origin_shift
-	{
-	std::ifstream data_file(data_file_name.c_str());
-	if (!data_file.is_open()) {
-		pagmo_throw(io_error, std::string("Error: file not found. I was looking for ").append(data_file_name.c_str()));
-	}
-	std::istream_iterator<double> start(data_file), end;
-	m_origin_shift = std::vector<double>(start,end);
-	data_file.close();
-	}
+	m_origin_shift = load_shared_data(data_file_name);
+
 	// Set bounds. All CEC2013 problems have the same bounds
 	set_bounds(-100,100);
 }
 
+std::map<std::string, boost::weak_ptr<const std::vector<double> > > cec2013::m_data_registry;
+boost::mutex cec2013::m_data_mutex;
+
 /// Clone method.
 base_ptr cec2013::clone() const
 {
 	return base_ptr(new cec2013(*this));
 }
 
+// Returns the content of a data file, parsing it only if no other instance is currently holding it.
+cec2013::shared_data_ptr cec2013::load_shared_data(const std::string &file_name)
+{
+	boost::lock_guard<boost::mutex> lock(m_data_mutex);
+	shared_data_ptr retval = m_data_registry[file_name].lock();
+	if (retval) {
+		return retval;
+	}
+	std::ifstream data_file(file_name.c_str());
+	if (!data_file.is_open()) {
+		pagmo_throw(io_error, std::string("Error: file not found. I was looking for (") + file_name + ")");
+	}
+	std::istream_iterator<double> start(data_file), end;
+	retval = shared_data_ptr(new std::vector<double>(start,end));
+	m_data_registry[file_name] = retval;
+	return retval;
+}
+
+// Returns shared storage with the same content as v, reusing already loaded data when possible
+// (e.g. after deserialisation in a process which already constructed the same problem). Data seen for the first
+// time is registered as well, so that the following deserialised copies (e.g. in MPI workers) share it. v is left empty.
+cec2013::shared_data_ptr cec2013::intern_shared_data(std::vector<double> &v)
+{
+	boost::lock_guard<boost::mutex> lock(m_data_mutex);
+	typedef std::map<std::string, boost::weak_ptr<const std::vector<double> > >::iterator iterator;
+	for (iterator it = m_data_registry.begin(); it != m_data_registry.end();) {
+		shared_data_ptr candidate = it->second.lock();
+		if (!candidate) {
+			// Drop the data no instance is holding anymore.
+			m_data_registry.erase(it++);
+			continue;
+		}
+		if (*candidate == v) {
+			v.clear();
+			return candidate;
+		}
+		++it;
+	}
+	boost::shared_ptr<std::vector<double> > retval(new std::vector<double>());
+	retval->swap(v);
+	// Deserialised data has no file name: it is indexed by its address, unique while the data is alive.
+	m_data_registry["@" + boost::lexical_cast<std::string>(static_cast<const void *>(retval.get()))] = retval;
+	return retval;
+}
+
 /// Implementation of the objective function.
 void cec2013::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
 	size_type nx = get_dimension();
+	const double *Os = &(*m_origin_shift)[0], *Mr = &(*m_rotation_matrix)[0];
 	switch(m_problem_number)
 	{
 	case 1:
-		sphere_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		sphere_func(&x[0],&f[0],nx,Os,Mr,0);
 		f[0]+=-1400.0;
 		break;
 	case 2:
-		ellips_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		ellips_func(&x[0],&f[0],nx,Os,Mr,1);
 		f[0]+=-1300.0;
 		break;
 	case 3:
-		bent_cigar_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		bent_cigar_func(&x[0],&f[0],nx,Os,Mr,1);
 		f[0]+=-1200.0;
 		break;
 	case 4:
-		discus_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		discus_func(&x[0],&f[0],nx,Os,Mr,1);
 		f[0]+=-1100.0;
 		break;
 	case 5:
-		dif_powers_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		dif_powers_func(&x[0],&f[0],nx,Os,Mr,0);
 		f[0]+=-1000.0;
 		break;
 	case 6:
-		rosenbrock_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		rosenbrock_func(&x[0],&f[0],nx,Os,Mr,1);
 		f[0]+=-900.0;
 		break;
 	case 7:
-		schaffer_F7_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		schaffer_F7_func(&x[0],&f[0],nx,Os,Mr,1);
 		f[0]+=-800.0;
 		break;
 	case 8:
-		ackley_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		ackley_func(&x[0],&f[0],nx,Os,Mr,1);
 		f[0]+=-700.0;
 		break;
 	case 9:
-		weierstrass_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		weierstrass_func(&x[0],&f[0],nx,Os,Mr,1);
 		f[0]+=-600.0;
 		break;
 	case 10:
-		griewank_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		griewank_func(&x[0],&f[0],nx,Os,Mr,1);
 		f[0]+=-500.0;
 		break;
 	case 11:
-		rastrigin_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		rastrigin_func(&x[0],&f[0],nx,Os,Mr,0);
 		f[0]+=-400.0;
 		break;
 	case 12:
-		rastrigin_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		rastrigin_func(&x[0],&f[0],nx,Os,Mr,1);
 		f[0]+=-300.0;
 		break;
 	case 13:
-		step_rastrigin_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		step_rastrigin_func(&x[0],&f[0],nx,Os,Mr,1);
 		f[0]+=-200.0;
 		break;
 	case 14:
-		schwefel_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		schwefel_func(&x[0],&f[0],nx,Os,Mr,0);
 		f[0]+=-100.0;
 		break;
 	case 15:
-		schwefel_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		schwefel_func(&x[0],&f[0],nx,Os,Mr,1);
 		f[0]+=100.0;
 		break;
 	case 16:
-		katsuura_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		katsuura_func(&x[0],&f[0],nx,Os,Mr,1);
 		f[0]+=200.0;
 		break;
 	case 17:
-		bi_rastrigin_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		bi_rastrigin_func(&x[0],&f[0],nx,Os,Mr,0);
 		f[0]+=300.0;
 		break;
 	case 18:
-		bi_rastrigin_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		bi_rastrigin_func(&x[0],&f[0],nx,Os,Mr,1);
 		f[0]+=400.0;
 		break;
 	case 19:
-		grie_rosen_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		grie_rosen_func(&x[0],&f[0],nx,Os,Mr,1);
 		f[0]+=500.0;
 		break;
 	case 20:
-		escaffer6_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		escaffer6_func(&x[0],&f[0],nx,Os,Mr,1);
 		f[0]+=600.0;
 		break;
 	case 21:
-		cf01(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf01(&x[0],&f[0],nx,Os,Mr,1);
 		f[0]+=700.0;
 		break;
 	case 22:
-		cf02(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		cf02(&x[0],&f[0],nx,Os,Mr,0);
 		f[0]+=800.0;
 		break;
 	case 23:
-		cf03(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf03(&x[0],&f[0],nx,Os,Mr,1);
 		f[0]+=900.0;
 		break;
 	case 24:
-		cf04(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf04(&x[0],&f[0],nx,Os,Mr,1);
 		f[0]+=1000.0;
 		break;
 	case 25:
-		cf05(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf05(&x[0],&f[0],nx,Os,Mr,1);
 		f[0]+=1100.0;
 		break;
 	case 26:
-		cf06(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf06(&x[0],&f[0],nx,Os,Mr,1);
 		f[0]+=1200.0;
 		break;
 	case 27:
-		cf07(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf07(&x[0],&f[0],nx,Os,Mr,1);
 		f[0]+=1300.0;
 		break;
 	case 28:
-		cf08(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf08(&x[0],&f[0],nx,Os,Mr,1);
 		f[0]+=1400.0;
 		break;
 	default:
@@ -1057,14 +1090,28 @@ void cec2013::shiftfunc (const double *x, double *xshift, int nx, const double *
 
 void cec2013::rotatefunc (const double *x, double *xrot, int nx,const double *Mr) const
 {
-	int i,j;
-	for (i=0; i<nx; i++)
+	// Each row of Mr is contiguous in memory. The dot products are accumulated on four independent
+	// partial sums so that the inner loop is not serialised on a single accumulator and can be vectorised.
+	// NOTE: the order of the additions differs from the reference C implementation of the competition, so
+	// the fitness values differ from it at the level of rounding errors. Far from the optimum the asymmetric
+	// transformation and the oscillating terms (e.g. in Ackley's function) can amplify these differences.
+	for (int i = 0; i < nx; ++i)
 	{
-		xrot[i]=0;
-			for (j=0; j<nx; j++)
-			{
-				xrot[i]=xrot[i]+x[j]*Mr[i*nx+j];
-			}
+		const double *row = Mr + i * nx;
+		double s0 = 0., s1 = 0., s2 = 0., s3 = 0.;
+		int j = 0;
+		for (; j + 3 < nx; j += 4)
+		{
+			s0 += row[j] * x[j];
+			s1 += row[j + 1] * x[j + 1];
+			s2 += row[j + 2] * x[j + 2];
+			s3 += row[j + 3] * x[j + 3];
+		}
+		for (; j < nx; ++j)
+		{
+			s0 += row[j] * x[j];
+		}
+		xrot[i] = (s0 + s1) + (s2 + s3);
 	}
 }
 
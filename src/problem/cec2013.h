@@ -25,7 +25,12 @@
 #ifndef PAGMO_PROBLEM_CEC2013_H
 #define PAGMO_PROBLEM_CEC2013_H
 
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/weak_ptr.hpp>
+#include <map>
 #include <string>
+#include <vector>
 
 #include "../serialization.h"
 #include "../types.h"
@@ -46,6 +51,11 @@ namespace pagmo{ namespace problem {
  *
  * NOTE 2: all problems are unconstrained continuous single objective problems.
  *
+ * NOTE 3: the rotation matrices and shift vectors are parsed only once per process and per file:
+ * all the instances (clones, deserialised copies, problems living in different islands) share
+ * the same read-only storage. The rotations sum in a different order than the reference C code of the
+ * competition, so that the fitness values may differ from it at the level of rounding errors.
+ *
  * @see http://www.ntu.edu.sg/home/EPNSugan/index_files/CEC2013/CEC2013.htm
  *
  * @author Dario Izzo (dario.izzo@gmail.com)
@@ -65,7 +75,15 @@ class __PAGMO_VISIBLE cec2013 : public base
 		 * @returns the origin shift
 		 *
 		 */
-		std::vector<double> origin_shift() const {return m_origin_shift;}
+		std::vector<double> origin_shift() const {return *m_origin_shift;}
+		/// Returns the rotation matrices used by the problem
+		/**
+		 * The storage is shared among all the instances built from the same data.
+		 *
+		 * @returns a reference to the rotation matrices, stored row by row
+		 *
+		 */
+		const std::vector<double> &rotation_matrix() const {return *m_rotation_matrix;}
 		//@}
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
@@ -101,18 +119,44 @@ class __PAGMO_VISIBLE cec2013 : public base
 		void oszfunc (const double *, double *, int) const;
 		void cf_cal(const double *, double *, int, const double *,double *,double *,double *,int) const;
 
+		// Read-only data shared among all the instances.
+		typedef boost::shared_ptr<const std::vector<double> > shared_data_ptr;
+		static shared_data_ptr load_shared_data(const std::string &);
+		static shared_data_ptr intern_shared_data(std::vector<double> &);
+
 		friend class boost::serialization::access;
 		template <class Archive>
-		void serialize(Archive &ar, const unsigned int)
+		void save(Archive &ar, const unsigned int) const
+		{
+			ar << boost::serialization::base_object<base>(*this);
+			ar << m_problem_number;
+			ar << *m_rotation_matrix;
+			ar << *m_origin_shift;
+		}
+		template <class Archive>
+		void load(Archive &ar, const unsigned int)
 		{
-			ar & boost::serialization::base_object<base>(*this);
-			ar & const_cast<unsigned int&>(m_problem_number);
-			ar & m_rotation_matrix;
-			ar & m_origin_shift;
+			ar >> boost::serialization::base_object<base>(*this);
+			ar >> const_cast<unsigned int&>(m_problem_number);
+			std::vector<double> rotation_matrix, origin_shift;
+			ar >> rotation_matrix;
+			ar >> origin_shift;
+			m_rotation_matrix = intern_shared_data(rotation_matrix);
+			m_origin_shift = intern_shared_data(origin_shift);
 		}
+		template <class Archive>
+		void serialize(Archive &ar, const unsigned int version)
+		{
+			boost::serialization::split_member(ar, *this, version);
+		}
+
 	const unsigned int m_problem_number;
-	std::vector<double> m_rotation_matrix;
-	std::vector<double> m_origin_shift;
+	shared_data_ptr m_rotation_matrix;
+	shared_data_ptr m_origin_shift;
+
+	// Registry of the data files parsed so far, indexed by file name.
+	static std::map<std::string, boost::weak_ptr<const std::vector<double> > > m_data_registry;
+	static boost::mutex m_data_mutex;
 
 	// These are pre-allocated for speed, need not to be serialized
 	mutable std::vector<double> m_y;
@@ -22,7 +22,9 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 #include <boost/math/constants/constants.hpp>
 
 #include "../exceptions.h"
@@ -121,6 +123,142 @@ void dtlz::objfun_impl(fitness_vector &f, const decision_vector &x) const
 	}
 }
 
+/// Implementation of the batch objective function.
+/**
+ * The distance function is accumulated over the whole block first. Then, for DTLZ1 to DTLZ6, all the objectives are written as
+ * \f$ f_i = s \prod_{j < M - 1 - i} c_j \cdot s_{M - 1 - i} \f$ (the last factor being absent for \f$ i = 0 \f$), where the scale
+ * and the \f$ c_j \f$, \f$ s_j \f$ terms depend on the problem, and computed with loops running over the candidates.
+ */
+void dtlz::objfun_batch_impl(std::vector<double> &f, const std::vector<double> &x, size_type n) const
+{
+	const f_size_type M = get_f_dimension();
+	const size_type dim = get_dimension(), k = dim - (M - 1);
+	pagmo_assert(f.size() == M * n);
+
+	// computing distance-function
+	std::vector<double> g(n,0.0);
+	for (size_type j = M - 1; j < dim; ++j) {
+		const double *xj = &x[j * n];
+		switch(m_problem_number)
+		{
+		case 1:
+		case 3:
+			for (size_type i = 0; i < n; ++i) {
+				g[i] += pow(xj[i] - 0.5, 2) - cos(20 * boost::math::constants::pi<double>() * (xj[i] - 0.5));
+			}
+			break;
+		case 2:
+		case 4:
+		case 5:
+			for (size_type i = 0; i < n; ++i) {
+				g[i] += pow(xj[i] - 0.5, 2);
+			}
+			break;
+		case 6:
+			for (size_type i = 0; i < n; ++i) {
+				g[i] += pow(xj[i], 0.1);
+			}
+			break;
+		case 7:
+			for (size_type i = 0; i < n; ++i) {
+				g[i] += xj[i];
+			}
+			break;
+		default:
+			pagmo_throw(value_error, "Error: There are only 7 test functions in this test suite!");
+		}
+	}
+
+	if (m_problem_number == 7) {
+		double *f_last = &f[(M - 1) * n];
+		for (size_type i = 0; i < n; ++i) {
+			// +1.0 according to the original definition of the g-function for DTLZ7
+			g[i] = 1.0 + (9.0 / k) * g[i];
+			f_last[i] = 0.0;
+		}
+		// f_last accumulates the sum in the distribution function h.
+		for (f_size_type m = 0; m < M - 1; ++m) {
+			const double *xm = &x[m * n];
+			std::copy(xm, xm + n, f.begin() + m * n);
+			for (size_type i = 0; i < n; ++i) {
+				f_last[i] += (xm[i] / (1.0 + g[i])) * (1.0 + sin(3 * boost::math::constants::pi<double>() * xm[i]));
+			}
+		}
+		for (size_type i = 0; i < n; ++i) {
+			f_last[i] = (1.0 + g[i]) * (M - f_last[i]);
+		}
+		return;
+	}
+
+	// computing the scale and the c_j, s_j terms of the shape-functions
+	std::vector<double> scale(n), c((M - 1) * n), s((M - 1) * n);
+	if (m_problem_number == 1) {
+		for (size_type i = 0; i < n; ++i) {
+			scale[i] = 0.5 * (1.0 + 100.0 * (g[i] + k));
+		}
+	} else if (m_problem_number == 3) {
+		for (size_type i = 0; i < n; ++i) {
+			scale[i] = 1.0 + 100.0 * (g[i] + k);
+		}
+	} else {
+		for (size_type i = 0; i < n; ++i) {
+			scale[i] = 1.0 + g[i];
+		}
+	}
+	for (f_size_type m = 0; m < M - 1; ++m) {
+		const double *xm = &x[m * n];
+		double *cm = &c[m * n], *sm = &s[m * n];
+		switch(m_problem_number)
+		{
+		case 1:
+			for (size_type i = 0; i < n; ++i) {
+				cm[i] = xm[i];
+				sm[i] = 1 - xm[i];
+			}
+			break;
+		case 2:
+		case 3:
+			for (size_type i = 0; i < n; ++i) {
+				cm[i] = cos(xm[i] * PI_HALF);
+				sm[i] = sin(xm[i] * PI_HALF);
+			}
+			break;
+		case 4:
+			for (size_type i = 0; i < n; ++i) {
+				const double tmp = pow(xm[i], m_alpha) * PI_HALF;
+				cm[i] = cos(tmp);
+				sm[i] = sin(tmp);
+			}
+			break;
+		default:
+			// DTLZ5 and DTLZ6, the shape-functions are computed on the meta-variables theta.
+			for (size_type i = 0; i < n; ++i) {
+				const double theta = (m == 0) ? xm[i] : 1.0 / (2.0 * scale[i]) + ((g[i] * xm[i]) / scale[i]);
+				cm[i] = cos(theta * PI_HALF);
+				sm[i] = sin(theta * PI_HALF);
+			}
+		}
+	}
+
+	// computing shape-functions
+	for (f_size_type m = 0; m < M; ++m) {
+		double *fm = &f[m * n];
+		std::copy(scale.begin(), scale.end(), fm);
+		for (f_size_type j = 0; j < M - (m + 1); ++j) {
+			const double *cj = &c[j * n];
+			for (size_type i = 0; i < n; ++i) {
+				fm[i] *= cj[i];
+			}
+		}
+		if (m > 0) {
+			const double *sm = &s[(M - (m + 1)) * n];
+			for (size_type i = 0; i < n; ++i) {
+				fm[i] *= sm[i];
+			}
+		}
+	}
+}
+
 /// Implementations of the different g-functions used
 double dtlz::g13_func(const decision_vector &x) const
 {
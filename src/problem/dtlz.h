@@ -85,6 +85,7 @@ class __PAGMO_VISIBLE dtlz : public base_dtlz
 		std::string get_name() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
+		void objfun_batch_impl(std::vector<double> &, const std::vector<double> &, size_type) const;
 	private:
                 void f1_objfun_impl(fitness_vector &, const decision_vector &) const;
                 void f23_objfun_impl(fitness_vector &, const decision_vector &) const;
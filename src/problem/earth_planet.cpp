@@ -100,10 +100,20 @@ base_ptr earth_planet::clone() const
 	return base_ptr(new earth_planet(*this));
 }
 
+// Decodes the decision vector into the trajectory, unless it has already been decoded. The
+// objective function and the constraints are usually evaluated on the same decision vector.
+void earth_planet::decode(const decision_vector &x) const
+{
+	if (x != m_decoded_x) {
+		trajectory.init_from_full_vector(x.begin(),x.end(),encoding);
+		m_decoded_x = x;
+	}
+}
+
 /// Implementation of the objective function.
 void earth_planet::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
-	trajectory.init_from_full_vector(x.begin(),x.end(),encoding);
+	decode(x);
 	f[0] = trajectory.get_leg(0).evaluate_dv() / 1000;
 }
 
@@ -111,7 +121,7 @@ void earth_planet::objfun_impl(fitness_vector &f, const decision_vector &x) cons
 void earth_planet::compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
 {
 	// We decode the decision vector into a multiple fly-by trajectory
-	trajectory.init_from_full_vector(x.begin(),x.end(),encoding);
+	decode(x);
 
 	// We evaluate the state mismatch at the mid-point. And we use astronomical units to scale them
 	trajectory.evaluate_all_mismatch_con(c.begin(), c.begin() + 7);
@@ -55,6 +55,7 @@ class __PAGMO_VISIBLE earth_planet: public base
 		void compute_constraints_impl(constraint_vector &, const decision_vector &) const;
 		void set_sparsity(int &, std::vector<int> &, std::vector<int> &) const;
 	private:
+		void decode(const decision_vector &) const;
 		friend class boost::serialization::access;
 		template <class Archive>
 		void serialize(Archive &ar, const unsigned int)
@@ -64,11 +65,17 @@ class __PAGMO_VISIBLE earth_planet: public base
 			ar & trajectory;
 			ar & vmax;
 			ar & n_segments;
+			// The decode cache is not serialized: the trajectory is decoded again on the next evaluation.
+			if (Archive::is_loading::value) {
+				m_decoded_x.clear();
+			}
 		}
 		kep_toolbox::base_format encoding;
 		mutable kep_toolbox::sims_flanagan::fb_traj trajectory;
 		double vmax;
 		int n_segments;
+		// Decision vector the trajectory has been decoded from
+		mutable decision_vector m_decoded_x;
 };
 
 }} //namespaces
@@ -26,6 +26,7 @@
 #include <boost/integer_traits.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 #include <climits>
+#include <cmath>
 #include <cstddef>
 #include <exception>
 #include <iterator>
@@ -54,7 +55,8 @@ static inline int check_golomb_order(int n)
  * @param[in] n order of the Golomb ruler.
  * @param[in] m upper limit for the distance between consecutive marks.
  */
-golomb_ruler::golomb_ruler(int n, int m):base(check_golomb_order(n) - 1,n - 1,1,1,0),m_max_length(boost::numeric_cast<std::size_t>(m))
+golomb_ruler::golomb_ruler(int n, int m):base(check_golomb_order(n) - 1,n - 1,1,1,0),m_max_length(boost::numeric_cast<std::size_t>(m)),
+	m_tmp_length(0),m_tmp_duplicates(0)
 {
 	if (!m_max_length || m_max_length > static_cast<std::size_t>(INT_MAX)) {
 		pagmo_throw(value_error,"maximum distance between consecutive marks must be in the ]0,32767] range");
@@ -95,9 +97,9 @@ bool golomb_ruler::equality_operator_extra(const base &other) const
 void golomb_ruler::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
 	pagmo_assert(f.size() == 1 && x.size() == get_dimension());
-	compute_marks_and_dist(x);
+	compute_length_and_duplicates(x);
 	// Fitness is the maximum distance.
-	f[0] = *std::max_element(m_tmp_dist.begin(),m_tmp_dist.end());
+	f[0] = m_tmp_length;
 }
 
 /// Implementation of constraint calculation.
@@ -111,17 +113,25 @@ void golomb_ruler::objfun_impl(fitness_vector &f, const decision_vector &x) cons
 void golomb_ruler::compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
 {
 	pagmo_assert(c.size() == 1 && x.size() == get_dimension());
-	compute_marks_and_dist(x);
-	// Sort the vector of distances.
-	std::sort(m_tmp_dist.begin(),m_tmp_dist.end());
-	// Now compute how many duplicate distances are there.
-	c[0] = boost::numeric_cast<double>(m_tmp_dist.size()) - std::distance(m_tmp_dist.begin(),std::unique(m_tmp_dist.begin(),m_tmp_dist.end()));
+	compute_length_and_duplicates(x);
+	c[0] = m_tmp_duplicates;
+}
+
+// Number of bits set in a word.
+static inline unsigned popcount(unsigned long w)
+{
+	unsigned retval = 0;
+	for (; w; w &= w - 1) {
+		++retval;
+	}
+	return retval;
 }
 
-// Compute marks and distances of x and store them internally.
-void golomb_ruler::compute_marks_and_dist(const decision_vector &x) const
+// Compute length and number of duplicate distances of x and store them internally, so that objective function
+// and constraint are computed in a single pass.
+void golomb_ruler::compute_length_and_duplicates(const decision_vector &x) const
 {
-	// We already computed distances and marks of this decision vector, do not do anything.
+	// We already computed length and duplicates of this decision vector, do not do anything.
 	if (x == m_tmp_x) {
 		return;
 	}
@@ -129,19 +139,64 @@ void golomb_ruler::compute_marks_and_dist(const decision_vector &x) const
 	const size_type size = m_tmp_x.size(), marks_size =  size + 1;
 	m_tmp_marks.resize(marks_size);
 	m_tmp_marks[0] = 0;
+	// The bitset algorithm below needs strictly increasing marks at integer positions, i.e., positive integer distances
+	// between consecutive marks. This is the case for integer decision vectors within the bounds, with no coincident marks.
+	bool positive_integers = true;
 	// Write marks into temporary vector.
 	for (size_type i = 0; i < size; ++i) {
 		m_tmp_marks[i + 1] = m_tmp_marks[i] + m_tmp_x[i];
+		positive_integers = positive_integers && m_tmp_x[i] >= 1 && m_tmp_x[i] == std::floor(m_tmp_x[i]);
+	}
+	if (!positive_integers) {
+		compute_length_and_duplicates_exact();
+		return;
+	}
+	// Mark positions as a bitset: for each mark i, shifting the bitset right by the position of i yields the distances
+	// from i to the following marks. The distances already seen from the previous marks are accumulated in another
+	// bitset, and the duplicates are the bits common to the two.
+	const std::size_t bits = CHAR_BIT * sizeof(unsigned long), span = boost::numeric_cast<std::size_t>(m_tmp_marks.back()),
+		n_words = span / bits + 1;
+	m_tmp_bits.assign(2 * n_words,0ul);
+	unsigned long *marks = &m_tmp_bits[0], *seen = marks + n_words;
+	for (size_type i = 0; i < marks_size; ++i) {
+		const std::size_t pos = static_cast<std::size_t>(m_tmp_marks[i]);
+		marks[pos / bits] |= 1ul << (pos % bits);
 	}
-	// Clear distances vector.
+	double duplicates = 0;
+	for (size_type i = 0; i < marks_size - 1; ++i) {
+		const std::size_t pos = static_cast<std::size_t>(m_tmp_marks[i]), shift_words = pos / bits, shift_bits = pos % bits;
+		for (std::size_t w = 0; w + shift_words < n_words; ++w) {
+			unsigned long dist = marks[w + shift_words] >> shift_bits;
+			if (shift_bits && w + shift_words + 1 < n_words) {
+				dist |= marks[w + shift_words + 1] << (bits - shift_bits);
+			}
+			// The null distance of i from itself.
+			if (!w) {
+				dist &= ~1ul;
+			}
+			duplicates += popcount(dist & seen[w]);
+			seen[w] |= dist;
+		}
+	}
+	m_tmp_length = m_tmp_marks.back();
+	m_tmp_duplicates = duplicates;
+}
+
+// Length and number of duplicate distances by comparison of all the distances, for decision vectors not suitable for the bitset
+// algorithm (distances not integer, null or negative). Requires m_tmp_marks to be already filled in.
+void golomb_ruler::compute_length_and_duplicates_exact() const
+{
+	const size_type marks_size = m_tmp_marks.size();
 	m_tmp_dist.clear();
 	for (size_type i = 0; i < marks_size - 1; ++i) {
 		for (size_type j = i + 1; j < marks_size; ++j) {
-			const double tmp = m_tmp_marks[j] - m_tmp_marks[i];
-			pagmo_assert(tmp >= 0);
-			m_tmp_dist.push_back(tmp);
+			m_tmp_dist.push_back(m_tmp_marks[j] - m_tmp_marks[i]);
 		}
 	}
+	m_tmp_length = *std::max_element(m_tmp_dist.begin(),m_tmp_dist.end());
+	// Sort the vector of distances and compute how many duplicate distances are there.
+	std::sort(m_tmp_dist.begin(),m_tmp_dist.end());
+	m_tmp_duplicates = boost::numeric_cast<double>(m_tmp_dist.size()) - std::distance(m_tmp_dist.begin(),std::unique(m_tmp_dist.begin(),m_tmp_dist.end()));
 }
 
 std::string golomb_ruler::get_name() const
@@ -28,6 +28,8 @@
 #include <cstddef>
 #include <string>
 
+#include <vector>
+
 #include "../config.h"
 #include "../serialization.h"
 #include "../types.h"
@@ -64,26 +66,37 @@ class __PAGMO_VISIBLE golomb_ruler: public base
 		void compute_constraints_impl(constraint_vector &, const decision_vector &) const;
 		bool equality_operator_extra(const base &) const;
 	private:
-		void compute_marks_and_dist(const decision_vector &) const;
+		void compute_length_and_duplicates(const decision_vector &) const;
+		void compute_length_and_duplicates_exact() const;
 	private:
 		friend class boost::serialization::access;
 		template <class Archive>
-		void serialize(Archive &ar, const unsigned int)
+		void serialize(Archive &ar, const unsigned int version)
 		{
 			ar & boost::serialization::base_object<base>(*this);
 			ar & const_cast<std::size_t &>(m_max_length);
-			ar & m_tmp_x;
-			ar & m_tmp_marks;
-			ar & m_tmp_dist;
+			// Version 0 archives also stored the temporary marks and distances: skip them.
+			if (version == 0) {
+				decision_vector tmp_x, tmp_marks, tmp_dist;
+				ar & tmp_x;
+				ar & tmp_marks;
+				ar & tmp_dist;
+			}
 		}
-		const std::size_t	m_max_length;
-		mutable decision_vector	m_tmp_x;
-		mutable decision_vector	m_tmp_marks;
-		mutable decision_vector	m_tmp_dist;
+		const std::size_t		m_max_length;
+		// Length and duplicates of the last decision vector, and buffers pre-allocated for speed:
+		// need not to be serialized.
+		mutable decision_vector		m_tmp_x;
+		mutable decision_vector		m_tmp_marks;
+		mutable double			m_tmp_length;
+		mutable double			m_tmp_duplicates;
+		mutable std::vector<unsigned long>	m_tmp_bits;
+		mutable decision_vector		m_tmp_dist;
 };
 
 }}
 
 BOOST_CLASS_EXPORT_KEY(pagmo::problem::golomb_ruler)
+BOOST_CLASS_VERSION(pagmo::problem::golomb_ruler,1)
 
 #endif
@@ -24,6 +24,7 @@
 
 #include <boost/math/constants/constants.hpp>
 #include <cmath>
+#include <vector>
 
 #include "../exceptions.h"
 #include "../types.h"
@@ -67,6 +68,32 @@ void griewank::objfun_impl(fitness_vector &f, const decision_vector &x) const
 	f[0] = (retval/fr - p + 1);
 }
 
+/// Implementation of the batch objective function.
+void griewank::objfun_batch_impl(std::vector<double> &f, const std::vector<double> &x, size_type n) const
+{
+	pagmo_assert(f.size() == n);
+	const size_type dim = get_dimension();
+	const double fr = 4000.0;
+	std::vector<double> retval(n,0.0), p(n,1.0);
+
+	for (size_type j = 0; j < dim; ++j) {
+		const double *xj = &x[j * n];
+		for (size_type i = 0; i < n; ++i) {
+			retval[i] += xj[i] * xj[i];
+		}
+	}
+	for (size_type j = 0; j < dim; ++j) {
+		const double *xj = &x[j * n];
+		const double sj = sqrt(j + 1.0);
+		for (size_type i = 0; i < n; ++i) {
+			p[i] *= cos(xj[i] / sj);
+		}
+	}
+	for (size_type i = 0; i < n; ++i) {
+		f[i] = (retval[i] / fr - p[i] + 1);
+	}
+}
+
 std::string griewank::get_name() const
 {
 	return "Griewank";
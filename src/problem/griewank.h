@@ -57,6 +57,7 @@ class __PAGMO_VISIBLE griewank : public base
 		std::string get_name() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
+		void objfun_batch_impl(std::vector<double> &, const std::vector<double> &, size_type) const;
 	private:
 		friend class boost::serialization::access;
 		template <class Archive>
@@ -22,6 +22,7 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
 #include <string>
 
 #include <boost/integer_traits.hpp>
@@ -38,7 +39,7 @@
 #include "base.h"
 #include "gtoc5_flyby.h"
 #include "../keplerian_toolbox/astro_constants.h"
-#include "../keplerian_toolbox/asteroid_gtoc5.h"
+#include "../keplerian_toolbox/asteroid_catalogue.h"
 
 using namespace kep_toolbox;
 using namespace kep_toolbox::sims_flanagan;
@@ -48,7 +49,7 @@ namespace pagmo { namespace problem {
 
 gtoc5_flyby::gtoc5_flyby(int segments, int source, int flyby, int target, const double &lb_epoch, const double  &initial_mass, objective obj, const double & tof_ub, const double &ctol):
 	base(segments * 6 + 8, 0, 1, 14 + 2 * segments + 1, 2 * segments + 1,ctol),
-	m_n_segments(segments),m_source(source),m_flyby(flyby),m_target(target),m_lb_epoch(lb_epoch),m_initial_mass(initial_mass),m_obj(obj)
+	m_n_segments(segments),m_source(kep_toolbox::asteroid_ref(kep_toolbox::asteroid_catalogue::gtoc5(),source - 1)),m_flyby(kep_toolbox::asteroid_ref(kep_toolbox::asteroid_catalogue::gtoc5(),flyby - 1)),m_target(kep_toolbox::asteroid_ref(kep_toolbox::asteroid_catalogue::gtoc5(),target - 1)),m_lb_epoch(lb_epoch),m_initial_mass(initial_mass),m_obj(obj)
 {
 	std::vector<double> lb_v(get_dimension());
 	std::vector<double> ub_v(get_dimension());
@@ -148,6 +149,63 @@ void gtoc5_flyby::compute_constraints_impl(constraint_vector &c, const decision_
 	c[14 + 2 * m_n_segments] = (160000. - (x[5] * x[5] + x[6] * x[6] + x[7] * x[7])) / 160000.;
 }
 
+/// The jacobian of the constraints is analytic, except for the columns of the epochs.
+bool gtoc5_flyby::has_analytic_constraints_gradient() const
+{
+	return true;
+}
+
+// The columns of the starting epoch, of the flyby fraction and of the total duration, which move the ephemerides, are
+// computed by central differences. The masses, the relative velocity and the throttles enter the legs only through their
+// initial and final states and throttles.
+void gtoc5_flyby::constraints_gradient_impl(std::vector<double> &jac, const decision_vector &x) const
+{
+	const size_type n = get_dimension();
+	estimate_constraints_gradient(jac,x,0,3);
+	for (c_size_type i = 0; i < get_c_dimension(); ++i) {
+		std::fill(jac.begin() + i * n + 3,jac.begin() + (i + 1) * n,0.);
+	}
+	// Sets the legs at x.
+	constraint_vector c(get_c_dimension());
+	compute_constraints_impl(c,x);
+	// Non-dimensional units, as in compute_constraints_impl().
+	const double scale[7] = {1. / ASTRO_AU, 1. / ASTRO_AU, 1. / ASTRO_AU, 1. / ASTRO_EARTH_VELOCITY, 1. / ASTRO_EARTH_VELOCITY, 1. / ASTRO_EARTH_VELOCITY, 1. / m_leg1.get_spacecraft().get_mass()};
+	const int n_thr = 3 * m_n_segments, n_col = 14 + n_thr;
+	std::vector<double> leg_jac(7 * n_col);
+	for (int i = 0; i < 2; ++i) {
+		(i ? m_leg2 : m_leg1).get_mismatch_con_gradient(leg_jac.begin(),leg_jac.end());
+		for (int row = 0; row < 7; ++row) {
+			double *jac_row = &jac[(7 * i + row) * n];
+			const double *leg_row = &leg_jac[row * n_col];
+			// The mass at the flyby is the final mass of the first leg and (minus one kilogram) the initial mass
+			// of the second one, the final mass is the final mass of the second leg.
+			jac_row[3 + i] += leg_row[7 + n_thr + 6] * scale[row];
+			if (i == 1) {
+				jac_row[3] += leg_row[6] * scale[row];
+			}
+			// The relative velocity is added to the flyby velocity, at the end of the first leg and at the
+			// beginning of the second one.
+			for (int j = 0; j < 3; ++j) {
+				jac_row[5 + j] = (i ? leg_row[3 + j] : leg_row[7 + n_thr + 3 + j]) * scale[row];
+			}
+			for (int k = 0; k < n_thr; ++k) {
+				jac_row[8 + i * n_thr + k] = leg_row[7 + k] * scale[row];
+			}
+		}
+		// Throttles constraints.
+		for (int j = 0; j < m_n_segments; ++j) {
+			for (int k = 0; k < 3; ++k) {
+				const size_type col = 8 + i * n_thr + 3 * j + k;
+				jac[(14 + i * m_n_segments + j) * n + col] = 2 * x[col];
+			}
+		}
+	}
+	// Minimum flyby speed.
+	for (int j = 0; j < 3; ++j) {
+		jac[(14 + 2 * m_n_segments) * n + 5 + j] = -2 * x[5 + j] / 160000.;
+	}
+}
+
 /// Implementation of the sparsity structure: automated detection
 void gtoc5_flyby::set_sparsity(int &lenG, std::vector<int> &iGfun, std::vector<int> &jGvar) const
 {
@@ -184,8 +242,8 @@ std::string gtoc5_flyby::pretty(const decision_vector &x) const
 		epoch_target,sc_state(r_target,v_target,x[4]),ASTRO_MU_SUN);
 
 	std::ostringstream oss;
-	oss << m_leg1 << '\n' << m_source << '\n' << m_flyby << '\n';
-	oss << m_leg2 << '\n' << m_flyby << '\n' << m_target << '\n';
+	oss << m_leg1 << '\n' << *m_source.get_planet() << '\n' << *m_flyby.get_planet() << '\n';
+	oss << m_leg2 << '\n' << *m_flyby.get_planet() << '\n' << *m_target.get_planet() << '\n';
 	return oss.str();
 }
 
@@ -22,6 +22,7 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
 #include <string>
 
 #include <boost/integer_traits.hpp>
@@ -39,7 +40,7 @@
 #include "gtoc5_launch.h"
 #include "../keplerian_toolbox/sims_flanagan/codings.h"
 #include "../keplerian_toolbox/astro_constants.h"
-#include "../keplerian_toolbox/asteroid_gtoc5.h"
+#include "../keplerian_toolbox/asteroid_catalogue.h"
 
 using namespace kep_toolbox;
 using namespace kep_toolbox::sims_flanagan;
@@ -49,7 +50,7 @@ namespace pagmo { namespace problem {
 
 gtoc5_launch::gtoc5_launch(int segments, int target, objective obj, const double &ctol) :
 	base(segments * 3 + 6, 0, 1, 7 + segments + 1, segments + 1,ctol),
-	m_n_segments(segments),m_earth(),m_target(target),m_obj(obj)
+	m_n_segments(segments),m_earth(kep_toolbox::asteroid_catalogue::gtoc5(),7075),m_target(kep_toolbox::asteroid_ref(kep_toolbox::asteroid_catalogue::gtoc5(),target - 1)),m_obj(obj)
 {
 	std::vector<double> lb_v(get_dimension());
 	std::vector<double> ub_v(get_dimension());
@@ -129,6 +130,52 @@ void gtoc5_launch::compute_constraints_impl(constraint_vector &c, const decision
 	c[7 + m_n_segments] = (x[3]*x[3] + x[4]*x[4] + x[5]*x[5] - 25000000) / ASTRO_EARTH_VELOCITY / ASTRO_EARTH_VELOCITY;
 }
 
+/// The jacobian of the constraints is analytic, except for the columns of the epochs.
+bool gtoc5_launch::has_analytic_constraints_gradient() const
+{
+	return true;
+}
+
+// The columns of the launch epoch and of the leg duration, which move the ephemerides, are computed by central
+// differences. The final mass, the launch velocity and the throttles enter the leg only through its initial and final
+// states and throttles.
+void gtoc5_launch::constraints_gradient_impl(std::vector<double> &jac, const decision_vector &x) const
+{
+	const size_type n = get_dimension();
+	estimate_constraints_gradient(jac,x,0,2);
+	for (c_size_type i = 0; i < get_c_dimension(); ++i) {
+		std::fill(jac.begin() + i * n + 2,jac.begin() + (i + 1) * n,0.);
+	}
+	// Sets the leg at x.
+	constraint_vector c(get_c_dimension());
+	compute_constraints_impl(c,x);
+	// Non-dimensional units, as in compute_constraints_impl().
+	const double scale[7] = {1. / ASTRO_AU, 1. / ASTRO_AU, 1. / ASTRO_AU, 1. / ASTRO_EARTH_VELOCITY, 1. / ASTRO_EARTH_VELOCITY, 1. / ASTRO_EARTH_VELOCITY, 1. / m_leg.get_spacecraft().get_mass()};
+	const int n_thr = 3 * m_n_segments, n_col = 14 + n_thr;
+	std::vector<double> leg_jac(7 * n_col);
+	m_leg.get_mismatch_con_gradient(leg_jac.begin(),leg_jac.end());
+	for (int row = 0; row < 7; ++row) {
+		jac[row * n + 2] = leg_jac[row * n_col + 7 + n_thr + 6] * scale[row];
+		// The launch velocity is added to the initial velocity of the leg.
+		for (int j = 0; j < 3; ++j) {
+			jac[row * n + 3 + j] = leg_jac[row * n_col + 3 + j] * scale[row];
+		}
+		for (int k = 0; k < n_thr; ++k) {
+			jac[row * n + 6 + k] = leg_jac[row * n_col + 7 + k] * scale[row];
+		}
+	}
+	// Throttles constraints.
+	for (int j = 0; j < m_n_segments; ++j) {
+		for (int k = 0; k < 3; ++k) {
+			jac[(7 + j) * n + 6 + 3 * j + k] = 2 * x[6 + 3 * j + k];
+		}
+	}
+	// Launch velocity constraint.
+	for (int j = 0; j < 3; ++j) {
+		jac[(7 + m_n_segments) * n + 3 + j] = 2 * x[3 + j] / ASTRO_EARTH_VELOCITY / ASTRO_EARTH_VELOCITY;
+	}
+}
+
 /// Implementation of the sparsity structure: automated detection
 void gtoc5_launch::set_sparsity(int &lenG, std::vector<int> &iGfun, std::vector<int> &jGvar) const
 {
@@ -162,7 +209,7 @@ std::string gtoc5_launch::pretty(const decision_vector &x) const
 	m_leg.set_leg(epoch_i,sc_state(r0,v0,m_leg.get_spacecraft().get_mass()),x.begin() + 6, x.end(),epoch_f,sc_state(rf,vf,x[5]),ASTRO_MU_SUN);
 
 	std::ostringstream oss;
-	oss << m_leg << '\n' << m_earth << '\n' << m_target << '\n';
+	oss << m_leg << '\n' << *m_earth.get_planet() << '\n' << *m_target.get_planet() << '\n';
 	return oss.str();
 }
 
@@ -31,7 +31,7 @@
 #include "../config.h"
 #include "../serialization.h"
 #include "../types.h"
-#include "../keplerian_toolbox/asteroid_gtoc5.h"
+#include "../keplerian_toolbox/asteroid_catalogue.h"
 #include "../keplerian_toolbox/sims_flanagan/codings.h"
 #include "../keplerian_toolbox/sims_flanagan/fb_traj.h"
 #include "base.h"
@@ -58,10 +58,12 @@ class __PAGMO_VISIBLE gtoc5_launch: public base
 		std::string get_name() const;
 		/// A nice string representation of a chromosome
 		std::string pretty(const decision_vector &) const;
+		bool has_analytic_constraints_gradient() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 		void compute_constraints_impl(constraint_vector &, const decision_vector &) const;
 		void set_sparsity(int &, std::vector<int> &, std::vector<int> &) const;
+		void constraints_gradient_impl(std::vector<double> &, const decision_vector &) const;
 	private:
 		friend class boost::serialization::access;
 		template <class Archive>
@@ -69,14 +71,14 @@ class __PAGMO_VISIBLE gtoc5_launch: public base
 		{
 			ar & boost::serialization::base_object<base>(*this);
 			ar & m_n_segments;
-			ar & const_cast<kep_toolbox::asteroid_gtoc5 &>(m_earth);
-			ar & const_cast<kep_toolbox::asteroid_gtoc5 &>(m_target);
+			ar & const_cast<kep_toolbox::asteroid_ref &>(m_earth);
+			ar & const_cast<kep_toolbox::asteroid_ref &>(m_target);
 			ar & const_cast<objective &>(m_obj);
 			ar & m_leg;
 		}
 		int 						m_n_segments;
-		const kep_toolbox::asteroid_gtoc5 		m_earth;
-		const kep_toolbox::asteroid_gtoc5 		m_target;
+		const kep_toolbox::asteroid_ref 		m_earth;
+		const kep_toolbox::asteroid_ref 		m_target;
 		const objective					m_obj;
 		mutable kep_toolbox::sims_flanagan::leg		m_leg;
 };
@@ -51,10 +51,12 @@ class __PAGMO_VISIBLE gtoc5_rendezvous: public base
 		std::string get_name() const;
 		/// A nice string representation of a chromosome
 		std::string pretty(const decision_vector &) const;
+		bool has_analytic_constraints_gradient() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 		void compute_constraints_impl(constraint_vector &, const decision_vector &) const;
 		void set_sparsity(int &, std::vector<int> &, std::vector<int> &) const;
+		void constraints_gradient_impl(std::vector<double> &, const decision_vector &) const;
 	private:
 		friend class boost::serialization::access;
 		template <class Archive>
@@ -62,15 +64,15 @@ class __PAGMO_VISIBLE gtoc5_rendezvous: public base
 		{
 			ar & boost::serialization::base_object<base>(*this);
 			ar & m_n_segments;
-			ar & const_cast<kep_toolbox::asteroid_gtoc5 &>(m_source);
-			ar & const_cast<kep_toolbox::asteroid_gtoc5 &>(m_target);
+			ar & const_cast<kep_toolbox::asteroid_ref &>(m_source);
+			ar & const_cast<kep_toolbox::asteroid_ref &>(m_target);
 			ar & const_cast<double &>(m_lb_epoch);
 			ar & const_cast<double &>(m_initial_mass);
 			ar & m_leg;
 		}
 		int 						m_n_segments;
-		const kep_toolbox::asteroid_gtoc5 		m_source;
-		const kep_toolbox::asteroid_gtoc5 		m_target;
+		const kep_toolbox::asteroid_ref 		m_source;
+		const kep_toolbox::asteroid_ref 		m_target;
 		const double					m_lb_epoch;
 		const double					m_initial_mass;
 		mutable kep_toolbox::sims_flanagan::leg		m_leg;
@@ -22,6 +22,7 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
 #include <string>
 
 #include <boost/integer_traits.hpp>
@@ -38,7 +39,7 @@
 #include "base.h"
 #include "gtoc5_self_flyby.h"
 #include "../keplerian_toolbox/astro_constants.h"
-#include "../keplerian_toolbox/asteroid_gtoc5.h"
+#include "../keplerian_toolbox/asteroid_catalogue.h"
 
 using namespace kep_toolbox;
 using namespace kep_toolbox::sims_flanagan;
@@ -48,7 +49,7 @@ namespace pagmo { namespace problem {
 
 gtoc5_self_flyby::gtoc5_self_flyby(int segments, int ast_id, const double &mjd, const double  &initial_mass, const double &ctol):
 	base(segments * 3 + 5, 0, 1, 7 + segments + 1, segments + 1,ctol),
-	m_n_segments(segments),m_ast(ast_id),m_mjd(mjd),m_initial_mass(initial_mass)
+	m_n_segments(segments),m_ast(kep_toolbox::asteroid_ref(kep_toolbox::asteroid_catalogue::gtoc5(),ast_id - 1)),m_mjd(mjd),m_initial_mass(initial_mass)
 {
 	std::vector<double> lb_v(get_dimension());
 	std::vector<double> ub_v(get_dimension());
@@ -121,6 +122,51 @@ void gtoc5_self_flyby::compute_constraints_impl(constraint_vector &c, const deci
 	c[7 + m_n_segments] = (160000. - (x[2] * x[2] + x[3] * x[3] + x[4] * x[4]));
 }
 
+/// The jacobian of the constraints is analytic, except for the column of the time of flight.
+bool gtoc5_self_flyby::has_analytic_constraints_gradient() const
+{
+	return true;
+}
+
+// The column of the time of flight, which moves the ephemeris of the asteroid, is computed by central differences. The
+// final mass, the relative velocity and the throttles enter the leg only through its final state and throttles.
+void gtoc5_self_flyby::constraints_gradient_impl(std::vector<double> &jac, const decision_vector &x) const
+{
+	const size_type n = get_dimension();
+	estimate_constraints_gradient(jac,x,0,1);
+	for (c_size_type i = 0; i < get_c_dimension(); ++i) {
+		std::fill(jac.begin() + i * n + 1,jac.begin() + (i + 1) * n,0.);
+	}
+	// Sets the leg at x.
+	constraint_vector c(get_c_dimension());
+	compute_constraints_impl(c,x);
+	// Non-dimensional units, as in compute_constraints_impl().
+	const double scale[7] = {1. / ASTRO_AU, 1. / ASTRO_AU, 1. / ASTRO_AU, 1. / ASTRO_EARTH_VELOCITY, 1. / ASTRO_EARTH_VELOCITY, 1. / ASTRO_EARTH_VELOCITY, 1. / m_leg.get_spacecraft().get_mass()};
+	const int n_thr = 3 * m_n_segments, n_col = 14 + n_thr;
+	std::vector<double> leg_jac(7 * n_col);
+	m_leg.get_mismatch_con_gradient(leg_jac.begin(),leg_jac.end());
+	for (int row = 0; row < 7; ++row) {
+		jac[row * n + 1] = leg_jac[row * n_col + 7 + n_thr + 6] * scale[row];
+		// The relative velocity is added to the final velocity of the leg.
+		for (int j = 0; j < 3; ++j) {
+			jac[row * n + 2 + j] = leg_jac[row * n_col + 7 + n_thr + 3 + j] * scale[row];
+		}
+		for (int k = 0; k < n_thr; ++k) {
+			jac[row * n + 5 + k] = leg_jac[row * n_col + 7 + k] * scale[row];
+		}
+	}
+	// Throttles constraints.
+	for (int j = 0; j < m_n_segments; ++j) {
+		for (int k = 0; k < 3; ++k) {
+			jac[(7 + j) * n + 5 + 3 * j + k] = 2 * x[5 + 3 * j + k];
+		}
+	}
+	// Minimum flyby speed.
+	for (int j = 0; j < 3; ++j) {
+		jac[(7 + m_n_segments) * n + 2 + j] = -2 * x[2 + j];
+	}
+}
+
 /// Implementation of the sparsity structure: automated detection
 void gtoc5_self_flyby::set_sparsity(int &lenG, std::vector<int> &iGfun, std::vector<int> &jGvar) const
 {
@@ -154,7 +200,7 @@ std::string gtoc5_self_flyby::pretty(const decision_vector &x) const
 		epoch_target,sc_state(r_target,v_target,x[1]),ASTRO_MU_SUN);
 
 	std::ostringstream oss;
-	oss << m_leg << '\n' << m_ast << '\n';
+	oss << m_leg << '\n' << *m_ast.get_planet() << '\n';
 	return oss.str();
 }
 
@@ -23,6 +23,9 @@
 *****************************************************************************/
 
 #include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/thread/thread.hpp>
 #include <functional>
 #include <vector>
 #include <string>
@@ -49,20 +52,24 @@ namespace pagmo { namespace problem {
  * @param[in] ast4 id of the fourth asteroid to visit
  * @param[in] n_seg number of segments to be used per leg
  * @param[in] obj objective function in the enum {MASS,TIME,MASS_TIME}
+ * @param[in] n_threads number of threads used to evaluate the state mismatches of the four legs
  *
- * @throws value_error if the one or more asteroid belongs to the same group or if the
- * selected number of segments is negative
+ * @throws value_error if the one or more asteroid belongs to the same group, if the
+ * selected number of segments is negative or if n_threads is zero
  *
  * @see problem::base constructors.
  */
 
-gtoc_2::gtoc_2(int ast1, int ast2, int ast3, int ast4, int n_seg, objective obj):
+gtoc_2::gtoc_2(int ast1, int ast2, int ast3, int ast4, int n_seg, objective obj, unsigned int n_threads):
 	base(12 * n_seg + 15,0,1,7 * 4 + n_seg * 4 + 1, n_seg * 4 + 1, 1E-3),
-	m_n_seg(n_seg),m_spacecraft(1500.,.1,4000.),m_obj(obj)
+	m_n_seg(n_seg),m_spacecraft(1500.,.1,4000.),m_obj(obj),m_n_threads(n_threads)
 {
 	if (n_seg <= 0) {
 		pagmo_throw(value_error,"invalid number of segments");
 	}
+	if (n_threads == 0) {
+		pagmo_throw(value_error,"the number of threads must be at least one");
+	}
 	m_asteroids.push_back(asteroid_gtoc2(910));
 	m_asteroids.push_back(asteroid_gtoc2(ast1));
 	m_asteroids.push_back(asteroid_gtoc2(ast2));
@@ -139,8 +146,12 @@ void gtoc_2::objfun_impl(fitness_vector &f, const decision_vector &x) const
 	}
 }
 
-void gtoc_2::compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
+// Builds the legs from the decision vector, unless they have already been built from it.
+void gtoc_2::build_legs(const decision_vector &x) const
 {
+	if (x == m_legs_x) {
+		return;
+	}
 	// Cached values.
 	array3D r, v;
 	double initial_mass = m_spacecraft.get_mass();
@@ -176,9 +187,45 @@ void gtoc_2::compute_constraints_impl(constraint_vector &c, const decision_vecto
 			final_mass = x[9 + i];
 		}
 	}
+	m_legs_x = x;
+}
+
+// Computes the state mismatches of the legs [first, first + stride, ...). Exceptions are stored in error instead of
+// being thrown (to be run in a separate thread) and rethrown by the caller.
+static void legs_mismatch_con(const std::vector<leg> &legs, constraint_vector &c, const unsigned int first, const unsigned int stride, boost::exception_ptr &error)
+{
+	try {
+		for (unsigned int i = first; i < legs.size(); i += stride) {
+			legs[i].get_mismatch_con(c.begin() + 7 * i, c.begin() + 7 * (i + 1));
+		}
+	} catch (...) {
+		error = boost::current_exception();
+	}
+}
+
+void gtoc_2::compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
+{
+	build_legs(x);
 	// Load state mismatches into constraints vector.
+	if (m_n_threads > 1) {
+		// The legs are independent and can be evaluated concurrently.
+		std::vector<boost::exception_ptr> errors(std::min(m_n_threads,4u));
+		boost::thread_group threads;
+		for (unsigned int k = 0; k < errors.size(); ++k) {
+			threads.create_thread(boost::bind(&legs_mismatch_con,boost::cref(m_legs),boost::ref(c),k,std::min(m_n_threads,4u),boost::ref(errors[k])));
+		}
+		threads.join_all();
+		for (unsigned int k = 0; k < errors.size(); ++k) {
+			if (errors[k]) {
+				boost::rethrow_exception(errors[k]);
+			}
+		}
+	} else {
+		for (int i = 0; i < 4; ++i) {
+			m_legs[i].get_mismatch_con(c.begin() + 7 * i, c.begin() + 7 * (i + 1));
+		}
+	}
 	for (int i = 0; i < 4; ++i) {
-		m_legs[i].get_mismatch_con(c.begin() + 7 * i, c.begin() + 7 * (i + 1));
 		// Passing non-dimensional units to the solver.
 		for (int j = 0; j < 3; ++j) {
 			c[7 * i + j] /= ASTRO_AU;
@@ -194,6 +241,60 @@ void gtoc_2::compute_constraints_impl(constraint_vector &c, const decision_vecto
 	c.back() = (x[12] * x[12] + x[13] * x[13] + x[14] * x[14] - 3.5 * 3.5) / (ASTRO_EARTH_VELOCITY * ASTRO_EARTH_VELOCITY) * 1000000;
 }
 
+/// The jacobian of the constraints is analytic, except for the columns of the epochs.
+bool gtoc_2::has_analytic_constraints_gradient() const
+{
+	return true;
+}
+
+// The columns of the launch date and of the flight and waiting times, which move the epochs of the legs and the asteroids
+// ephemerides, are computed by central differences. All the others are analytic: the state mismatches depend on the masses,
+// on the launch vinf and on the throttles only through the legs' initial and final states and throttles.
+void gtoc_2::constraints_gradient_impl(std::vector<double> &jac, const decision_vector &x) const
+{
+	const size_type n = get_dimension();
+	estimate_constraints_gradient(jac,x,0,8);
+	for (c_size_type i = 0; i < get_c_dimension(); ++i) {
+		std::fill(jac.begin() + i * n + 8,jac.begin() + (i + 1) * n,0.);
+	}
+	build_legs(x);
+	// Non-dimensional units, as in compute_constraints_impl().
+	const double scale[7] = {1. / ASTRO_AU, 1. / ASTRO_AU, 1. / ASTRO_AU, 1. / ASTRO_EARTH_VELOCITY, 1. / ASTRO_EARTH_VELOCITY, 1. / ASTRO_EARTH_VELOCITY, 1. / 1500};
+	const int n_thr = 3 * m_n_seg, n_col = 14 + n_thr;
+	std::vector<double> leg_jac(7 * n_col);
+	for (int i = 0; i < 4; ++i) {
+		// Columns of the leg's jacobian: initial state, throttles, final state.
+		m_legs[i].get_mismatch_con_gradient(leg_jac.begin(),leg_jac.end());
+		for (int row = 0; row < 7; ++row) {
+			double *jac_row = &jac[(7 * i + row) * n];
+			const double *leg_row = &leg_jac[row * n_col];
+			if (i == 0) {
+				// Vinf (in km/s) is added to the initial velocity of the first leg, whose initial mass is fixed.
+				for (int j = 0; j < 3; ++j) {
+					jac_row[12 + j] = leg_row[3 + j] * 1000 * scale[row];
+				}
+			} else {
+				jac_row[8 + i - 1] += leg_row[6] * scale[row];
+			}
+			jac_row[8 + i] += leg_row[7 + n_thr + 6] * scale[row];
+			for (int k = 0; k < n_thr; ++k) {
+				jac_row[15 + i * n_thr + k] = leg_row[7 + k] * scale[row];
+			}
+		}
+		// Throttles constraints.
+		for (int j = 0; j < m_n_seg; ++j) {
+			for (int k = 0; k < 3; ++k) {
+				const size_type col = 15 + i * n_thr + 3 * j + k;
+				jac[(28 + i * m_n_seg + j) * n + col] = 2 * x[col];
+			}
+		}
+	}
+	// Vinf constraint.
+	for (int j = 0; j < 3; ++j) {
+		jac[(get_c_dimension() - 1) * n + 12 + j] = 2 * x[12 + j] / (ASTRO_EARTH_VELOCITY * ASTRO_EARTH_VELOCITY) * 1000000;
+	}
+}
+
 /// Implementation of the sparsity structure: automated detection
 //void gtoc_2::set_sparsity(int &lenG, std::vector<int> &iGfun, std::vector<int> &jGvar) const
 // {
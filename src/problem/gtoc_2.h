@@ -51,16 +51,19 @@ class __PAGMO_VISIBLE gtoc_2: public base
 		/// The objective function can be defined as final mass, final time or mass/time
 		enum objective {MASS,TIME,MASS_TIME};
 		/// Constructor
-		gtoc_2(int = 815, int = 300, int = 110, int = 47, int = 10, objective = MASS_TIME);
+		gtoc_2(int = 815, int = 300, int = 110, int = 47, int = 10, objective = MASS_TIME, unsigned int = 1);
 		base_ptr clone() const;
 		//void set_sparsity(int &, std::vector<int> &, std::vector<int> &) const;
 		std::string get_name() const;
 		std::string pretty(const std::vector<double> &x) const;
+		bool has_analytic_constraints_gradient() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 		void compute_constraints_impl(constraint_vector &, const decision_vector &) const;
+		void constraints_gradient_impl(std::vector<double> &, const decision_vector &) const;
 		std::string human_readable_extra() const;
 	private:
+		void build_legs(const decision_vector &) const;
 		template <class Iterator>
 		kep_toolbox::sims_flanagan::throttle get_nth_throttle(int n, Iterator it, const kep_toolbox::epoch &start, const kep_toolbox::epoch &end) const
 		{
@@ -82,12 +85,20 @@ class __PAGMO_VISIBLE gtoc_2: public base
 			ar & m_legs;
 			ar & const_cast< kep_toolbox::sims_flanagan::spacecraft &>(m_spacecraft);
 			ar & m_obj;
+			ar & m_n_threads;
+			// The legs cache is not serialized: it is rebuilt on the next evaluation.
+			if (Archive::is_loading::value) {
+				m_legs_x.clear();
+			}
 		}
 		const int								m_n_seg;
 		std::vector< kep_toolbox::asteroid_gtoc2>				m_asteroids;
 		mutable std::vector< kep_toolbox::sims_flanagan::leg>			m_legs;
 		const kep_toolbox::sims_flanagan::spacecraft				m_spacecraft;
 		objective								m_obj;
+		unsigned int								m_n_threads;
+		// Decision vector the legs have been built from
+		mutable decision_vector							m_legs_x;
 };
 
 } } // namespaces
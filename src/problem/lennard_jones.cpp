@@ -22,9 +22,12 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
 #include <boost/math/constants/constants.hpp>
 #include <cmath>
+#include <sstream>
 #include <string>
+#include <typeinfo>
 #include <vector>
 
 #include "../exceptions.h"
@@ -39,14 +42,20 @@ namespace pagmo { namespace problem {
  * Will construct a Lennard-Jones problem
  *
  * @param[in] atoms number of atoms
+ * @param[in] cutoff cutoff radius. Pairs of atoms further apart are neglected. If zero (default), all the pairs are considered.
+ * With a cutoff, the pair potential is shifted by a constant so that it vanishes at the cutoff radius: the energy is then
+ * continuous, but differs from the all-pairs one by the shift times the number of pairs within the cutoff.
  *
  * @see problem::base constructors.
  */
-lennard_jones::lennard_jones(int atoms):base(3*atoms-6)
+lennard_jones::lennard_jones(int atoms, const double &cutoff):base(3*atoms-6),m_cutoff(cutoff),m_pos(3*atoms),m_grad(3*atoms)
 {
 	if (atoms <= 0 || atoms < 3) {
 		pagmo_throw(value_error,"number of atoms for lennard-jones problem must be positive and greater than 2");
 	}
+	if (cutoff < 0) {
+		pagmo_throw(value_error,"cutoff radius for lennard-jones problem must be non-negative");
+	}
 	for (int i = 0; i < 3*atoms-6; i++) {
 		if ( (i != 0) && (i % 3) == 0 ) {
 			set_lb(i,0.0);
@@ -85,29 +94,212 @@ double lennard_jones::r(const int& atom, const int& coord, const std::vector<dou
 	}
 }
 
-/// Implementation of the objective function.
-void lennard_jones::objfun_impl(fitness_vector &f, const decision_vector &x) const
+// Computes the potential (without the factor 4) and, if grad is not null, its gradient with respect to the decision vector.
+// The positions are first unpacked into m_pos, so that the pair loops run over contiguous memory without pow() calls.
+double lennard_jones::potential(const decision_vector &x, decision_vector *grad) const
 {
-	pagmo_assert(f.size() == 1);
-	std::vector<double>::size_type n = x.size();
-	int atoms = (n + 6) / 3;
-	double sixth, dist;
-
-	f[0] = 0;
-	//We evaluate the potential
-	for ( int i=0; i<(atoms-1); i++ ) {
-		for ( int j=(i+1); j<atoms; j++ ) {
-			dist = pow(r(i, 0, x) - r(j, 0, x), 2) + pow(r(i, 1, x) - r(j, 1, x), 2) + pow(r(i, 2, x) - r(j, 2, x), 2);  //rij^2
-			if ( dist == 0.0 ) {
-				f[0] = 1e+20;	//penalty
+	const int atoms = (x.size() + 6) / 3;
+	// The buffers are not serialized, make sure they fit the decision vector (no-op in steady state).
+	m_pos.resize(3 * atoms);
+	m_grad.resize(3 * atoms);
+	double *px = &m_pos[0], *py = px + atoms, *pz = py + atoms;
+	for (int i = 0; i < atoms; ++i) {
+		px[i] = r(i, 0, x);
+		py[i] = r(i, 1, x);
+		pz[i] = r(i, 2, x);
+	}
+	if (grad) {
+		std::fill(m_grad.begin(),m_grad.end(),0.0);
+	}
+
+	double retval;
+	bool overlap = false;
+	if (m_cutoff > 0) {
+		retval = potential_cells(grad, overlap);
+	} else {
+		double *gx = &m_grad[0], *gy = gx + atoms, *gz = gy + atoms;
+		retval = 0;
+		for (int i = 0; i < atoms - 1; ++i) {
+			const double xi = px[i], yi = py[i], zi = pz[i];
+			double e = 0, gxi = 0, gyi = 0, gzi = 0;
+			if (grad) {
+				for (int j = i + 1; j < atoms; ++j) {
+					const double dx = xi - px[j], dy = yi - py[j], dz = zi - pz[j];
+					const double dist = dx * dx + dy * dy + dz * dz; //rij^2
+					overlap = overlap || (dist == 0.0);
+					const double inv = 1.0 / dist, sixth = inv * inv * inv; //rij^-6
+					e += sixth * sixth - sixth;
+					// dV/drij^2 / rij * 2, projected on the components
+					const double coeff = (6.0 * sixth - 12.0 * sixth * sixth) * inv;
+					gxi += coeff * dx;
+					gyi += coeff * dy;
+					gzi += coeff * dz;
+					gx[j] -= coeff * dx;
+					gy[j] -= coeff * dy;
+					gz[j] -= coeff * dz;
+				}
+				gx[i] += gxi;
+				gy[i] += gyi;
+				gz[i] += gzi;
+			} else {
+				for (int j = i + 1; j < atoms; ++j) {
+					const double dx = xi - px[j], dy = yi - py[j], dz = zi - pz[j];
+					const double dist = dx * dx + dy * dy + dz * dz; //rij^2
+					overlap = overlap || (dist == 0.0);
+					const double inv = 1.0 / dist, sixth = inv * inv * inv; //rij^-6
+					e += sixth * sixth - sixth;
+				}
 			}
-			else {
-				sixth = pow(dist, -3);	//rij^-6
-				f[0] += (pow(sixth, 2) - sixth);
+			retval += e;
+		}
+	}
+	if (overlap) {
+		retval = 1e+20;	//penalty
+		// The penalty is flat: return a null (finite) gradient instead of the infinities of the coincident pairs.
+		if (grad) {
+			std::fill(m_grad.begin(),m_grad.end(),0.0);
+		}
+	}
+
+	if (grad) {
+		// Map the gradient on the atoms positions back on the decision vector (see r()).
+		const double *gx = &m_grad[0], *gy = gx + atoms, *gz = gy + atoms;
+		decision_vector &g = *grad;
+		g[0] = gz[1];
+		g[1] = gy[2];
+		g[2] = gz[2];
+		for (int i = 3; i < atoms; ++i) {
+			g[3 * (i - 2)] = gx[i];
+			g[3 * (i - 2) + 1] = gy[i];
+			g[3 * (i - 2) + 2] = gz[i];
+		}
+	}
+	return retval;
+}
+
+// Potential and gradient with a cutoff radius, finding the interacting pairs through a cell list.
+// Requires m_pos to be already filled in. Coincident atoms are signalled through overlap.
+double lennard_jones::potential_cells(decision_vector *grad, bool &overlap) const
+{
+	const int atoms = m_pos.size() / 3;
+	const double *p[3] = {&m_pos[0], &m_pos[atoms], &m_pos[2 * atoms]};
+	double *g[3] = {&m_grad[0], &m_grad[atoms], &m_grad[2 * atoms]};
+	const double cutoff2 = m_cutoff * m_cutoff;
+	// Value of the pair potential at the cutoff radius, subtracted from each pair.
+	const double sixth_cut = 1.0 / (cutoff2 * cutoff2 * cutoff2), shift = sixth_cut * sixth_cut - sixth_cut;
+
+	// Cells of side at least m_cutoff over the bounding box of the cluster.
+	double min[3], size[3];
+	int n_cells[3];
+	for (int k = 0; k < 3; ++k) {
+		min[k] = *std::min_element(p[k], p[k] + atoms);
+		const double extent = *std::max_element(p[k], p[k] + atoms) - min[k];
+		n_cells[k] = std::max(1, std::min(atoms, static_cast<int>(extent / m_cutoff)));
+	}
+	// For sparse clusters, cap the total number of cells at about the number of atoms (larger cells are still valid).
+	const double total = static_cast<double>(n_cells[0]) * n_cells[1] * n_cells[2];
+	if (total > atoms) {
+		const double shrink = std::pow(total / atoms, 1. / 3.);
+		for (int k = 0; k < 3; ++k) {
+			n_cells[k] = std::max(1, static_cast<int>(n_cells[k] / shrink));
+		}
+	}
+	for (int k = 0; k < 3; ++k) {
+		const double extent = *std::max_element(p[k], p[k] + atoms) - min[k];
+		size[k] = (extent > 0) ? extent / n_cells[k] : 1.0;
+	}
+	m_cell_head.assign(n_cells[0] * n_cells[1] * n_cells[2], -1);
+	m_cell_next.resize(atoms);
+	m_cell_of.resize(atoms);
+	for (int i = 0; i < atoms; ++i) {
+		int c[3];
+		for (int k = 0; k < 3; ++k) {
+			c[k] = std::min(n_cells[k] - 1, static_cast<int>((p[k][i] - min[k]) / size[k]));
+		}
+		m_cell_of[i] = (c[2] * n_cells[1] + c[1]) * n_cells[0] + c[0];
+		m_cell_next[i] = m_cell_head[m_cell_of[i]];
+		m_cell_head[m_cell_of[i]] = i;
+	}
+
+	double retval = 0;
+	for (int i = 0; i < atoms; ++i) {
+		const int ci = m_cell_of[i];
+		const int cx = ci % n_cells[0], cy = (ci / n_cells[0]) % n_cells[1], cz = ci / (n_cells[0] * n_cells[1]);
+		for (int dz = -1; dz <= 1; ++dz) {
+			if (cz + dz < 0 || cz + dz >= n_cells[2]) continue;
+			for (int dy = -1; dy <= 1; ++dy) {
+				if (cy + dy < 0 || cy + dy >= n_cells[1]) continue;
+				for (int dx = -1; dx <= 1; ++dx) {
+					if (cx + dx < 0 || cx + dx >= n_cells[0]) continue;
+					const int cj = ((cz + dz) * n_cells[1] + cy + dy) * n_cells[0] + cx + dx;
+					// Each pair is visited once, from its lower index.
+					for (int j = m_cell_head[cj]; j != -1; j = m_cell_next[j]) {
+						if (j <= i) continue;
+						const double d[3] = {p[0][i] - p[0][j], p[1][i] - p[1][j], p[2][i] - p[2][j]};
+						const double dist = d[0] * d[0] + d[1] * d[1] + d[2] * d[2]; //rij^2
+						if (dist >= cutoff2) continue;
+						overlap = overlap || (dist == 0.0);
+						const double inv = 1.0 / dist, sixth = inv * inv * inv; //rij^-6
+						retval += sixth * sixth - sixth - shift;
+						if (grad) {
+							const double coeff = (6.0 * sixth - 12.0 * sixth * sixth) * inv;
+							for (int k = 0; k < 3; ++k) {
+								g[k][i] += coeff * d[k];
+								g[k][j] -= coeff * d[k];
+							}
+						}
+					}
+				}
 			}
 		}
 	}
-	f[0] = 4 * f[0];
+	return retval;
+}
+
+/// Implementation of the objective function.
+/**
+ * Coincident atoms are penalised with a fitness of 4e20 (and a null gradient).
+ */
+void lennard_jones::objfun_impl(fitness_vector &f, const decision_vector &x) const
+{
+	pagmo_assert(f.size() == 1);
+	f[0] = 4 * potential(x, 0);
+}
+
+/// Analytic gradient of the objective function.
+void lennard_jones::objfun_gradient_impl(decision_vector &grad, const decision_vector &x) const
+{
+	potential(x, &grad);
+	for (decision_vector::size_type i = 0; i < grad.size(); ++i) {
+		grad[i] *= 4;
+	}
+}
+
+/// The Lennard-Jones problem provides an analytic gradient.
+bool lennard_jones::has_analytic_gradient() const
+{
+	return true;
+}
+
+/// Extra human readable info for the problem.
+/**
+ * Will return a formatted string containing the cutoff radius.
+ */
+std::string lennard_jones::human_readable_extra() const
+{
+	std::ostringstream oss;
+	oss << "\n\tCutoff radius: " << m_cutoff << '\n';
+	return oss.str();
+}
+
+/// Additional requirements for equality.
+/**
+ * @return true if the cutoff radii are equal, false otherwise.
+ */
+bool lennard_jones::equality_operator_extra(const base &other) const
+{
+	pagmo_assert(typeid(*this) == typeid(other));
+	return (m_cutoff == dynamic_cast<lennard_jones const &>(other).m_cutoff);
 }
 
 std::string lennard_jones::get_name() const
@@ -43,6 +43,12 @@ namespace pagmo{ namespace problem {
  * atoms, the global optima will be different. In the link below a database containing all
  * putative global optima is given.
  *
+ * The pair potential is evaluated on contiguous coordinate arrays and the analytic gradient
+ * is available through problem::base::objfun_gradient(). For large clusters, an optional cutoff
+ * radius can be set: pairs further apart are neglected and the pairs are found with a cell list,
+ * making the evaluation linear in the number of atoms. The cut pair potential is shifted so that
+ * it vanishes at the cutoff radius and the energy is continuous.
+ *
  * @see http://physchem.ox.ac.uk/~doye/jon/structures/LJ/tables.150.html
  * @author Dario Izzo (dario.izzo@esa.int)
  */
@@ -50,19 +56,38 @@ namespace pagmo{ namespace problem {
 class __PAGMO_VISIBLE lennard_jones : public base
 {
 	public:
-		lennard_jones(int = 3);
+		lennard_jones(int = 3, const double & = 0.);
 		base_ptr clone() const;
 		std::string get_name() const;
+		bool has_analytic_gradient() const;
+		std::string human_readable_extra() const;
+		/// Returns the cutoff radius (0 if all the pairs are considered).
+		double get_cutoff() const {return m_cutoff;}
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
+		void objfun_gradient_impl(decision_vector &, const decision_vector &) const;
+		bool equality_operator_extra(const base &) const;
 	private:
 		static double r(const int& atom, const int& coord, const std::vector <double>& x);
+		double potential(const decision_vector &, decision_vector *) const;
+		double potential_cells(decision_vector *, bool &) const;
 		friend class boost::serialization::access;
 		template <class Archive>
 		void serialize(Archive &ar, const unsigned int)
 		{
 			ar & boost::serialization::base_object<base>(*this);
+			ar & const_cast<double &>(m_cutoff);
 		}
+		const double m_cutoff;
+
+		// These are pre-allocated for speed, need not to be serialized
+		// Atom positions (all the x, then all the y, then all the z) and their gradients.
+		mutable std::vector<double> m_pos;
+		mutable std::vector<double> m_grad;
+		// Cell list: first atom of each cell and next atom in the same cell.
+		mutable std::vector<int> m_cell_head;
+		mutable std::vector<int> m_cell_next;
+		mutable std::vector<int> m_cell_of;
 };
 
 }} //namespaces
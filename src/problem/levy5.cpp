@@ -25,6 +25,7 @@
 #include <boost/math/constants/constants.hpp>
 #include <cmath>
 #include <string>
+#include <vector>
 
 #include "../exceptions.h"
 #include "../types.h"
@@ -79,6 +80,33 @@ void levy5::objfun_impl(fitness_vector &f, const decision_vector &x) const
 
 }
 
+/// Implementation of the batch objective function.
+void levy5::objfun_batch_impl(std::vector<double> &f, const std::vector<double> &x, size_type n) const
+{
+	pagmo_assert(f.size() == n);
+	const size_type dim = get_dimension();
+	std::vector<double> isum(n,0.0), jsum(n,0.0);
+
+	for (size_type j = 0; j < dim; j += 2) {
+		const double *xj = &x[j * n], *xk = &x[(j + 1) * n];
+		for (int k = 1; k <= 5; ++k) {
+			for (size_type i = 0; i < n; ++i) {
+				isum[i] += (double)(k) * cos((double)(k - 1) * xj[i] + (double)(k));
+				jsum[i] += (double)(k) * cos((double)(k + 1) * xk[i] + (double)(k));
+			}
+		}
+	}
+	for (size_type i = 0; i < n; ++i) {
+		f[i] = isum[i] * jsum[i];
+	}
+	for (size_type j = 0; j < dim; j += 2) {
+		const double *xj = &x[j * n], *xk = &x[(j + 1) * n];
+		for (size_type i = 0; i < n; ++i) {
+			f[i] += (xj[i] + 1.42513) * (xj[i] + 1.42513) + (xk[i] + 0.80032) * (xk[i] + 0.80032);
+		}
+	}
+}
+
 std::string levy5::get_name() const
 {
 	return "Levy5";
@@ -29,6 +29,7 @@
 #include <cmath>
 
 #include "mga_1dsm_alpha.h"
+#include "mga_1dsm_batch.h"
 #include "../keplerian_toolbox/keplerian_toolbox.h"
 
 namespace pagmo { namespace problem {
@@ -115,97 +116,69 @@ base_ptr mga_1dsm_alpha::clone() const
 }
 
 /// Implementation of the objective function.
+/**
+ * The chromosome is evaluated as a block of one by objfun_batch_impl(), so that the batch and the per-chromosome
+ * evaluations share the same implementation.
+ */
 void mga_1dsm_alpha::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
-try {
-	double common_mu = m_seq[0]->get_mu_central_body();
-	// 1 - we 'decode' the chromosome recording the various times of flight (days) in the list T
-	std::vector<double> T(m_n_legs,0.0);
-	double alpha_sum = 0;
-	
+	objfun_batch_impl(f,x,1);
+}
+
+/// Implementation of the batch objective function.
+/**
+ * Evaluates the whole block with the mga_1dsm_batch() pipeline, so that the ephemerides and the Lambert arcs of all
+ * the chromosomes are computed together. Chromosomes whose trajectory cannot be computed (the lambert solver or the
+ * lagrangian propagator fail) get the worst possible fitness.
+ */
+void mga_1dsm_alpha::objfun_batch_impl(std::vector<double> &f, const std::vector<double> &x, size_type n) const
+{
+	// 1 - we 'decode' the times of flight (days) of the whole block
+	std::vector<double> T(m_n_legs * n);
+	std::vector<double> alpha_sum(n,0.0);
 	for (size_t i = 0; i < m_n_legs; ++i) {
-		double tmp = -log(x[6+4*i]);
-		alpha_sum+= tmp;
-		T[i] = x[1] * tmp;
+		for (size_type k = 0; k < n; ++k) {
+			double tmp = -log(x[(6+4*i) * n + k]);
+			alpha_sum[k] += tmp;
+			T[i * n + k] = x[n + k] * tmp;
+		}
 	}
 	for (size_t i = 0; i < m_n_legs; ++i) {
-		T[i] /= alpha_sum;
-	}
-
-	// 2 - We compute the epochs and ephemerides of the planetary encounters
-	std::vector<kep_toolbox::epoch>   t_P(m_n_legs + 1);
-	std::vector<kep_toolbox::array3D> r_P(m_n_legs + 1);
-	std::vector<kep_toolbox::array3D> v_P(m_n_legs + 1);
-	std::vector<double> DV(m_n_legs + 1);
-	for (size_t i = 0; i<(m_n_legs + 1); ++i) {
-		t_P[i] = kep_toolbox::epoch(x[0] + std::accumulate(T.begin(), T.begin()+i, 0.0));
-		m_seq[i]->get_eph(t_P[i], r_P[i], v_P[i]);
-	}
-
-	// 3 - We start with the first leg
-	double theta = 2*boost::math::constants::pi<double>()*x[2];
-	double phi = acos(2*x[3]-1)-boost::math::constants::pi<double>() / 2;
-
-	kep_toolbox::array3D Vinf = { {x[4]*cos(phi)*cos(theta), x[4]*cos(phi)*sin(theta), x[4]*sin(phi)} };
-	kep_toolbox::array3D v0;
-	kep_toolbox::sum(v0, v_P[0], Vinf);
-	kep_toolbox::array3D r(r_P[0]), v(v0);
-	kep_toolbox::propagate_lagrangian(r,v,x[5]*T[0]*ASTRO_DAY2SEC,common_mu);
-
-	// Lambert arc to reach seq[1]
-	double dt = (1-x[5])*T[0]*ASTRO_DAY2SEC;
-	kep_toolbox::lambert_problem l(r,r_P[1],dt,common_mu);
-	kep_toolbox::array3D v_end_l = l.get_v2()[0];
-	kep_toolbox::array3D v_beg_l = l.get_v1()[0];
-
-	// First DSM occuring at time nu1*T1
-	kep_toolbox::diff(v, v_beg_l, v);
-	DV[0] = kep_toolbox::norm(v);
-
-	// 4 - And we proceed with each successive leg (if any)
-	kep_toolbox::array3D v_out;
-	for (size_t i = 1; i<m_n_legs; ++i) {
-		// Fly-by
-		kep_toolbox::fb_prop(v_out, v_end_l, v_P[i], x[8+(i-1)*4] * m_seq[i]->get_radius(), x[7+(i-1)*4], m_seq[i]->get_mu_self());
-		// s/c propagation before the DSM
-		r = r_P[i];
-		v = v_out;
-		kep_toolbox::propagate_lagrangian(r,v,x[9+(i-1)*4]*T[i]*ASTRO_DAY2SEC,common_mu);
-
-		// Lambert arc to reach Earth during (1-nu2)*T2 (second segment)
-		dt = (1-x[9+(i-1)*4])*T[i]*ASTRO_DAY2SEC;
-		kep_toolbox::lambert_problem l2(r,r_P[i+1],dt,common_mu);
-	  	v_end_l = l2.get_v2()[0];
-		v_beg_l = l2.get_v1()[0];
-
-		// DSM occuring at time nu2*T2
-		kep_toolbox::diff(v, v_beg_l, v);
-		DV[i] = kep_toolbox::norm(v);
-	}
-	
-	// Last Delta-v
-	kep_toolbox::diff(v, v_end_l, v_P[m_n_legs]);
-	DV[m_n_legs] = kep_toolbox::norm(v);
-	
-	
-	// Now we return the objective(s) function
-	f[0] = std::accumulate(DV.begin(),DV.end()-1,0.0); 
-	if (m_add_vinf_dep) {
-		f[0] += x[4];
-	}
-	if (m_add_vinf_arr) {
-		f[0] += DV[DV.size()-1];
+		for (size_type k = 0; k < n; ++k) {
+			T[i * n + k] /= alpha_sum[k];
+		}
 	}
-	if (get_f_dimension() == 2){
-		f[1] = std::accumulate(T.begin(),T.end(),0.0);
-	} 
-//Here the lambert solver or the lagrangian propagator went wrong
-} catch (...) {
-	f[0] = boost::numeric::bounds<double>::highest();
-	if (get_f_dimension() == 2){
-		f[1] = boost::numeric::bounds<double>::highest();
+	// 2 - we compute the DSMs and the arrival relative velocities of the whole block
+	std::vector<double> DV;
+	std::vector<char> failed;
+	mga_1dsm_batch(DV,failed,m_seq,x,T,n,1);
+
+	// 3 - Now we return the objective(s) function
+	for (size_type k = 0; k < n; ++k) {
+		if (failed[k]) {
+			f[k] = boost::numeric::bounds<double>::highest();
+			if (get_f_dimension() == 2){
+				f[n + k] = boost::numeric::bounds<double>::highest();
+			}
+			continue;
+		}
+		f[k] = 0.0;
+		for (size_t i = 0; i < m_n_legs; ++i) {
+			f[k] += DV[i * n + k];
+		}
+		if (m_add_vinf_dep) {
+			f[k] += x[4 * n + k];
+		}
+		if (m_add_vinf_arr) {
+			f[k] += DV[m_n_legs * n + k];
+		}
+		if (get_f_dimension() == 2){
+			f[n + k] = 0.0;
+			for (size_t i = 0; i < m_n_legs; ++i) {
+				f[n + k] += T[i * n + k];
+			}
+		}
 	}
-} 
 }
 
 /// Outputs a stream with the trajectory data
@@ -268,9 +241,8 @@ std::string mga_1dsm_alpha::pretty(const std::vector<double> &x) const {
 
 	// Lambert arc to reach seq[1]
 	double dt = (1-x[5])*T[0]*ASTRO_DAY2SEC;
-	kep_toolbox::lambert_problem l(r,r_P[1],dt,common_mu);
-	kep_toolbox::array3D v_end_l = l.get_v2()[0];
-	kep_toolbox::array3D v_beg_l = l.get_v1()[0];
+	kep_toolbox::array3D v_beg_l, v_end_l;
+	kep_toolbox::lambert_problem::solve(v_beg_l,v_end_l,r,r_P[1],dt,common_mu);
 
 	// First DSM occuring at time nu1*T1
 	kep_toolbox::diff(v, v_beg_l, v);
@@ -294,9 +266,7 @@ std::string mga_1dsm_alpha::pretty(const std::vector<double> &x) const {
 
 		// Lambert arc to reach Earth during (1-nu2)*T2 (second segment)
 		dt = (1-x[9+(i-1)*4])*T[i]*ASTRO_DAY2SEC;
-		kep_toolbox::lambert_problem l2(r,r_P[i+1],dt,common_mu);
-	  	v_end_l = l2.get_v2()[0];
-		v_beg_l = l2.get_v1()[0];
+		kep_toolbox::lambert_problem::solve(v_beg_l,v_end_l,r,r_P[i+1],dt,common_mu);
 
 		// DSM occuring at time nu2*T2
 		kep_toolbox::diff(v, v_beg_l, v);
@@ -83,6 +83,7 @@ class __PAGMO_VISIBLE mga_1dsm_alpha: public base
 		std::vector<double> get_tof() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
+		void objfun_batch_impl(std::vector<double> &, const std::vector<double> &, size_type) const;
 		std::string human_readable_extra() const;
 	private:
 		static const std::vector<kep_toolbox::planet_ptr> construct_default_sequence() {
@@ -0,0 +1,138 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <cmath>
+#include <vector>
+#include <boost/math/constants/constants.hpp>
+
+#include "mga_1dsm_batch.h"
+#include "../keplerian_toolbox/keplerian_toolbox.h"
+
+namespace pagmo { namespace problem {
+
+void mga_1dsm_batch(std::vector<double> &DV, std::vector<char> &failed, const std::vector<kep_toolbox::planet_ptr> &seq,
+	const std::vector<double> &x, const std::vector<double> &T, const std::vector<double>::size_type &n, const std::vector<double>::size_type &offset)
+{
+	typedef std::vector<double>::size_type size_type;
+	const size_type n_legs = seq.size() - 1;
+	const double common_mu = seq[0]->get_mu_central_body();
+	const double *t0 = &x[0], *u = &x[(1 + offset) * n], *v = &x[(2 + offset) * n], *vinf = &x[(3 + offset) * n];
+	DV.resize((n_legs + 1) * n);
+	failed.assign(n,0);
+
+	// 1 - Epochs and ephemerides of all the planetary encounters, planet by planet
+	std::vector<double> t_P(n);
+	std::vector<std::vector<kep_toolbox::array3D> > r_P(n_legs + 1, std::vector<kep_toolbox::array3D>(n));
+	std::vector<std::vector<kep_toolbox::array3D> > v_P(n_legs + 1, std::vector<kep_toolbox::array3D>(n));
+	for (size_type i = 0; i < n_legs + 1; ++i) {
+		for (size_type k = 0; k < n; ++k) {
+			// Same summation order as std::accumulate in the objective functions
+			double sum_T = 0.0;
+			for (size_type j = 0; j < i; ++j) {
+				sum_T += T[j * n + k];
+			}
+			t_P[k] = t0[k] + sum_T;
+		}
+		for (size_type k = 0; k < n; ++k) {
+			try {
+				seq[i]->get_eph(kep_toolbox::epoch(t_P[k]), r_P[i][k], v_P[i][k]);
+			} catch (...) {
+				failed[k] = 1;
+			}
+		}
+	}
+
+	// 2 - Legs, each step being carried out for the whole block
+	std::vector<kep_toolbox::array3D> r(n), v_sc(n), v_beg_l(n), v_end_l(n);
+	std::vector<double> dt(n);
+	std::vector<size_type> active;
+	std::vector<kep_toolbox::array3D> r1, r2, v1, v2;
+	std::vector<double> tof;
+	for (size_type i = 0; i < n_legs; ++i) {
+		const double *eta = &x[(i == 0 ? 4 + offset : 8 + offset + 4 * (i - 1)) * n];
+		// 2.1 - Departure (first leg) or fly-by, and propagation up to the DSM
+		for (size_type k = 0; k < n; ++k) {
+			if (failed[k]) {
+				continue;
+			}
+			try {
+				if (i == 0) {
+					const double theta = 2*boost::math::constants::pi<double>()*u[k];
+					const double phi = acos(2*v[k]-1)-boost::math::constants::pi<double>() / 2;
+					const kep_toolbox::array3D Vinf = { {vinf[k]*cos(phi)*cos(theta), vinf[k]*cos(phi)*sin(theta), vinf[k]*sin(phi)} };
+					kep_toolbox::sum(v_sc[k], v_P[0][k], Vinf);
+				} else {
+					const double beta = x[(6 + offset + 4 * (i - 1)) * n + k], rp = x[(7 + offset + 4 * (i - 1)) * n + k];
+					kep_toolbox::fb_prop(v_sc[k], v_end_l[k], v_P[i][k], rp * seq[i]->get_radius(), beta, seq[i]->get_mu_self());
+				}
+				r[k] = r_P[i][k];
+				kep_toolbox::propagate_lagrangian(r[k],v_sc[k],eta[k]*T[i * n + k]*ASTRO_DAY2SEC,common_mu);
+				dt[k] = (1-eta[k])*T[i * n + k]*ASTRO_DAY2SEC;
+			} catch (...) {
+				failed[k] = 1;
+			}
+		}
+		// 2.2 - Lambert arcs from the DSMs to the next planet, solved in one batch
+		active.clear(); r1.clear(); r2.clear(); tof.clear();
+		for (size_type k = 0; k < n; ++k) {
+			if (!failed[k]) {
+				active.push_back(k);
+				r1.push_back(r[k]);
+				r2.push_back(r_P[i + 1][k]);
+				tof.push_back(dt[k]);
+			}
+		}
+		try {
+			kep_toolbox::lambert_problem::solve_batch(v1,v2,r1,r2,tof,common_mu);
+			for (size_type j = 0; j < active.size(); ++j) {
+				v_beg_l[active[j]] = v1[j];
+				v_end_l[active[j]] = v2[j];
+			}
+		} catch (...) {
+			// Some arc of the batch is invalid: solve them one at a time to single out the failed chromosomes
+			for (size_type j = 0; j < active.size(); ++j) {
+				try {
+					kep_toolbox::lambert_problem::solve(v_beg_l[active[j]],v_end_l[active[j]],r1[j],r2[j],tof[j],common_mu);
+				} catch (...) {
+					failed[active[j]] = 1;
+				}
+			}
+		}
+		// 2.3 - DSMs
+		for (size_type k = 0; k < n; ++k) {
+			kep_toolbox::array3D dv;
+			kep_toolbox::diff(dv, v_beg_l[k], v_sc[k]);
+			DV[i * n + k] = kep_toolbox::norm(dv);
+		}
+	}
+
+	// 3 - Arrival relative velocities
+	for (size_type k = 0; k < n; ++k) {
+		kep_toolbox::array3D dv;
+		kep_toolbox::diff(dv, v_end_l[k], v_P[n_legs][k]);
+		DV[n_legs * n + k] = kep_toolbox::norm(dv);
+	}
+}
+
+}} // namespaces
@@ -0,0 +1,61 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_PROBLEM_MGA_1DSM_BATCH_H
+#define PAGMO_PROBLEM_MGA_1DSM_BATCH_H
+
+#include <vector>
+
+#include "../config.h"
+#include "../keplerian_toolbox/planet.h"
+
+namespace pagmo{ namespace problem {
+
+/// Batched evaluation of MGA-1DSM trajectories
+/**
+ * Evaluation pipeline shared by mga_1dsm_alpha and mga_1dsm_tof for a block of n chromosomes. Rather than
+ * evaluating each chromosome in turn, each step of the trajectory is carried out for the whole block before moving
+ * to the next one: all encounter ephemerides are computed planet by planet, and the Lambert arcs of each leg are
+ * solved together by kep_toolbox::lambert_problem::solve_batch(). The per-chromosome objective functions of the two
+ * problems go through the same pipeline with a block of one.
+ *
+ * The chromosomes are stored in the structure-of-arrays layout of base::objfun_batch_impl() (x[j * n + k] is the j-th
+ * component of the k-th chromosome) and follow the layout of mga_1dsm_tof, shifted by offset components after t0:
+ * [t0] + [u, v, Vinf, eta1, .] + [beta, rp/rP, eta2, .] + ... The times of flight are given separately, as they are
+ * encoded differently by the two problems (T[i * n + k] is the i-th leg time of flight of the k-th chromosome, in days).
+ *
+ * @param[out] DV Deep Space Manouvres of each leg and arrival relative velocity, (n_legs + 1) * n, same layout as T (m/s)
+ * @param[out] failed set to 1 for the chromosomes whose trajectory could not be computed, 0 otherwise
+ * @param[in] seq encounter sequence
+ * @param[in] x chromosome block
+ * @param[in] T times of flight block (days)
+ * @param[in] n number of chromosomes
+ * @param[in] offset position of u in the chromosomes, minus one
+ */
+void mga_1dsm_batch(std::vector<double> &DV, std::vector<char> &failed, const std::vector<kep_toolbox::planet_ptr> &seq,
+	const std::vector<double> &x, const std::vector<double> &T, const std::vector<double>::size_type &n, const std::vector<double>::size_type &offset);
+
+}} // namespaces
+
+#endif // PAGMO_PROBLEM_MGA_1DSM_BATCH_H
@@ -80,6 +80,7 @@ class __PAGMO_VISIBLE mga_1dsm_tof: public base
 		std::vector<std::vector<double> > get_tof() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
+		void objfun_batch_impl(std::vector<double> &, const std::vector<double> &, size_type) const;
 		std::string human_readable_extra() const;
 		
 	private:
@@ -149,9 +149,8 @@ try {
 	double d,d2,ra,ra2;
 	kep_toolbox::array3D r = { {ASTRO_JR*1000*cos(phi)*sin(theta), ASTRO_JR*1000*cos(phi)*cos(theta), ASTRO_JR*1000*sin(phi)} };
 	kep_toolbox::array3D v;
-	kep_toolbox::lambert_problem l(r,r_P[0],T[0]*ASTRO_DAY2SEC,common_mu,false,false);
-	kep_toolbox::array3D v_beg_l = l.get_v1()[0];
-	kep_toolbox::array3D v_end_l = l.get_v2()[0];
+	kep_toolbox::array3D v_beg_l, v_end_l;
+	kep_toolbox::lambert_problem::solve(v_beg_l,v_end_l,r,r_P[0],T[0]*ASTRO_DAY2SEC,common_mu);
 
 	DV[0] = std::abs(kep_toolbox::norm(v_beg_l)-3400.0);
 	
@@ -168,9 +167,7 @@ try {
 
 		// Lambert arc to reach Earth during (1-nu2)*T2 (second segment)
 		double dt = (1-x[4*i+2])*T[i]*ASTRO_DAY2SEC;
-		kep_toolbox::lambert_problem l2(r,r_P[i],dt,common_mu,false,false);
-		v_end_l = l2.get_v2()[0];
-		v_beg_l = l2.get_v1()[0];
+		kep_toolbox::lambert_problem::solve(v_beg_l,v_end_l,r,r_P[i],dt,common_mu);
 		kep_toolbox::closest_distance(d2,ra2,r,v_beg_l, r_P[i], v_end_l, common_mu);
 		if (d < d2)
 		{
@@ -218,9 +215,8 @@ try {
 	double d,d2,ra,ra2;
 	kep_toolbox::array3D r = { {ASTRO_JR*1000*cos(phi)*sin(theta), ASTRO_JR*1000*cos(phi)*cos(theta), ASTRO_JR*1000*sin(phi)} };
 	kep_toolbox::array3D v;
-	kep_toolbox::lambert_problem l(r,r_P[0],T[0]*ASTRO_DAY2SEC,common_mu,false,false);
-	kep_toolbox::array3D v_beg_l = l.get_v1()[0];
-	kep_toolbox::array3D v_end_l = l.get_v2()[0];
+	kep_toolbox::array3D v_beg_l, v_end_l;
+	kep_toolbox::lambert_problem::solve(v_beg_l,v_end_l,r,r_P[0],T[0]*ASTRO_DAY2SEC,common_mu);
 
 	DV[0] = std::abs(kep_toolbox::norm(v_beg_l)-3400.0);
 
@@ -237,9 +233,7 @@ try {
 
 		// Lambert arc to reach Earth during (1-nu2)*T2 (second segment)
 		double dt = (1-x[4*i+2])*T[i]*ASTRO_DAY2SEC;
-		kep_toolbox::lambert_problem l2(r,r_P[i],dt,common_mu,false,false);
-		v_end_l = l2.get_v2()[0];
-		v_beg_l = l2.get_v1()[0];
+		kep_toolbox::lambert_problem::solve(v_beg_l,v_end_l,r,r_P[i],dt,common_mu);
 		kep_toolbox::closest_distance(d2,ra2,r,v_beg_l, r_P[i], v_end_l, common_mu);
 		if (d < d2)
 		{
@@ -304,9 +298,8 @@ std::string mga_incipit_cstrs::pretty(const std::vector<double> &x) const {
 	kep_toolbox::array3D r = { {ASTRO_JR * 1000*cos(phi)*sin(theta), ASTRO_JR * 1000*cos(phi)*cos(theta), ASTRO_JR * 1000*sin(phi)} };
 	kep_toolbox::array3D v;
 	
-	kep_toolbox::lambert_problem l(r,r_P[0],T[0]*ASTRO_DAY2SEC,common_mu,false,false);
-	kep_toolbox::array3D v_beg_l = l.get_v1()[0];
-	kep_toolbox::array3D v_end_l = l.get_v2()[0];
+	kep_toolbox::array3D v_beg_l, v_end_l;
+	kep_toolbox::lambert_problem::solve(v_beg_l,v_end_l,r,r_P[0],T[0]*ASTRO_DAY2SEC,common_mu);
 	kep_toolbox::closest_distance(d,ra,r,v_beg_l, r_P[0], v_end_l, common_mu);
 
 	DV[0] = std::abs(kep_toolbox::norm(v_beg_l)-3400.0);
@@ -336,9 +329,7 @@ std::string mga_incipit_cstrs::pretty(const std::vector<double> &x) const {
 		
 		// Lambert arc to reach Earth during (1-nu2)*T2 (second segment)
 		double dt = (1-x[4*i+2])*T[i]*ASTRO_DAY2SEC;
-		kep_toolbox::lambert_problem l2(r,r_P[i],dt,common_mu,false,false);
-		v_end_l = l2.get_v2()[0];
-		v_beg_l = l2.get_v1()[0];
+		kep_toolbox::lambert_problem::solve(v_beg_l,v_end_l,r,r_P[i],dt,common_mu);
 		kep_toolbox::closest_distance(d2,ra2,r,v_beg_l, r_P[i], v_end_l, common_mu);
 		
 		if (d < d2)
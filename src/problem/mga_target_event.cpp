@@ -115,16 +115,17 @@ void mga_target_event::objfun_impl(fitness_vector &f, const decision_vector &x)
 
 	//4 - And we propagate up to the DSM positon to then solve a Lambert problem
 	kep_toolbox::propagate_lagrangian(r0,v0_sc,tof*x[5]*ASTRO_DAY2SEC, ASTRO_MU_SUN);
-	kep_toolbox::lambert_problem l(r0,r1,tof*(1-x[5])*ASTRO_DAY2SEC,ASTRO_MU_SUN, false,0);
+	kep_toolbox::array3D v_beg_l, v_end_l;
+	kep_toolbox::lambert_problem::solve(v_beg_l,v_end_l,r0,r1,tof*(1-x[5])*ASTRO_DAY2SEC,ASTRO_MU_SUN);
 
 //std::cout << "r0: " << r0 << std::endl;
 //std::cout << "v0: " << v0_sc << std::endl;
 
 	double DV1 = x[2];
 	kep_toolbox::array3D dv2,dv3;
-	kep_toolbox::diff(dv2,v0_sc,l.get_v1()[0]);
+	kep_toolbox::diff(dv2,v0_sc,v_beg_l);
 	double DV2 = kep_toolbox::norm(dv2);
-	kep_toolbox::diff (dv3,v1,l.get_v2()[0]);
+	kep_toolbox::diff (dv3,v1,v_end_l);
 	double DV3 = kep_toolbox::norm(dv3);
 	if (m_discount_launcher) {
 		DV1 = std::max(0.,DV1-6000.);
@@ -22,8 +22,10 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
 #include <boost/math/constants/constants.hpp>
 #include <cmath>
+#include <vector>
 
 #include "../exceptions.h"
 #include "../types.h"
@@ -65,6 +67,22 @@ void michalewicz::objfun_impl(fitness_vector &f, const decision_vector &x) const
 	f[0] = retval;
 }
 
+/// Implementation of the batch objective function.
+void michalewicz::objfun_batch_impl(std::vector<double> &f, const std::vector<double> &x, size_type n) const
+{
+	pagmo_assert(f.size() == n);
+	const size_type dim = get_dimension();
+	double *retval = &f[0];
+	std::fill(f.begin(),f.end(),0.0);
+
+	for (size_type j = 0; j < dim; ++j) {
+		const double *xj = &x[j * n];
+		for (size_type i = 0; i < n; ++i) {
+			retval[i] -= sin(xj[i]) * pow(sin((j + 1) * xj[i] * xj[i] / boost::math::constants::pi<double>()), 2 * m_m);
+		}
+	}
+}
+
 std::string michalewicz::get_name() const
 {
 	return "Michalewicz";
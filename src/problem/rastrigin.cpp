@@ -22,9 +22,11 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
 #include <boost/math/constants/constants.hpp>
 #include <cmath>
 #include <string>
+#include <vector>
 
 #include "../exceptions.h"
 #include "../types.h"
@@ -67,6 +69,25 @@ void rastrigin::objfun_impl(fitness_vector &f, const decision_vector &x) const
 	f[0] += 10.0 * n;
 }
 
+/// Implementation of the batch objective function.
+void rastrigin::objfun_batch_impl(std::vector<double> &f, const std::vector<double> &x, size_type n) const
+{
+	pagmo_assert(f.size() == n);
+	const double omega = 2.0 * boost::math::constants::pi<double>();
+	const size_type dim = get_dimension();
+	double *retval = &f[0];
+	std::fill(f.begin(),f.end(),0.0);
+	for (size_type j = 0; j < dim; ++j) {
+		const double *xj = &x[j * n];
+		for (size_type i = 0; i < n; ++i) {
+			retval[i] += xj[i] * xj[i] - 10.0 * std::cos(omega * xj[i]);
+		}
+	}
+	for (size_type i = 0; i < n; ++i) {
+		retval[i] += 10.0 * dim;
+	}
+}
+
 std::string rastrigin::get_name() const
 {
 	return "Rastrigin";
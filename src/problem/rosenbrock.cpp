@@ -22,7 +22,9 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include "../exceptions.h"
 #include "../types.h"
@@ -62,6 +64,22 @@ void rosenbrock::objfun_impl(fitness_vector &f, const decision_vector &x) const
 	}
 }
 
+/// Implementation of the batch objective function.
+void rosenbrock::objfun_batch_impl(std::vector<double> &f, const std::vector<double> &x, size_type n) const
+{
+	pagmo_assert(f.size() == n);
+	const size_type dim = get_dimension();
+	double *retval = &f[0];
+	std::fill(f.begin(),f.end(),0.0);
+	for (size_type j = 0; j < dim - 1; ++j) {
+		const double *xj = &x[j * n], *xk = &x[(j + 1) * n];
+		for (size_type i = 0; i < n; ++i) {
+			const double tmp = xj[i] * xj[i] - xk[i];
+			retval[i] += 100 * tmp * tmp + (xj[i] - 1) * (xj[i] - 1);
+		}
+	}
+}
+
 std::string rosenbrock::get_name() const
 {
 	return "Rosenbrock";
@@ -25,6 +25,7 @@
 #include <boost/math/constants/constants.hpp>
 #include <cmath>
 #include <string>
+#include <vector>
 
 #include "../exceptions.h"
 #include "../types.h"
@@ -67,6 +68,24 @@ void schwefel::objfun_impl(fitness_vector &f, const decision_vector &x) const
 		f[0] = 418.9828872724338 * n - value;
 }
 
+/// Implementation of the batch objective function.
+void schwefel::objfun_batch_impl(std::vector<double> &f, const std::vector<double> &x, size_type n) const
+{
+	pagmo_assert(f.size() == n);
+	const size_type dim = get_dimension();
+	std::vector<double> value(n,0.0);
+
+	for (size_type j = 0; j < dim; ++j) {
+		const double *xj = &x[j * n];
+		for (size_type i = 0; i < n; ++i) {
+			value[i] += xj[i] * sin(sqrt(fabs(xj[i])));
+		}
+	}
+	for (size_type i = 0; i < n; ++i) {
+		f[i] = 418.9828872724338 * dim - value[i];
+	}
+}
+
 std::string schwefel::get_name() const
 {
 	return "Schwefel";
@@ -26,6 +26,12 @@
 #include<gsl/gsl_errno.h>
 #include<cmath>
 #include<algorithm>
+#include<boost/bind.hpp>
+#include<boost/shared_ptr.hpp>
+#include<boost/thread/condition_variable.hpp>
+#include<boost/thread/locks.hpp>
+#include<boost/thread/mutex.hpp>
+#include<boost/thread/thread.hpp>
 
 #include "../exceptions.h"
 #include "../types.h"
@@ -37,6 +43,8 @@ static const int nr_input = 8;
 static const int nr_output = 3;
 static const int nr_spheres = 3;
 static const int nr_eq = 9;
+// Initial step size of the ode-solver
+static const double initial_step = 1e-6;
 
 static double norm2(double v[3]) {
 	return(v[0]*v[0] + v[1]*v[1] +v[2]*v[2]);
@@ -45,18 +53,18 @@ static double norm2(double v[3]) {
 namespace pagmo { namespace problem {
 
 spheres::spheres(int n_evaluations, int n_hidden_neurons,
-		 double numerical_precision, unsigned int seed, bool symmetric, double sim_time, const std::vector<double>& sides) :
+		 double numerical_precision, unsigned int seed, bool symmetric, double sim_time, const std::vector<double>& sides, unsigned int n_threads) :
 	base_stochastic((nr_input/(int(symmetric)+1) + 1) * n_hidden_neurons + (n_hidden_neurons + 1) * nr_output, seed),
 	m_ffnn(nr_input,n_hidden_neurons,nr_output), m_n_evaluations(n_evaluations),
 	m_n_hidden_neurons(n_hidden_neurons), m_numerical_precision(numerical_precision),
-	m_ic(nr_eq), m_symm(symmetric), m_sim_time(sim_time), m_sides(sides) {
+	m_ic(nr_eq), m_symm(symmetric), m_sim_time(sim_time), m_sides(sides), m_n_threads(n_threads) {
 	// Here we set the bounds for the problem decision vector, i.e. the nn weights
 	set_lb(-1);
 	set_ub(1);
 	// We then instantiate the ode integrator system using gsl
 	gsl_odeiv2_system sys = {ode_func,NULL,nr_eq,&m_ffnn};
 	m_sys = sys;
-	m_gsl_drv_pntr = gsl_odeiv2_driver_alloc_y_new(&m_sys, gsl_odeiv2_step_rk8pd, 1e-6,m_numerical_precision,0.0);
+	m_gsl_drv_pntr = gsl_odeiv2_driver_alloc_y_new(&m_sys, gsl_odeiv2_step_rk8pd, initial_step,m_numerical_precision,0.0);
 	// And make sure the three sides are ordered and squared here
 	std::sort(m_sides.begin(),m_sides.end());
 	m_sides[0]*=m_sides[0];	m_sides[1]*=m_sides[1];	m_sides[2]*=m_sides[2];
@@ -66,15 +74,18 @@ spheres::spheres(const spheres &other):
 	base_stochastic(other),
 	m_ffnn(other.m_ffnn),
 	m_n_evaluations(other.m_n_evaluations),m_n_hidden_neurons(other.m_n_hidden_neurons),
-	m_numerical_precision(other.m_numerical_precision),m_ic(other.m_ic), m_symm(other.m_symm), m_sim_time(other.m_sim_time),m_sides(other.m_sides)
+	m_numerical_precision(other.m_numerical_precision),m_ic(other.m_ic), m_symm(other.m_symm), m_sim_time(other.m_sim_time),m_sides(other.m_sides),
+	m_n_threads(other.m_n_threads)
 {
 	// Here we set the bounds for the problem decision vector, i.e. the nn weights
 	gsl_odeiv2_system sys = {ode_func,NULL,nr_eq,&m_ffnn};
 	m_sys = sys;
-	m_gsl_drv_pntr = gsl_odeiv2_driver_alloc_y_new(&m_sys, gsl_odeiv2_step_rk8pd, 1e-6,m_numerical_precision,0.0);
+	m_gsl_drv_pntr = gsl_odeiv2_driver_alloc_y_new(&m_sys, gsl_odeiv2_step_rk8pd, initial_step,m_numerical_precision,0.0);
 }
 
 spheres::~spheres(){
+	// Stop the workers before freeing the solver they share with the calling thread
+	m_pool.reset();
 	gsl_odeiv2_driver_free(m_gsl_drv_pntr);
 }
 
@@ -146,10 +157,13 @@ int spheres::ode_func( double t, const double y[], double f[], void *params ) {
 	// Here we recover the neural network
 	ffnn	*ptr_ffnn = (ffnn*)params;
 
-	// The fixed-size vector context represent the sensory data perceived from each sphere. These are
-	// the body axis components of the relative positions of the other spheres, and their modules
-	double  context[nr_input];
-	double  out[nr_output];
+	// The fixed-size vector context represent the sensory data perceived from all spheres. These are
+	// the components of the relative positions of the other spheres, and their modules. They are stored
+	// input by input (context[j * nr_spheres + i] is the j-th input of the i-th sphere) so that the
+	// neural net is evaluated on all spheres at once
+	double  context[nr_input * nr_spheres];
+	double  out[nr_output * nr_spheres];
+	double  rel[nr_input];
 
 	// Here are some counters
 	int  k;
@@ -158,26 +172,31 @@ int spheres::ode_func( double t, const double y[], double f[], void *params ) {
 	for( int i = 0; i < nr_spheres; i++ ){	// i - is the sphere counter 0 .. 1 .. 2 ..
 		k = 0;
 
-		// we now load in context the perceived data (as decoded from the world state y)
+		// we now load in rel the perceived data (as decoded from the world state y)
 		for( int n = 1; n <= nr_spheres - 1; n++ ){				// consider the vector from each other sphere
 			for( int j = 0; j < 3; j++ ){				// consider each component from the vectors
-				context[k++] = y[i*3 + j] - y[ (i*3 + j + n*3) % 9 ];
+				rel[k++] = y[i*3 + j] - y[ (i*3 + j + n*3) % 9 ];
 			}
 		}
 
-		// context now contains the relative position vectors (6 components) in the absolute frame
-		// we write, on the last two components of context, the norms of these relative positions
-		context[6] = context[0]*context[0] + context[1]*context[1] + context[2]*context[2];
-		context[7] = context[3]*context[3] + context[4]*context[4] + context[5]*context[5];
+		// rel now contains the relative position vectors (6 components) in the absolute frame
+		// we write, on the last two components of rel, the norms of these relative positions
+		rel[6] = rel[0]*rel[0] + rel[1]*rel[1] + rel[2]*rel[2];
+		rel[7] = rel[3]*rel[3] + rel[4]*rel[4] + rel[5]*rel[5];
 
-		//We evaluate the output from the neural net
-		ptr_ffnn->eval(out, context);
+		for( int j = 0; j < nr_input; j++ ){
+			context[j * nr_spheres + i] = rel[j];
+		}
+	}
 
-		//Here we set the dynamics transforming the nn output [0,1] in desired velocities [-0/3,0.3]
-		f[i*3] = out[0] * 0.3 * 2 - 0.3;
-		f[i*3+1] = out[1] * 0.3 * 2 - 0.3;
-		f[i*3+2] = out[2] * 0.3 * 2 - 0.3;
+	//We evaluate the output from the neural net
+	ptr_ffnn->eval_batch(out, context, nr_spheres);
 
+	//Here we set the dynamics transforming the nn output [0,1] in desired velocities [-0/3,0.3]
+	for( int i = 0; i < nr_spheres; i++ ){
+		f[i*3] = out[i] * 0.3 * 2 - 0.3;
+		f[i*3+1] = out[nr_spheres + i] * 0.3 * 2 - 0.3;
+		f[i*3+2] = out[2 * nr_spheres + i] * 0.3 * 2 - 0.3;
 	}
 	return GSL_SUCCESS;
 }
@@ -227,38 +246,219 @@ void spheres::ffnn::eval(double out[], const double in[]) const {
 	}
 }
 
+// Vectorised version of eval(): evaluates the network on n inputs at once. Inputs and outputs are stored
+// component by component, i.e. in[j * n + s] is the j-th input of the s-th evaluation.
+void spheres::ffnn::eval_batch(double out[], const double in[], const unsigned int n) const {
+	// Offset for the weights to the output nodes
+	unsigned int offset = m_n_hidden * (m_n_inputs + 1);
+	if (m_hidden.size() < m_n_hidden * n) {
+		m_hidden.resize(m_n_hidden * n);
+	}
+
+	// -- PROCESS CONTEXT USING THE NEURAL NETWORK --
+	for( unsigned int i = 0; i < m_n_hidden; i++ ){
+		double *hidden = &m_hidden[i * n];
+		const double *w = &m_weights[i * (m_n_inputs + 1)];
+		// Set the bias, then add the weighted inputs
+		for( unsigned int s = 0; s < n; s++ ){
+			hidden[s] = w[0];
+		}
+		for( unsigned int j = 0; j < m_n_inputs; j++ ){
+			for( unsigned int s = 0; s < n; s++ ){
+				hidden[s] += w[j + 1] * in[j * n + s];
+			}
+		}
+		// Apply the transfer function (a sigmoid with output in [0,1])
+		for( unsigned int s = 0; s < n; s++ ){
+			hidden[s] = 1.0 / ( 1 + std::exp( -hidden[s] ));
+		}
+	}
+
+	// generate values for the output nodes
+	for( unsigned int i = 0; i < m_n_outputs; i++ ){
+		double *o = &out[i * n];
+		const double *w = &m_weights[offset + i * (m_n_hidden + 1)];
+		for( unsigned int s = 0; s < n; s++ ){
+			o[s] = w[0];
+		}
+		for( unsigned int j = 0; j < m_n_hidden; j++ ){
+			for( unsigned int s = 0; s < n; s++ ){
+				o[s] += w[j + 1] * m_hidden[j * n + s];
+			}
+		}
+		for( unsigned int s = 0; s < n; s++ ){
+			o[s] = 1.0 / ( 1 + std::exp( -o[s] ));
+		}
+	}
+}
+
+// Integrates the n initial conditions stored one after the other in y (overwritten with the final states) using
+// the ode-solver drv, whose system must point to neural_net. Fitness and gsl status of each run are written in fit and status.
+void spheres::integrate(gsl_odeiv2_driver *drv, const ffnn &neural_net, double *y, double *fit, int *status, int n) const {
+	for (int count=0;count<n;++count, y += nr_eq) {
+		double t0 = 0.0;
+		double tf = m_sim_time;
+		status[count] = gsl_odeiv2_driver_apply( drv, &t0, tf, y );
+		// Restart the solver from its initial step size, so that each run does not depend on the previous
+		// ones and the fitness is the same however the initial conditions are split among threads.
+		gsl_odeiv2_driver_reset_hstart (drv, initial_step);
+		if( status[count] != GSL_SUCCESS ){
+			break;
+		}
+		fit[count] = single_fitness(std::vector<double>(y,y + nr_eq),neural_net);
+	}
+}
+
+// Worker threads integrating contiguous chunks of initial conditions. The neural net stores its hidden neurons
+// values, so each worker owns a copy of it together with its own ode-solver. The calling thread integrates the
+// first chunk with the problem's own ode-solver and then waits for the workers.
+class spheres::integration_pool
+{
+		struct worker
+		{
+			worker(const ffnn &neural_net, double numerical_precision):m_ffnn(neural_net),m_y(0),m_fit(0),m_status(0),m_n(0)
+			{
+				gsl_odeiv2_system sys = {ode_func,NULL,nr_eq,&m_ffnn};
+				m_sys = sys;
+				m_drv = gsl_odeiv2_driver_alloc_y_new(&m_sys, gsl_odeiv2_step_rk8pd, initial_step,numerical_precision,0.0);
+			}
+			~worker()
+			{
+				gsl_odeiv2_driver_free(m_drv);
+			}
+			ffnn			m_ffnn;
+			gsl_odeiv2_system	m_sys;
+			gsl_odeiv2_driver	*m_drv;
+			// Chunk assigned to the worker
+			double			*m_y;
+			double			*m_fit;
+			int			*m_status;
+			int			m_n;
+		};
+	public:
+		integration_pool(const spheres &prob, int n_threads):m_prob(prob),m_generation(0),m_pending(0),m_stop(false)
+		{
+			for (int i = 1; i < n_threads; ++i) {
+				m_workers.push_back(boost::shared_ptr<worker>(new worker(prob.m_ffnn,prob.m_numerical_precision)));
+			}
+			for (std::vector<boost::shared_ptr<worker> >::size_type i = 0; i < m_workers.size(); ++i) {
+				m_threads.create_thread(boost::bind(&integration_pool::run,this,i));
+			}
+		}
+		~integration_pool()
+		{
+			{
+				boost::lock_guard<boost::mutex> lock(m_mutex);
+				m_stop = true;
+			}
+			m_start.notify_all();
+			m_threads.join_all();
+		}
+		// Integrates n initial conditions with the network weights, see spheres::integrate().
+		void integrate(const std::vector<double> &weights, double *y, double *fit, int *status, int n)
+		{
+			const int n_chunks = static_cast<int>(m_workers.size()) + 1;
+			const int first_n = n / n_chunks + (n % n_chunks > 0 ? 1 : 0);
+			{
+				boost::lock_guard<boost::mutex> lock(m_mutex);
+				for (int t = 1, first = first_n; t < n_chunks; ++t) {
+					worker &w = *m_workers[t - 1];
+					w.m_ffnn.set_weights(weights);
+					w.m_y = y + first * nr_eq;
+					w.m_fit = fit + first;
+					w.m_status = status + first;
+					w.m_n = n / n_chunks + (t < n % n_chunks ? 1 : 0);
+					first += w.m_n;
+				}
+				m_pending = m_workers.size();
+				++m_generation;
+			}
+			m_start.notify_all();
+			m_prob.integrate(m_prob.m_gsl_drv_pntr,m_prob.m_ffnn,y,fit,status,first_n);
+			boost::unique_lock<boost::mutex> lock(m_mutex);
+			while (m_pending) {
+				m_done.wait(lock);
+			}
+		}
+	private:
+		void run(std::vector<boost::shared_ptr<worker> >::size_type k)
+		{
+			worker &w = *m_workers[k];
+			unsigned long generation = 0;
+			while (true) {
+				{
+					boost::unique_lock<boost::mutex> lock(m_mutex);
+					while (!m_stop && m_generation == generation) {
+						m_start.wait(lock);
+					}
+					if (m_stop) {
+						return;
+					}
+					generation = m_generation;
+				}
+				try {
+					m_prob.integrate(w.m_drv,w.m_ffnn,w.m_y,w.m_fit,w.m_status,w.m_n);
+				} catch (...) {
+					// Reported to the caller as a failed integration
+					if (w.m_n) {
+						w.m_status[0] = GSL_EFAILED;
+					}
+				}
+				boost::lock_guard<boost::mutex> lock(m_mutex);
+				if (--m_pending == 0) {
+					m_done.notify_one();
+				}
+			}
+		}
+		const spheres					&m_prob;
+		std::vector<boost::shared_ptr<worker> >		m_workers;
+		boost::thread_group				m_threads;
+		boost::mutex					m_mutex;
+		boost::condition_variable			m_start;
+		boost::condition_variable			m_done;
+		unsigned long					m_generation;
+		std::vector<boost::shared_ptr<worker> >::size_type	m_pending;
+		bool						m_stop;
+};
+
 void spheres::objfun_impl(fitness_vector &f, const decision_vector &x) const {
 	f[0]=0;
 	// Make sure the pseudorandom sequence will always be the same
 	m_drng.seed(m_seed);
 	// Set the ffnn weights from x, by accounting for symmetries in neurons weights
 	set_nn_weights(x);
-	// Loop over the number of repetitions
+	// Creates all the initial conditions at random
+	std::vector<double> ic(m_n_evaluations * nr_eq);
 	for (int count=0;count<m_n_evaluations;++count) {
-		// Creates the initial conditions at random
+		double *y = &ic[count * nr_eq];
 		// Positions starts in a [-1,1] box
 		for (int i=0; i<6; ++i) {
-			m_ic[i] = (m_drng()*2 - 1);
+			y[i] = (m_drng()*2 - 1);
 		}
 
 		// Centered around the origin
-		m_ic[6] = - (m_ic[0] + m_ic[3]);
-		m_ic[7] = - (m_ic[1] + m_ic[4]);
-		m_ic[8] = - (m_ic[2] + m_ic[5]);
-
-		// Integrate the system
-		double t0 = 0.0;
-		double tf = m_sim_time;
-		//gsl_odeiv2_driver_set_hmin (m_gsl_drv_pntr, 1e-6);
-		int status = gsl_odeiv2_driver_apply( m_gsl_drv_pntr, &t0, tf, &m_ic[0] );
-		// Not sure if this help or what it does ....
-		gsl_odeiv2_driver_reset (m_gsl_drv_pntr);
-		if( status != GSL_SUCCESS ){
-			printf ("ERROR: gsl_odeiv2_driver_apply returned value = %d\n", status);
+		y[6] = - (y[0] + y[3]);
+		y[7] = - (y[1] + y[4]);
+		y[8] = - (y[2] + y[5]);
+	}
+	std::vector<double> fit(m_n_evaluations,0.0);
+	std::vector<int> status(m_n_evaluations,GSL_SUCCESS);
+	// Integrate the system from all initial conditions, splitting them in contiguous chunks among threads if requested
+	const int n_threads = std::min<int>(m_n_threads,m_n_evaluations);
+	if (n_threads <= 1) {
+		integrate(m_gsl_drv_pntr,m_ffnn,&ic[0],&fit[0],&status[0],m_n_evaluations);
+	} else {
+		if (!m_pool) {
+			m_pool.reset(new integration_pool(*this,n_threads));
+		}
+		m_pool->integrate(m_ffnn.m_weights,&ic[0],&fit[0],&status[0],m_n_evaluations);
+	}
+	for (int count=0;count<m_n_evaluations;++count) {
+		if( status[count] != GSL_SUCCESS ){
+			printf ("ERROR: gsl_odeiv2_driver_apply returned value = %d\n", status[count]);
 			break;
 		}
-		f[0] += single_fitness(m_ic,m_ffnn);
-
+		f[0] += fit[count];
 	}
 	f[0] /= m_n_evaluations;
 }
@@ -396,6 +596,7 @@ std::string spheres::human_readable_extra() const
 	oss << "\tSymmetric Weights: " << m_symm << '\n';
 	oss << "\tSimulation time: " << m_sim_time << '\n';
 	oss << "\tTriangle sides (squared): " << m_sides << '\n';
+	oss << "\tThreads: " << m_n_threads << '\n';
 	return oss.str();
 }
 
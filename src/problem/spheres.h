@@ -25,6 +25,7 @@
 #ifndef PAGMO_SPHERES_H
 #define PAGMO_SPHERES_H
 
+#include <boost/scoped_ptr.hpp>
 #include <string>
 #include <vector>
 #include <gsl/gsl_odeiv2.h>
@@ -83,9 +84,11 @@ class __PAGMO_VISIBLE spheres: public base_stochastic
 		 * does not distinguish among permutations of its input values due to sphere ID exchange.
 		 * @param[in] sim_time Time after wich the fitness is evaluated in the simualtion
 		 * @param[in] sides The three sides of the trianglular formation to acquire and maintain
+		 * @param[in] n_threads number of threads integrating the initial conditions concurrently (each with its own ode-solver).
+		 * The worker threads are started at the first evaluation and live as long as the problem.
 
 */
-		spheres(int n_evaluations = 10, int n_hidden = 10, double ode_prec = 1E-6, unsigned int seed = 0, bool symmetric = false, double sim_time = 50.0, const std::vector<double>& sides = std::vector<double>(3,0.5));
+		spheres(int n_evaluations = 10, int n_hidden = 10, double ode_prec = 1E-6, unsigned int seed = 0, bool symmetric = false, double sim_time = 50.0, const std::vector<double>& sides = std::vector<double>(3,0.5), unsigned int n_threads = 1);
 
 		/// Copy Constructor
 		/**
@@ -137,6 +140,7 @@ class __PAGMO_VISIBLE spheres: public base_stochastic
 			public:
 				ffnn(const unsigned int, const unsigned int,const unsigned int);
 				void eval(double[], const double[]) const;
+				void eval_batch(double[], const double[], const unsigned int) const;
 				void set_weights(const std::vector<double> &);
 			private:
 				friend class boost::serialization::access;
@@ -157,6 +161,8 @@ class __PAGMO_VISIBLE spheres: public base_stochastic
 		};
 		void set_nn_weights(const decision_vector& x) const;
 		double single_fitness( const std::vector<double> &, const ffnn& ) const;
+		void integrate(gsl_odeiv2_driver *, const ffnn &, double *, double *, int *, int) const;
+		class integration_pool;
 		friend class boost::serialization::access;
 		template <class Archive>
 		void serialize(Archive &ar, const unsigned int)
@@ -170,6 +176,7 @@ class __PAGMO_VISIBLE spheres: public base_stochastic
 			ar & m_symm;
 			ar & m_sim_time;
 			ar & m_sides;
+			ar & m_n_threads;
 		}
 		gsl_odeiv2_driver*				m_gsl_drv_pntr;
 		gsl_odeiv2_system				m_sys;
@@ -181,6 +188,9 @@ class __PAGMO_VISIBLE spheres: public base_stochastic
 		bool							m_symm;
 		double							m_sim_time;
 		std::vector<double>				m_sides;
+		unsigned int					m_n_threads;
+		// Worker threads for n_threads > 1, created at the first evaluation. Not copied nor serialized.
+		mutable boost::scoped_ptr<integration_pool>	m_pool;
 };
 
 }} //namespaces
@@ -23,6 +23,7 @@
  *****************************************************************************/
 
 #include <cmath>
+#include <vector>
 #include <boost/math/constants/constants.hpp>
 
 #include "../exceptions.h"
@@ -143,6 +144,79 @@ void zdt::objfun_impl(fitness_vector &f, const decision_vector &x) const
 	}
 }
 
+/// Implementation of the batch objective function.
+/**
+ * ZDT5 is binary and is evaluated through the default implementation, the other problems of the suite
+ * are evaluated with loops running over the candidates of the block.
+ */
+void zdt::objfun_batch_impl(std::vector<double> &f, const std::vector<double> &x, size_type n) const
+{
+	if (m_problem_number == 5) {
+		base_unc_mo::objfun_batch_impl(f,x,n);
+		return;
+	}
+	pagmo_assert(f.size() == 2 * n);
+	const size_type dim = get_dimension();
+	const double *x0 = &x[0];
+	double *f0 = &f[0], *f1 = &f[n];
+	std::vector<double> g(n,(m_problem_number == 4) ? 1 + 10 * (dim - 1.0) : 0.0);
+
+	for (size_type j = 1; j < dim; ++j) {
+		const double *xj = &x[j * n];
+		if (m_problem_number == 4) {
+			for (size_type i = 0; i < n; ++i) {
+				g[i] += xj[i] * xj[i] - 10 * cos(4 * boost::math::constants::pi<double>() * xj[i]);
+			}
+		} else {
+			for (size_type i = 0; i < n; ++i) {
+				g[i] += xj[i];
+			}
+		}
+	}
+
+	switch(m_problem_number)
+	{
+	case 1:
+		for (size_type i = 0; i < n; ++i) {
+			const double gi = 1 + (9 * g[i]) / (dim - 1);
+			f0[i] = x0[i];
+			f1[i] = gi * (1 - sqrt(x0[i] / gi));
+		}
+		break;
+	case 2:
+		for (size_type i = 0; i < n; ++i) {
+			const double gi = 1 + (9 * g[i]) / (dim - 1);
+			f0[i] = x0[i];
+			f1[i] = gi * (1 - (x0[i] / gi) * (x0[i] / gi));
+		}
+		break;
+	case 3:
+		for (size_type i = 0; i < n; ++i) {
+			const double gi = 1 + (9 * g[i]) / (dim - 1);
+			f0[i] = x0[i];
+			f1[i] = gi * (1 - sqrt(x0[i] / gi) - x0[i] / gi * sin(10 * boost::math::constants::pi<double>() * x0[i]));
+		}
+		break;
+	case 4:
+		for (size_type i = 0; i < n; ++i) {
+			const double gi = g[i];
+			f0[i] = x0[i];
+			f1[i] = gi * (1 - sqrt(x0[i] / gi));
+		}
+		break;
+	case 6:
+		for (size_type i = 0; i < n; ++i) {
+			const double gi = 1 + 9 * pow((g[i] / (dim - 1)),0.25);
+			f0[i] = 1 - exp(-4 * x0[i]) * pow(sin(6 * boost::math::constants::pi<double>() * x0[i]),6);
+			f1[i] = gi * (1 - (f0[i] / gi) * (f0[i] / gi));
+		}
+		break;
+	default:
+		pagmo_throw(value_error, "Error: There are only 6 test functions in this test suite!");
+		break;
+	}
+}
+
 // shared convergence metric for ZDT1, ZDT2 and ZDT3
 double zdt::g0123_convergence_metric(const decision_vector &x) const
 {
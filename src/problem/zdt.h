@@ -139,6 +139,7 @@ class __PAGMO_VISIBLE zdt : public base_unc_mo
 		std::string get_name() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
+		void objfun_batch_impl(std::vector<double> &, const std::vector<double> &, size_type) const;
 		double convergence_metric(const decision_vector &) const;
 	private:
 				void g01_objfun_impl(fitness_vector &, const decision_vector &) const;
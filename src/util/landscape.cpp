@@ -0,0 +1,563 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../exceptions.h"
+#include "landscape.h"
+
+namespace pagmo { namespace util { namespace landscape {
+
+typedef std::vector<std::vector<double> > matrix;
+
+// Number of threads actually used to process n work items.
+static std::size_t n_workers(unsigned int n_threads, std::size_t n)
+{
+	std::size_t retval = n_threads;
+	if (retval == 0) {
+		retval = std::max<std::size_t>(boost::thread::hardware_concurrency(),1);
+	}
+	return std::max<std::size_t>(std::min(retval,n),1);
+}
+
+// Processes the work items first, first + stride, ... with the problem prob. Errors are reported in error
+// instead of being thrown (to be run in a separate thread).
+template <class Functor>
+static void run_items(const Functor &f, const problem::base &prob, std::size_t first, std::size_t stride, std::size_t n, std::string &error)
+{
+	try {
+		for (std::size_t i = first; i < n; i += stride) {
+			f(prob,i);
+		}
+	} catch (const std::exception &e) {
+		error = e.what();
+	} catch (...) {
+		error = "Unknown error during the landscape analysis";
+	}
+}
+
+// Runs f(problem,i) for i in [0,n), spreading the work items over n_workers(n_threads,n) threads.
+// Each thread works on its own clone of the problem, as problems cache their last evaluations.
+template <class Functor>
+static void parallel_for(const problem::base &prob, std::size_t n, unsigned int n_threads, const Functor &f)
+{
+	const std::size_t n_w = n_workers(n_threads,n);
+	std::vector<problem::base_ptr> problems;
+	for (std::size_t k = 0; k < n_w; ++k) {
+		problems.push_back(prob.clone());
+	}
+	if (n_w == 1) {
+		for (std::size_t i = 0; i < n; ++i) {
+			f(*problems[0],i);
+		}
+		return;
+	}
+	// Errors in the worker threads are reported back and thrown from here
+	std::vector<std::string> errors(n_w);
+	boost::thread_group threads;
+	for (std::size_t k = 0; k < n_w; ++k) {
+		threads.create_thread(boost::bind(&run_items<Functor>,boost::cref(f),boost::cref(*problems[k]),k,n_w,n,boost::ref(errors[k])));
+	}
+	threads.join_all();
+	for (std::size_t k = 0; k < n_w; ++k) {
+		if (!errors[k].empty()) {
+			pagmo_throw(value_error,errors[k]);
+		}
+	}
+}
+
+static std::vector<double> compute_values(const problem::base &prob, const decision_vector &x, value_type type)
+{
+	return (type == FITNESS) ? prob.objfun(x) : prob.compute_constraints(x);
+}
+
+static problem::base::size_type values_size(const problem::base &prob, value_type type)
+{
+	return (type == FITNESS) ? prob.get_f_dimension() : prob.get_c_dimension();
+}
+
+// Brings a point from the unit hypercube back into the bounds of the problem.
+static decision_vector descale(const problem::base &prob, const decision_vector &x)
+{
+	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
+	if (x.size() != lb.size()) {
+		pagmo_throw(value_error,"the dimension of a point of the sample does not match the dimension of the problem");
+	}
+	decision_vector retval(x.size());
+	for (decision_vector::size_type i = 0; i < x.size(); ++i) {
+		retval[i] = x[i] * (ub[i] - lb[i]) + lb[i];
+	}
+	return retval;
+}
+
+// Largest absolute difference between two matrices. NaN if any of the differences is NaN.
+static double max_abs_diff(const matrix &a, const matrix &b)
+{
+	double retval = 0;
+	for (matrix::size_type i = 0; i < a.size(); ++i) {
+		for (std::vector<double>::size_type j = 0; j < a[i].size(); ++j) {
+			const double diff = std::fabs(a[i][j] - b[i][j]);
+			if (std::isnan(diff)) {
+				return diff;
+			}
+			retval = std::max(retval,diff);
+		}
+	}
+	return retval;
+}
+
+// Richardson extrapolation of the finite differences computed by the stencil: the step is halved until two
+// successive extrapolations agree within tol, or tmax steps have been taken.
+template <class Stencil>
+static matrix richardson(const Stencil &stencil, matrix::size_type rows, matrix::size_type cols, double h, double tol, unsigned int tmax)
+{
+	const matrix zero(rows,std::vector<double>(cols,0.));
+	std::vector<matrix> d[2];
+	d[0].push_back(zero);
+	double hh = 2 * h, err = 1;
+	unsigned int t = 0;
+	while (err > tol && t < tmax) {
+		hh /= 2;
+		std::vector<matrix> &cur = d[t % 2];
+		const std::vector<matrix> &prev = d[(t + 1) % 2];
+		stencil(hh,cur[0]);
+		for (unsigned int k = 1; k <= t; ++k) {
+			const double factor = std::pow(4.,static_cast<double>(k)) - 1;
+			for (matrix::size_type i = 0; i < rows; ++i) {
+				for (matrix::size_type j = 0; j < cols; ++j) {
+					cur[k][i][j] = cur[k - 1][i][j] + (cur[k - 1][i][j] - prev[k - 1][i][j]) / factor;
+				}
+			}
+		}
+		if (t > 0) {
+			err = max_abs_diff(cur[t],prev[t - 1]);
+		}
+		d[(t + 1) % 2].resize(d[(t + 1) % 2].size() + 2,zero);
+		++t;
+	}
+	return d[(t + 1) % 2][t - 1];
+}
+
+// Central differences of the first derivatives with respect to the continuous variables.
+struct gradient_stencil
+{
+	gradient_stencil(const problem::base &prob, const decision_vector &x, const std::vector<double> &span, value_type type):
+		m_prob(prob),m_x(x),m_span(span),m_type(type) {}
+	void operator()(double hh, matrix &retval) const
+	{
+		const decision_vector &lb = m_prob.get_lb(), &ub = m_prob.get_ub();
+		const decision_vector::size_type cont_dim = m_prob.get_dimension() - m_prob.get_i_dimension();
+		for (decision_vector::size_type i = 0; i < cont_dim; ++i) {
+			decision_vector xu(m_x), xd(m_x);
+			xu[i] += hh * (ub[i] - lb[i]);
+			xd[i] -= hh * (ub[i] - lb[i]);
+			const bool out = xu[i] > ub[i] || xd[i] < lb[i];
+			std::vector<double> vu, vd;
+			if (!out) {
+				vu = compute_values(m_prob,xu,m_type);
+				vd = compute_values(m_prob,xd,m_type);
+			}
+			for (matrix::size_type j = 0; j < retval.size(); ++j) {
+				// Derivatives are taken in the scaled space
+				retval[j][i] = out ? 0. : (vu[j] - vd[j]) / (2 * hh * m_span[j]);
+			}
+		}
+	}
+	const problem::base		&m_prob;
+	const decision_vector		&m_x;
+	const std::vector<double>	&m_span;
+	const value_type		m_type;
+};
+
+// Central differences of the second derivatives of the objectives, one column per pair (i,j) with i <= j
+// of continuous variables.
+struct hessian_stencil
+{
+	hessian_stencil(const problem::base &prob, const decision_vector &x, const std::vector<double> &span,
+		const std::vector<std::pair<decision_vector::size_type,decision_vector::size_type> > &ind):
+		m_prob(prob),m_x(x),m_span(span),m_ind(ind),m_fx(prob.objfun(x)) {}
+	void operator()(double hh, matrix &retval) const
+	{
+		const decision_vector &lb = m_prob.get_lb(), &ub = m_prob.get_ub();
+		for (std::vector<double>::size_type n = 0; n < m_ind.size(); ++n) {
+			const decision_vector::size_type a = m_ind[n].first, b = m_ind[n].second;
+			const double da = hh * (ub[a] - lb[a]), db = hh * (ub[b] - lb[b]);
+			if (a == b) {
+				decision_vector xu(m_x), xd(m_x);
+				xu[a] = xu[a] + da;
+				xd[a] -= da;
+				const bool out = xu[a] > ub[a] || xd[a] < lb[a];
+				fitness_vector fu, fd;
+				if (!out) {
+					fu = m_prob.objfun(xu);
+					fd = m_prob.objfun(xd);
+				}
+				for (matrix::size_type j = 0; j < retval.size(); ++j) {
+					retval[j][n] = out ? 0. : (fu[j] - 2 * m_fx[j] + fd[j]) / (hh * hh * m_span[j]);
+				}
+			} else {
+				decision_vector xuu(m_x), xdd(m_x), xud(m_x), xdu(m_x);
+				xuu[a] += da;
+				xuu[b] += db;
+				xdd[a] -= da;
+				xdd[b] -= db;
+				xud[a] += da;
+				xud[b] -= db;
+				xdu[a] -= da;
+				xdu[b] += db;
+				const bool out = xuu[a] > ub[a] || xuu[b] > ub[b] || xdd[a] < lb[a] || xdd[b] < lb[b] ||
+					xud[a] > ub[a] || xud[b] < lb[b] || xdu[a] < lb[a] || xdu[b] > ub[b];
+				fitness_vector fuu, fud, fdu, fdd;
+				if (!out) {
+					fuu = m_prob.objfun(xuu);
+					fud = m_prob.objfun(xud);
+					fdu = m_prob.objfun(xdu);
+					fdd = m_prob.objfun(xdd);
+				}
+				for (matrix::size_type j = 0; j < retval.size(); ++j) {
+					retval[j][n] = out ? 0. : (fuu[j] - fud[j] - fdu[j] + fdd[j]) / (4 * hh * hh * m_span[j]);
+				}
+			}
+		}
+	}
+	const problem::base								&m_prob;
+	const decision_vector								&m_x;
+	const std::vector<double>							&m_span;
+	const std::vector<std::pair<decision_vector::size_type,decision_vector::size_type> >	&m_ind;
+	const fitness_vector								m_fx;
+};
+
+// Evaluates one contiguous chunk of the points per work item, so that problems with a batch
+// objective function can use it.
+struct evaluate_functor
+{
+	evaluate_functor(const std::vector<decision_vector> &x, value_type type, std::size_t n_chunks, matrix &retval):
+		m_x(x),m_type(type),m_n_chunks(n_chunks),m_retval(retval) {}
+	void operator()(const problem::base &prob, std::size_t k) const
+	{
+		const std::size_t begin = (k * m_x.size()) / m_n_chunks, end = ((k + 1) * m_x.size()) / m_n_chunks;
+		if (m_type == FITNESS) {
+			const std::vector<decision_vector> chunk(m_x.begin() + begin,m_x.begin() + end);
+			const std::vector<fitness_vector> f = prob.objfun_batch(chunk);
+			std::copy(f.begin(),f.end(),m_retval.begin() + begin);
+		} else {
+			for (std::size_t i = begin; i < end; ++i) {
+				m_retval[i] = prob.compute_constraints(m_x[i]);
+			}
+		}
+	}
+	const std::vector<decision_vector>	&m_x;
+	const value_type			m_type;
+	const std::size_t			m_n_chunks;
+	matrix					&m_retval;
+};
+
+struct gradient_functor
+{
+	gradient_functor(const std::vector<decision_vector> &points, const std::vector<double> &span, double h, double tol,
+		unsigned int tmax, value_type type, std::vector<matrix> &retval):
+		m_points(points),m_span(span),m_h(h),m_tol(tol),m_tmax(tmax),m_type(type),m_retval(retval) {}
+	void operator()(const problem::base &prob, std::size_t i) const
+	{
+		const decision_vector x = descale(prob,m_points[i]);
+		m_retval[i] = richardson(gradient_stencil(prob,x,m_span,m_type),values_size(prob,m_type),
+			prob.get_dimension() - prob.get_i_dimension(),m_h,m_tol,m_tmax);
+	}
+	const std::vector<decision_vector>	&m_points;
+	const std::vector<double>		&m_span;
+	const double				m_h;
+	const double				m_tol;
+	const unsigned int			m_tmax;
+	const value_type			m_type;
+	std::vector<matrix>			&m_retval;
+};
+
+struct hessian_functor
+{
+	hessian_functor(const std::vector<decision_vector> &points, const std::vector<double> &span, double h, double tol,
+		unsigned int tmax, std::vector<std::vector<matrix> > &retval):
+		m_points(points),m_span(span),m_h(h),m_tol(tol),m_tmax(tmax),m_retval(retval) {}
+	void operator()(const problem::base &prob, std::size_t i) const
+	{
+		const decision_vector::size_type cont_dim = prob.get_dimension() - prob.get_i_dimension();
+		const fitness_vector::size_type f_dim = prob.get_f_dimension();
+		std::vector<std::pair<decision_vector::size_type,decision_vector::size_type> > ind;
+		for (decision_vector::size_type a = 0; a < cont_dim; ++a) {
+			for (decision_vector::size_type b = a; b < cont_dim; ++b) {
+				ind.push_back(std::make_pair(a,b));
+			}
+		}
+		const decision_vector x = descale(prob,m_points[i]);
+		const matrix d = richardson(hessian_stencil(prob,x,m_span,ind),f_dim,ind.size(),m_h,m_tol,m_tmax);
+		std::vector<matrix> retval(f_dim,matrix(cont_dim,std::vector<double>(cont_dim,0.)));
+		for (fitness_vector::size_type j = 0; j < f_dim; ++j) {
+			for (std::vector<double>::size_type n = 0; n < ind.size(); ++n) {
+				retval[j][ind[n].first][ind[n].second] = d[j][n];
+				retval[j][ind[n].second][ind[n].first] = d[j][n];
+			}
+		}
+		m_retval[i] = retval;
+	}
+	const std::vector<decision_vector>	&m_points;
+	const std::vector<double>		&m_span;
+	const double				m_h;
+	const double				m_tol;
+	const unsigned int			m_tmax;
+	std::vector<std::vector<matrix> >	&m_retval;
+};
+
+struct linearity_functor
+{
+	linearity_functor(const std::vector<decision_vector> &points, const matrix &values, const std::vector<double> &offset,
+		const std::vector<double> &span, const std::vector<int> &i1, const std::vector<int> &i2, const std::vector<double> &r,
+		value_type type, matrix &retval):
+		m_points(points),m_values(values),m_offset(offset),m_span(span),m_i1(i1),m_i2(i2),m_r(r),m_type(type),m_retval(retval) {}
+	// Scaled values at x.
+	std::vector<double> scaled_values(const problem::base &prob, const decision_vector &x) const
+	{
+		std::vector<double> retval = compute_values(prob,x,m_type);
+		for (std::vector<double>::size_type j = 0; j < retval.size(); ++j) {
+			retval[j] = (retval[j] - m_offset[j]) / m_span[j];
+		}
+		return retval;
+	}
+	void operator()(const problem::base &prob, std::size_t n) const
+	{
+		const decision_vector &p1 = m_points[m_i1[n]], &p2 = m_points[m_i2[n]];
+		const std::vector<double> &v1 = m_values[m_i1[n]];
+		const double r = m_r[n];
+		const decision_vector::size_type cont_dim = prob.get_dimension() - prob.get_i_dimension();
+		// Convex combination of the two points, the integer part being the one of the first point.
+		decision_vector x(p1.size());
+		for (decision_vector::size_type k = 0; k < x.size(); ++k) {
+			x[k] = (k < cont_dim) ? r * p1[k] + (1 - r) * p2[k] : p1[k];
+		}
+		std::vector<double> v2;
+		if (cont_dim != p1.size()) {
+			// The second end of the segment shares the integer part of the first one
+			decision_vector x2(p2.begin(),p2.begin() + cont_dim);
+			x2.insert(x2.end(),p1.begin() + cont_dim,p1.end());
+			v2 = scaled_values(prob,descale(prob,x2));
+		} else {
+			v2 = m_values[m_i2[n]];
+		}
+		const std::vector<double> v_real = scaled_values(prob,descale(prob,x));
+		std::vector<double> delta(v_real.size());
+		for (std::vector<double>::size_type j = 0; j < delta.size(); ++j) {
+			delta[j] = (r * v1[j] + (1 - r) * v2[j]) - v_real[j];
+		}
+		m_retval[n] = delta;
+	}
+	const std::vector<decision_vector>	&m_points;
+	const matrix				&m_values;
+	const std::vector<double>		&m_offset;
+	const std::vector<double>		&m_span;
+	const std::vector<int>			&m_i1;
+	const std::vector<int>			&m_i2;
+	const std::vector<double>		&m_r;
+	const value_type			m_type;
+	matrix					&m_retval;
+};
+
+static void check_span(const problem::base &prob, const std::vector<double> &span, value_type type)
+{
+	if (span.size() != values_size(prob,type)) {
+		pagmo_throw(value_error,"the size of the scaling factors does not match the dimension of the analysed values");
+	}
+}
+
+static void check_richardson(double h, unsigned int tmax)
+{
+	if (!(h > 0)) {
+		pagmo_throw(value_error,"the initial step of the finite differences must be positive");
+	}
+	if (tmax == 0) {
+		pagmo_throw(value_error,"at least one Richardson iteration is needed");
+	}
+}
+
+/// Sample the search space.
+/**
+ * Draws npoints points from the sampler, which must generate points in the unit hypercube of the dimension of the problem,
+ * and brings them into the bounds of the problem as u * ub + (1 - u) * lb. Integer variables are rounded to the nearest integer.
+ *
+ * @param[in] prob problem whose search space is sampled.
+ * @param[in] sampler low-discrepancy sequence (or latin hypercube) used to generate the points.
+ * @param[in] npoints number of points.
+ *
+ * @return the sampled decision vectors.
+ *
+ * @throws value_error if the points generated by sampler do not have the dimension of the problem.
+ */
+std::vector<decision_vector> sample(const problem::base &prob, discrepancy::base &sampler, unsigned int npoints)
+{
+	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
+	const decision_vector::size_type cont_dim = prob.get_dimension() - prob.get_i_dimension();
+	std::vector<decision_vector> retval(npoints);
+	for (unsigned int i = 0; i < npoints; ++i) {
+		retval[i] = sampler();
+		if (retval[i].size() != lb.size()) {
+			pagmo_throw(value_error,"the dimension of the sampler does not match the dimension of the problem");
+		}
+		for (decision_vector::size_type j = 0; j < lb.size(); ++j) {
+			retval[i][j] = retval[i][j] * ub[j] + (1 - retval[i][j]) * lb[j];
+			if (j >= cont_dim) {
+				retval[i][j] = std::nearbyint(retval[i][j]);
+			}
+		}
+	}
+	return retval;
+}
+
+/// Evaluate a set of points.
+/**
+ * The points are split in one contiguous chunk per thread. Fitness vectors are computed through problem::base::objfun_batch.
+ *
+ * @param[in] prob problem.
+ * @param[in] x decision vectors.
+ * @param[in] type whether the fitness or the constraint vectors are computed.
+ * @param[in] n_threads number of threads (0 for the number of hardware threads).
+ *
+ * @return fitness or constraint vectors of the points, in the same order.
+ */
+std::vector<std::vector<double> > evaluate(const problem::base &prob, const std::vector<decision_vector> &x, value_type type, unsigned int n_threads)
+{
+	matrix retval(x.size());
+	if (x.empty()) {
+		return retval;
+	}
+	const std::size_t n_chunks = n_workers(n_threads,x.size());
+	parallel_for(prob,n_chunks,n_threads,evaluate_functor(x,type,n_chunks,retval));
+	return retval;
+}
+
+/// Jacobian matrices by Richardson extrapolation.
+/**
+ * Central differences of the scaled values with respect to the scaled continuous variables, the step being
+ * h, h/2, h/4, ... times the width of the bounds. Where a step would leave the bounds the derivative is set to zero.
+ *
+ * @param[in] prob problem.
+ * @param[in] points points in the unit hypercube.
+ * @param[in] span scaling factors of the values.
+ * @param[in] h initial step.
+ * @param[in] tol convergence tolerance on two successive extrapolations.
+ * @param[in] tmax maximum number of iterations.
+ * @param[in] type whether the objectives or the constraints are derived.
+ * @param[in] n_threads number of threads (0 for the number of hardware threads).
+ *
+ * @return one matrix [value dimension][continuous dimension] per point.
+ *
+ * @throws value_error if h is not positive, if tmax is zero or if span has not the dimension of the values.
+ */
+std::vector<std::vector<std::vector<double> > > gradient(const problem::base &prob, const std::vector<decision_vector> &points,
+	const std::vector<double> &span, double h, double tol, unsigned int tmax, value_type type, unsigned int n_threads)
+{
+	check_richardson(h,tmax);
+	check_span(prob,span,type);
+	std::vector<matrix> retval(points.size());
+	parallel_for(prob,points.size(),n_threads,gradient_functor(points,span,h,tol,tmax,type,retval));
+	return retval;
+}
+
+/// Hessian tensors of the objectives by Richardson extrapolation.
+/**
+ * As gradient(), for the second derivatives of the scaled objectives.
+ *
+ * @param[in] prob problem.
+ * @param[in] points points in the unit hypercube.
+ * @param[in] span scaling factors of the objectives.
+ * @param[in] h initial step.
+ * @param[in] tol convergence tolerance on two successive extrapolations.
+ * @param[in] tmax maximum number of iterations.
+ * @param[in] n_threads number of threads (0 for the number of hardware threads).
+ *
+ * @return one tensor [fitness dimension][continuous dimension][continuous dimension] per point.
+ *
+ * @throws value_error if h is not positive, if tmax is zero or if span has not the fitness dimension.
+ */
+std::vector<std::vector<std::vector<std::vector<double> > > > hessian(const problem::base &prob, const std::vector<decision_vector> &points,
+	const std::vector<double> &span, double h, double tol, unsigned int tmax, unsigned int n_threads)
+{
+	check_richardson(h,tmax);
+	check_span(prob,span,FITNESS);
+	std::vector<std::vector<matrix> > retval(points.size());
+	parallel_for(prob,points.size(),n_threads,hessian_functor(points,span,h,tol,tmax,retval));
+	return retval;
+}
+
+/// Deviations from linearity along segments of the sample.
+/**
+ * For each test n, takes the point x at fraction r[n] of the segment between the points i1[n] and i2[n]
+ * (keeping the integer variables of the first one) and returns the difference between the linear interpolation
+ * of the scaled values and the scaled values at x. Positive deviations denote convexity.
+ *
+ * @param[in] prob problem.
+ * @param[in] points points in the unit hypercube.
+ * @param[in] values scaled values at the points.
+ * @param[in] offset offsets of the values.
+ * @param[in] span scaling factors of the values.
+ * @param[in] i1 indices of the first ends of the segments.
+ * @param[in] i2 indices of the second ends of the segments.
+ * @param[in] r interpolation coefficients.
+ * @param[in] type whether objectives or constraints are tested.
+ * @param[in] n_threads number of threads (0 for the number of hardware threads).
+ *
+ * @return one vector of deviations per test.
+ *
+ * @throws value_error if the sizes of the inputs are inconsistent.
+ * @throws index_error if an index is out of the sample.
+ */
+std::vector<std::vector<double> > linearity_deltas(const problem::base &prob, const std::vector<decision_vector> &points,
+	const std::vector<std::vector<double> > &values, const std::vector<double> &offset, const std::vector<double> &span,
+	const std::vector<int> &i1, const std::vector<int> &i2, const std::vector<double> &r, value_type type, unsigned int n_threads)
+{
+	check_span(prob,span,type);
+	if (offset.size() != span.size()) {
+		pagmo_throw(value_error,"the sizes of the offsets and of the scaling factors differ");
+	}
+	if (values.size() != points.size()) {
+		pagmo_throw(value_error,"the number of values does not match the number of points");
+	}
+	if (i1.size() != i2.size() || i1.size() != r.size()) {
+		pagmo_throw(value_error,"the sizes of the indices and of the interpolation coefficients differ");
+	}
+	for (std::vector<int>::size_type n = 0; n < i1.size(); ++n) {
+		if (i1[n] < 0 || i2[n] < 0 || static_cast<std::size_t>(i1[n]) >= points.size() || static_cast<std::size_t>(i2[n]) >= points.size()) {
+			pagmo_throw(index_error,"point index out of the sample");
+		}
+	}
+	matrix retval(i1.size());
+	parallel_for(prob,i1.size(),n_threads,linearity_functor(points,values,offset,span,i1,i2,r,type,retval));
+	return retval;
+}
+
+}}}
@@ -0,0 +1,71 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_UTIL_LANDSCAPE_H
+#define PAGMO_UTIL_LANDSCAPE_H
+
+#include <vector>
+
+#include "../config.h"
+#include "../problem/base.h"
+#include "../types.h"
+#include "discrepancy.h"
+
+namespace pagmo{ namespace util {
+
+/// Landscape analysis namespace.
+/**
+ * Numerical kernels of the fitness landscape analysis (PyGMO.util.analysis): sampling of the
+ * search space, evaluation of the sample, Richardson-extrapolated derivatives and the pairwise
+ * linearity/convexity tests.
+ *
+ * The expensive routines are spread over several threads, each working on its own clone of the problem.
+ * A number of threads equal to zero selects the number of hardware threads. Results do not
+ * depend on the number of threads.
+ *
+ * As in the Python class, decision vectors passed to the derivative and linearity routines are scaled to
+ * the unit hypercube, while fitness and constraint values are scaled as (value - offset) / span.
+ * Integer variables are the last ones of the decision vector and are kept fixed in the derivatives.
+*/
+namespace landscape {
+
+/// Kind of values analysed by a routine.
+enum value_type {
+	FITNESS = 0, ///< Objective function values.
+	CONSTRAINTS = 1 ///< Constraint values.
+};
+
+__PAGMO_VISIBLE_FUNC std::vector<decision_vector> sample(const problem::base &, discrepancy::base &, unsigned int);
+__PAGMO_VISIBLE_FUNC std::vector<std::vector<double> > evaluate(const problem::base &, const std::vector<decision_vector> &, value_type = FITNESS, unsigned int = 0);
+__PAGMO_VISIBLE_FUNC std::vector<std::vector<std::vector<double> > > gradient(const problem::base &, const std::vector<decision_vector> &,
+	const std::vector<double> &, double, double, unsigned int, value_type = FITNESS, unsigned int = 0);
+__PAGMO_VISIBLE_FUNC std::vector<std::vector<std::vector<std::vector<double> > > > hessian(const problem::base &, const std::vector<decision_vector> &,
+	const std::vector<double> &, double, double, unsigned int, unsigned int = 0);
+__PAGMO_VISIBLE_FUNC std::vector<std::vector<double> > linearity_deltas(const problem::base &, const std::vector<decision_vector> &,
+	const std::vector<std::vector<double> > &, const std::vector<double> &, const std::vector<double> &,
+	const std::vector<int> &, const std::vector<int> &, const std::vector<double> &, value_type = FITNESS, unsigned int = 0);
+
+}}}
+
+#endif
@@ -0,0 +1,94 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the GTOC asteroids catalogue
+
+#include <iostream>
+#include <vector>
+#include "../src/keplerian_toolbox/keplerian_toolbox.h"
+
+using namespace kep_toolbox;
+
+// Checks rows, names and ephemerides of a catalogue against the corresponding planets.
+template <class Asteroid>
+int test_catalogue(const asteroid_catalogue &cat, const std::vector<double>::size_type &n, const int &id_offset)
+{
+	if (cat.size() != n) {
+		std::cout << "wrong catalogue size" << std::endl;
+		return 1;
+	}
+	const epoch when(5000);
+	std::vector<array3D> r, v;
+	cat.get_eph(when, r, v);
+	for (std::vector<double>::size_type i = 0; i < n; ++i) {
+		const Asteroid ast(static_cast<int>(i) + id_offset);
+		const asteroid_ref ref(cat, i);
+		array3D r_ast, v_ast, r_ref, v_ref, r_cat, v_cat;
+		ast.get_eph(when, r_ast, v_ast);
+		ref.get_eph(when, r_ref, v_ref);
+		cat.get_eph(i, when, r_cat, v_cat);
+		if (r[i] != r_ast || v[i] != v_ast || r_ref != r_ast || v_ref != v_ast || r_cat != r_ast || v_cat != v_ast) {
+			std::cout << "wrong ephemerides of row " << i << std::endl;
+			return 1;
+		}
+		if (cat.get_name(i) != ast.get_name() || cat.get_planet(i)->get_name() != ast.get_name() ||
+			ref.get_elements() != ast.get_elements() || ref.get_ref_epoch().mjd2000() != ast.get_ref_epoch().mjd2000()) {
+			std::cout << "wrong data of row " << i << std::endl;
+			return 1;
+		}
+	}
+	try {
+		asteroid_ref(cat, n);
+		std::cout << "out of range row not detected" << std::endl;
+		return 1;
+	} catch (const std::exception &) {}
+	return 0;
+}
+
+int main()
+{
+	int res = 0;
+	res |= test_catalogue<asteroid_gtoc2>(asteroid_catalogue::gtoc2(), 911, 0);
+	res |= test_catalogue<asteroid_gtoc5>(asteroid_catalogue::gtoc5(), 7076, 1);
+	// Groups and an independent check of the data conversion (the Earth rows, from the original data files)
+	const asteroid_catalogue &gtoc2 = asteroid_catalogue::gtoc2();
+	if (gtoc2.get_group(0) != 1 || gtoc2.get_group(909) != 4 || gtoc2.get_group(910) != 5 || asteroid_catalogue::gtoc5().get_group(0) != 0) {
+		std::cout << "wrong groups" << std::endl;
+		res = 1;
+	}
+	const array6D elem = {{0.999988049532578 * ASTRO_AU, 0.0167168116316, 0.0009954353079654 * ASTRO_DEG2RAD,
+		175.40647696473 * ASTRO_DEG2RAD, 287.61577546182 * ASTRO_DEG2RAD, 257.60683707535 * ASTRO_DEG2RAD}};
+	const planet earth(epoch(54000, epoch::MJD), elem, ASTRO_MU_SUN, 1, 1, 1);
+	array3D r_earth, v_earth, r, v;
+	earth.get_eph(epoch(6000), r_earth, v_earth);
+	asteroid_catalogue::gtoc5().get_eph(7075, epoch(6000), r, v);
+	if (r != r_earth || v != v_earth) {
+		std::cout << "wrong GTOC5 Earth ephemerides" << std::endl;
+		res = 1;
+	}
+	if (res == 0) {
+		std::cout << "asteroid catalogue passes." << std::endl;
+	}
+	return res;
+}
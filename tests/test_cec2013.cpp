@@ -0,0 +1,208 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the CEC2013 problems: sharing of the data among instances, and fitness values.
+
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+// The competition data is not shipped with PaGMO: the test writes synthetic data, ten orthogonal matrices
+// (Gram-Schmidt on a fixed pseudo-random matrix) and ten shifts, enough for the composition functions. The data
+// goes in the default directory (created by CMake), as deserialisation default-constructs the problems (dimension 30).
+static const std::string data_prefix = "input_data/";
+static const unsigned int dim = 10;
+
+static void write_data(unsigned int n)
+{
+	std::ostringstream rot_name;
+	rot_name << data_prefix << "M_D" << n << ".txt";
+	std::ofstream rot(rot_name.str().c_str());
+	rot.precision(17);
+	for (unsigned int m = 0; m < 10; ++m) {
+		std::vector<std::vector<double> > q(n,std::vector<double>(n));
+		for (unsigned int i = 0; i < n; ++i) {
+			for (unsigned int j = 0; j < n; ++j) {
+				q[i][j] = std::sin(0.37 * ((m * n + i) * n + j) + 1.);
+			}
+			for (unsigned int k = 0; k < i; ++k) {
+				double dot = 0.;
+				for (unsigned int j = 0; j < n; ++j) {
+					dot += q[i][j] * q[k][j];
+				}
+				for (unsigned int j = 0; j < n; ++j) {
+					q[i][j] -= dot * q[k][j];
+				}
+			}
+			double norm = 0.;
+			for (unsigned int j = 0; j < n; ++j) {
+				norm += q[i][j] * q[i][j];
+			}
+			for (unsigned int j = 0; j < n; ++j) {
+				rot << q[i][j] / std::sqrt(norm) << (j + 1 < n ? ' ' : '\n');
+				q[i][j] /= std::sqrt(norm);
+			}
+		}
+	}
+	std::ofstream shift((data_prefix + "shift_data.txt").c_str());
+	shift.precision(17);
+	for (unsigned int k = 0; k < 10 * 100; ++k) {
+		shift << 80. * std::sin(1.3 * k) << ((k + 1) % 100 ? ' ' : '\n');
+	}
+}
+
+// A point near the shifted optimum of the first function: far from it the asymmetric transformation raises the
+// coordinates to large powers, where cos(2 pi z) and friends amplify any rounding difference.
+static decision_vector test_point()
+{
+	decision_vector x(dim);
+	for (unsigned int j = 0; j < dim; ++j) {
+		x[j] = 80. * std::sin(1.3 * j) + 2. * std::cos(0.9 * j + 0.2);
+	}
+	return x;
+}
+
+// Fitness values of the 28 problems at test_point(), computed with the original implementation
+// (single accumulator rotation, data parsed by each instance).
+static const double baseline[28] = {
+	-1380.6334525991197,
+	240864.55379082839,
+	19644990.358155787,
+	464934.75527446129,
+	-992.80379070387141,
+	-896.25311950171385,
+	-791.90603502248121,
+	-690.15790932178197,
+	-597.57720806499128,
+	-497.40547128630686,
+	-370.79349128812851,
+	-273.34668762261231,
+	-173.34668762261234,
+	717.93844340706664,
+	620.86528321204605,
+	211.31211735602267,
+	409.44958405927628,
+	446.30753210981936,
+	510.62256824279785,
+	604.72637705280363,
+	735.35567153478473,
+	1691.4994958363268,
+	1497.5834951900542,
+	1134.4144013641942,
+	1238.2988820732683,
+	1330.622287078849,
+	1563.9035026613235,
+	1677.7872121189548
+};
+
+// Copies and deserialised instances must share the same data, also when the archive is loaded in a process
+// (here: a scope) where no instance built from the data files exists.
+int test_sharing()
+{
+	std::string archive;
+	{
+		const problem::cec2013 prob(1,dim,data_prefix);
+		const problem::cec2013 copy(prob);
+		const problem::base_ptr clone = prob.clone();
+		if (&copy.rotation_matrix() != &prob.rotation_matrix() ||
+			&dynamic_cast<const problem::cec2013 &>(*clone).rotation_matrix() != &prob.rotation_matrix())
+		{
+			std::cout << "copies do not share the data!" << std::endl;
+			return 1;
+		}
+		std::ostringstream oss;
+		{
+			boost::archive::text_oarchive oa(oss);
+			oa << clone;
+		}
+		archive = oss.str();
+		// Round trip while the data is loaded.
+		problem::base_ptr loaded;
+		std::istringstream iss(archive);
+		{
+			boost::archive::text_iarchive ia(iss);
+			ia >> loaded;
+		}
+		if (&dynamic_cast<const problem::cec2013 &>(*loaded).rotation_matrix() != &prob.rotation_matrix()) {
+			std::cout << "deserialised copy does not share the loaded data!" << std::endl;
+			return 1;
+		}
+	}
+	// No instance is alive anymore: the first deserialised copy registers the data for the following ones.
+	problem::base_ptr p1, p2;
+	std::istringstream iss1(archive), iss2(archive);
+	{
+		boost::archive::text_iarchive ia(iss1);
+		ia >> p1;
+	}
+	{
+		boost::archive::text_iarchive ia(iss2);
+		ia >> p2;
+	}
+	const problem::cec2013 &c1 = dynamic_cast<const problem::cec2013 &>(*p1), &c2 = dynamic_cast<const problem::cec2013 &>(*p2);
+	if (&c1.rotation_matrix() != &c2.rotation_matrix() || c1.rotation_matrix() != problem::cec2013(1,dim,data_prefix).rotation_matrix()) {
+		std::cout << "deserialised copies do not share the data!" << std::endl;
+		return 1;
+	}
+	std::cout << "data sharing passes." << std::endl;
+	return 0;
+}
+
+// The rotations sum in a different order than the original implementation: the values agree within a relative tolerance.
+int test_fitness()
+{
+	const decision_vector x = test_point();
+	for (unsigned int i = 1; i <= 28; ++i) {
+		const double f = problem::cec2013(i,dim,data_prefix).objfun(x)[0];
+		if (std::fabs(f - baseline[i - 1]) > 1E-12 * std::max(1.,std::fabs(baseline[i - 1]))) {
+			std::cout.precision(17);
+			std::cout << "fitness of problem " << i << " failed! " << f << " vs " << baseline[i - 1] << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "fitness passes." << std::endl;
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	write_data(dim);
+	write_data(30);
+	if (argc > 1 && std::string(argv[1]) == "--dump") {
+		std::cout.precision(17);
+		for (unsigned int i = 1; i <= 28; ++i) {
+			std::cout << "\t" << problem::cec2013(i,dim,data_prefix).objfun(test_point())[0] << ",\n";
+		}
+		return 0;
+	}
+	return test_sharing() | test_fitness();
+}
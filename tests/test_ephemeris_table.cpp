@@ -0,0 +1,80 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the ephemeris tables
+
+#include <iostream>
+#include <cmath>
+#include "../src/keplerian_toolbox/keplerian_toolbox.h"
+
+using namespace kep_toolbox;
+
+static double distance(const array3D &a, const array3D &b)
+{
+	return std::sqrt((a[0]-b[0])*(a[0]-b[0]) + (a[1]-b[1])*(a[1]-b[1]) + (a[2]-b[2])*(a[2]-b[2]));
+}
+
+int main()
+{
+	const char *names[] = {"mercury","earth","jupiter"};
+	const double tol = 1e-9;
+	for (int p = 0; p < 3; ++p) {
+		planet_ss exact(names[p]), tabulated(names[p]);
+		tabulated.set_ephemeris_table(epoch(0),epoch(3000),tol);
+		// Copies share the table.
+		planet_ptr copy = tabulated.clone();
+		if (copy->get_ephemeris_table() != tabulated.get_ephemeris_table()) {
+			std::cout << "the table of " << names[p] << " is not shared among clones" << std::endl;
+			return 1;
+		}
+		// Within the window the interpolation error is below the tolerance (with some margin, as the
+		// error is measured at a few points per interval only), outside it the exact ephemerides are used.
+		for (double t = -100; t < 3100; t += 0.37) {
+			array3D r, v, rt, vt;
+			exact.get_eph(epoch(t),r,v);
+			copy->get_eph(epoch(t),rt,vt);
+			const double margin = (t < 0 || t > 3000) ? 0 : 2 * tol;
+			if (distance(r,rt) > margin * norm(r) || distance(v,vt) > margin * norm(v)) {
+				std::cout << "the interpolated ephemerides of " << names[p] << " are wrong at " << t << std::endl;
+				return 1;
+			}
+		}
+		tabulated.clear_ephemeris_table();
+		if (tabulated.get_ephemeris_table()) {
+			std::cout << "the table of " << names[p] << " was not cleared" << std::endl;
+			return 1;
+		}
+	}
+	// A window needing more than the maximum number of nodes is rejected (a keplerian planet has no validity range).
+	const array6D elements = {{0.4 * ASTRO_AU, 0.2, 0.1, 0, 0, 0}};
+	const planet kep(epoch(0),elements,ASTRO_MU_SUN,1,1,1);
+	try {
+		planet copy(kep);
+		copy.set_ephemeris_table(epoch(0),epoch(3e6));
+		std::cout << "a table exceeding the maximum number of nodes was built" << std::endl;
+		return 1;
+	} catch (const std::exception &) {}
+	std::cout << "ephemeris tables pass." << std::endl;
+	return 0;
+}
@@ -0,0 +1,127 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the Golomb ruler problem: length and duplicate distances against the sort-based implementation.
+
+#include <algorithm>
+#include <boost/random/lagged_fibonacci.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <iostream>
+#include <iterator>
+#include <vector>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+// Length and number of duplicate distances of the ruler encoded by x, sorting all the distances between marks.
+static void reference(double &length, double &duplicates, const decision_vector &x)
+{
+	decision_vector marks(x.size() + 1,0.), dist;
+	for (decision_vector::size_type i = 0; i < x.size(); ++i) {
+		marks[i + 1] = marks[i] + x[i];
+	}
+	for (decision_vector::size_type i = 0; i < marks.size() - 1; ++i) {
+		for (decision_vector::size_type j = i + 1; j < marks.size(); ++j) {
+			dist.push_back(marks[j] - marks[i]);
+		}
+	}
+	length = *std::max_element(dist.begin(),dist.end());
+	std::sort(dist.begin(),dist.end());
+	duplicates = static_cast<double>(dist.size()) - std::distance(dist.begin(),std::unique(dist.begin(),dist.end()));
+}
+
+static int check(const problem::golomb_ruler &prob, const decision_vector &x)
+{
+	double length, duplicates;
+	reference(length,duplicates,x);
+	const fitness_vector f = prob.objfun(x);
+	const constraint_vector c = prob.compute_constraints(x);
+	if (f[0] != length || c[0] != duplicates) {
+		std::cout << "golomb_ruler mismatch at " << x << ": length " << f[0] << " vs " << length
+			<< ", duplicates " << c[0] << " vs " << duplicates << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// Random integer rulers (with and without null distances, the latter giving coincident marks) and random
+// non-integer rulers, for several orders and maximum distances (spanning one or more words of the bitset).
+int test_random(boost::lagged_fibonacci607 &rng)
+{
+	const int orders[] = {2, 5, 10, 20, 40}, max_dists[] = {1, 3, 10, 70};
+	for (unsigned o = 0; o < sizeof(orders) / sizeof(int); ++o) {
+		for (unsigned m = 0; m < sizeof(max_dists) / sizeof(int); ++m) {
+			const problem::golomb_ruler prob(orders[o],max_dists[m]);
+			decision_vector x(prob.get_dimension());
+			for (int k = 0; k < 200; ++k) {
+				boost::uniform_int<int> dist_int(k % 2,max_dists[m]);
+				boost::variate_generator<boost::lagged_fibonacci607 &, boost::uniform_int<int> > rnd_int(rng,dist_int);
+				for (decision_vector::size_type i = 0; i < x.size(); ++i) {
+					x[i] = rnd_int();
+				}
+				if (check(prob,x)) {
+					return 1;
+				}
+				// Non-integer distances, some of them truncating to the same integer.
+				boost::uniform_real<double> dist_real(0.,1.);
+				boost::variate_generator<boost::lagged_fibonacci607 &, boost::uniform_real<double> > rnd_real(rng,dist_real);
+				for (decision_vector::size_type i = 0; i < x.size(); ++i) {
+					if (rnd_real() < 0.3) {
+						x[i] += 0.5;
+					}
+				}
+				if (check(prob,x)) {
+					return 1;
+				}
+			}
+		}
+	}
+	std::cout << "golomb_ruler random rulers pass." << std::endl;
+	return 0;
+}
+
+// Known rulers: the optimal Golomb ruler of order 5 (0 1 4 9 11) and a ruler with repeated distances.
+int test_known()
+{
+	const problem::golomb_ruler prob(5,10);
+	const double golomb[] = {1, 3, 5, 2}, regular[] = {2, 2, 2, 2};
+	if (prob.compute_constraints(decision_vector(golomb,golomb + 4))[0] != 0 ||
+		prob.objfun(decision_vector(golomb,golomb + 4))[0] != 11 ||
+		// Distances 2 (4 times), 4 (3 times), 6 (twice), 8: 6 duplicates.
+		prob.compute_constraints(decision_vector(regular,regular + 4))[0] != 6)
+	{
+		std::cout << "golomb_ruler known rulers failed." << std::endl;
+		return 1;
+	}
+	std::cout << "golomb_ruler known rulers pass." << std::endl;
+	return 0;
+}
+
+int main()
+{
+	boost::lagged_fibonacci607 rng(42);
+	return test_known() | test_random(rng);
+}
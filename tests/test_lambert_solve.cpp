@@ -0,0 +1,87 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the zero revolutions Lambert solvers lambert_problem::solve() and lambert_problem::solve_batch()
+
+#include <iostream>
+#include <vector>
+#include "../src/keplerian_toolbox/keplerian_toolbox.h"
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+
+using namespace kep_toolbox;
+
+// Checks that solve() and solve_batch() return exactly the zero revolutions solution of lambert_problem
+// on n random geometries with times of flight in [tof_min, tof_max], for the given mu and direction of motion.
+int test_solve(double tof_min, double tof_max, double mu, int cw)
+{
+	boost::mt19937 gen(23);
+	boost::variate_generator<boost::mt19937 &, boost::uniform_real<double> > drng(gen,boost::uniform_real<double>(0,1));
+	const int n = 500;
+	std::vector<array3D> r1(n), r2(n), v1_batch, v2_batch;
+	std::vector<double> tof(n);
+	for (int k = 0; k < n; ++k) {
+		for (int i = 0; i < 3; ++i) {
+			r1[k][i] = drng() * 4 - 2;
+			r2[k][i] = drng() * 4 - 2;
+		}
+		tof[k] = tof_min + (tof_max - tof_min) * drng();
+	}
+	lambert_problem::solve_batch(v1_batch,v2_batch,r1,r2,tof,mu,cw);
+	if (v1_batch.size() != r1.size() || v2_batch.size() != r1.size()) {
+		std::cout << "solve_batch returned the wrong number of solutions!" << std::endl;
+		return 1;
+	}
+	for (int k = 0; k < n; ++k) {
+		const lambert_problem lp(r1[k],r2[k],tof[k],mu,cw);
+		array3D v1, v2;
+		lambert_problem::solve(v1,v2,r1[k],r2[k],tof[k],mu,cw);
+		if (v1 != lp.get_v1()[0] || v2 != lp.get_v2()[0]) {
+			std::cout << "solve differs from lambert_problem! r1=" << r1[k] << " r2=" << r2[k] << " tof=" << tof[k] << " cw=" << cw << std::endl;
+			return 1;
+		}
+		if (v1_batch[k] != lp.get_v1()[0] || v2_batch[k] != lp.get_v2()[0]) {
+			std::cout << "solve_batch differs from lambert_problem! r1=" << r1[k] << " r2=" << r2[k] << " tof=" << tof[k] << " cw=" << cw << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "Lambert solve passes (tof in [" << tof_min << "," << tof_max << "], mu=" << mu << ", cw=" << cw << ")." << std::endl;
+	return 0;
+}
+
+int main()
+{
+	int res = 0;
+	// Short arcs, mostly hyperbolic.
+	res |= test_solve(0.01,1.,1.,0);
+	res |= test_solve(0.01,1.,1.,1);
+	// Arcs of the order of one period.
+	res |= test_solve(1.,10.,1.,0);
+	res |= test_solve(1.,10.,3.5,1);
+	// Long times of flight, where multiple revolutions solutions exist as well.
+	res |= test_solve(10.,200.,1.,0);
+	res |= test_solve(10.,200.,0.5,1);
+	return res;
+}
@@ -0,0 +1,144 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the landscape analysis engine
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/landscape.h"
+
+using namespace pagmo;
+using namespace pagmo::util;
+
+const double EPS = 10e-7;
+
+// Sample of the unit hypercube for prob.
+std::vector<decision_vector> unit_sample(const problem::base &prob, unsigned int n)
+{
+	discrepancy::sobol sampler(prob.get_dimension(),1);
+	std::vector<decision_vector> retval;
+	for (unsigned int i = 0; i < n; ++i) {
+		retval.push_back(sampler());
+	}
+	return retval;
+}
+
+// Sampling and evaluation must agree with a serial evaluation, whatever the number of threads.
+int test_evaluate(const problem::base &prob)
+{
+	discrepancy::sobol sampler(prob.get_dimension(),1);
+	const std::vector<decision_vector> x = landscape::sample(prob,sampler,53);
+	for (unsigned int n_threads = 1; n_threads <= 4; ++n_threads) {
+		const std::vector<fitness_vector> f = landscape::evaluate(prob,x,landscape::FITNESS,n_threads);
+		for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+			if (f[i] != prob.objfun(x[i])) {
+				std::cout << prob.get_name() << " evaluation with " << n_threads << " threads failed!" << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << prob.get_name() << " evaluation passes." << std::endl;
+	return 0;
+}
+
+// De Jong's function sum(x_i^2): the scaled gradient is 2 x_i (ub_i - lb_i) / span and the scaled Hessian
+// is diagonal with 2 (ub_i - lb_i)^2 / span.
+int test_derivatives()
+{
+	const problem::dejong prob(5);
+	const std::vector<double> span(1,7.);
+	const std::vector<decision_vector> points = unit_sample(prob,20);
+	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
+	const std::vector<std::vector<std::vector<double> > > grad = landscape::gradient(prob,points,span,0.01,1e-6,15,landscape::FITNESS,3);
+	const std::vector<std::vector<std::vector<std::vector<double> > > > hess = landscape::hessian(prob,points,span,0.01,1e-6,15,3);
+	const std::vector<std::vector<std::vector<double> > > grad_serial = landscape::gradient(prob,points,span,0.01,1e-6,15,landscape::FITNESS,1);
+	if (grad != grad_serial) {
+		std::cout << "gradient depends on the number of threads!" << std::endl;
+		return 1;
+	}
+	for (std::vector<decision_vector>::size_type n = 0; n < points.size(); ++n) {
+		for (decision_vector::size_type i = 0; i < lb.size(); ++i) {
+			const double x = points[n][i] * (ub[i] - lb[i]) + lb[i], width = ub[i] - lb[i];
+			// Steps leaving the bounds give a zero derivative.
+			if (grad[n][0][i] != 0 && std::fabs(grad[n][0][i] - 2 * x * width / span[0]) > EPS) {
+				std::cout << "gradient failed! " << grad[n][0][i] << " vs " << 2 * x * width / span[0] << std::endl;
+				return 1;
+			}
+			for (decision_vector::size_type j = 0; j < lb.size(); ++j) {
+				const double expected = (i == j) ? 2 * width * width / span[0] : 0.;
+				if (hess[n][0][i][j] != 0 && std::fabs(hess[n][0][i][j] - expected) > EPS) {
+					std::cout << "hessian failed! " << hess[n][0][i][j] << " vs " << expected << std::endl;
+					return 1;
+				}
+			}
+		}
+	}
+	std::cout << "derivatives pass." << std::endl;
+	return 0;
+}
+
+// De Jong's function is convex: the linear interpolation lies above the function.
+int test_linearity()
+{
+	const problem::dejong prob(5);
+	const std::vector<decision_vector> points = unit_sample(prob,30);
+	std::vector<decision_vector> x;
+	for (std::vector<decision_vector>::size_type i = 0; i < points.size(); ++i) {
+		decision_vector xi(points[i]);
+		for (decision_vector::size_type j = 0; j < xi.size(); ++j) {
+			xi[j] = xi[j] * (prob.get_ub()[j] - prob.get_lb()[j]) + prob.get_lb()[j];
+		}
+		x.push_back(xi);
+	}
+	const std::vector<fitness_vector> f = landscape::evaluate(prob,x);
+	const std::vector<double> offset(1,0.), span(1,1.);
+	std::vector<int> i1, i2;
+	std::vector<double> r;
+	for (int i = 0; i < 29; ++i) {
+		i1.push_back(i);
+		i2.push_back(i + 1);
+		r.push_back(0.3);
+	}
+	const std::vector<std::vector<double> > deltas = landscape::linearity_deltas(prob,points,f,offset,span,i1,i2,r,landscape::FITNESS,2);
+	for (std::vector<int>::size_type n = 0; n < i1.size(); ++n) {
+		if (deltas[n][0] < 0) {
+			std::cout << "linearity test failed! " << deltas[n][0] << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "linearity test passes." << std::endl;
+	return 0;
+}
+
+int main()
+{
+	int res = 0;
+	res |= test_evaluate(problem::ackley(7));
+	res |= test_evaluate(problem::zdt(1,9));
+	res |= test_derivatives();
+	res |= test_linearity();
+	return res;
+}
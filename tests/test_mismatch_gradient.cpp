@@ -0,0 +1,178 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the analytic jacobians of the state mismatches of low-thrust legs
+
+#include <algorithm>
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/keplerian_toolbox/keplerian_toolbox.h"
+
+using namespace kep_toolbox;
+using namespace kep_toolbox::sims_flanagan;
+
+// Checks the state transition matrix of the lagrangian propagation against central differences.
+int test_stm()
+{
+	const double mu = ASTRO_MU_SUN;
+	array3D r0[2] = {{{1.2e11,-0.5e11,0.1e11}},{{1.5e11,0.2e11,0.05e11}}};
+	// Elliptical and hyperbolic orbits.
+	array3D v0[2] = {{{10e3,28e3,1e3}},{{5e3,45e3,3e3}}};
+	const double t[3] = {200 * ASTRO_DAY2SEC, -100 * ASTRO_DAY2SEC, 900 * ASTRO_DAY2SEC};
+	for (int k = 0; k < 2; ++k) {
+		for (int q = 0; q < 3; ++q) {
+			array3D r = r0[k], v = v0[k];
+			boost::array<double,36> stm;
+			propagate_lagrangian_stm(r,v,t[q],mu,stm);
+			for (int j = 0; j < 6; ++j) {
+				array3D rp = r0[k], vp = v0[k], rm = r0[k], vm = v0[k];
+				const double h = (j < 3) ? 1e3 : 1e-3;
+				if (j < 3) {
+					rp[j] += h;
+					rm[j] -= h;
+				} else {
+					vp[j - 3] += h;
+					vm[j - 3] -= h;
+				}
+				propagate_lagrangian(rp,vp,t[q],mu);
+				propagate_lagrangian(rm,vm,t[q],mu);
+				for (int i = 0; i < 6; ++i) {
+					const double num = ((i < 3) ? rp[i] - rm[i] : vp[i - 3] - vm[i - 3]) / (2 * h);
+					// Typical magnitude of the entry, in SI units.
+					const double ref = (i < 3) ? ((j < 3) ? 1. : 1e6) : ((j < 3) ? 1e-6 : 1.);
+					if (std::fabs(stm[i * 6 + j] - num) > 1e-5 * (std::fabs(num) + ref)) {
+						std::cout << "state transition matrix failed at entry (" << i << "," << j << "): " << stm[i * 6 + j] << " vs " << num << std::endl;
+						return 1;
+					}
+				}
+			}
+		}
+	}
+	std::cout << "state transition matrix passes." << std::endl;
+	return 0;
+}
+
+// Checks the jacobian of the state mismatch of a leg against central differences.
+int test_leg(const int n_seg)
+{
+	const double mu = ASTRO_MU_SUN;
+	const epoch t_i(1000), t_f(1400);
+	const sc_state x_i(array3D{{1.4e11,-0.3e11,0.1e10}},array3D{{8e3,27e3,0.5e3}},1000);
+	const sc_state x_f(array3D{{-1.2e11,1.7e11,0.3e10}},array3D{{-19e3,-13e3,0.2e3}},800);
+	std::vector<double> thr(3 * n_seg);
+	for (int k = 0; k < 3 * n_seg; ++k) {
+		thr[k] = std::sin(1. + k) * 0.5;
+	}
+	leg l(t_i,x_i,thr,t_f,x_f,spacecraft(1000,0.3,3000),mu);
+	const int n_col = 14 + 3 * n_seg;
+	std::vector<double> jac(7 * n_col);
+	l.get_mismatch_con_gradient(jac.begin(),jac.end());
+	// Scale of the columns (initial state, throttles, final state) and of the rows.
+	const double col_scale[7] = {1e6,1e6,1e6,1.,1.,1.,1.}, row_scale[7] = {1e6,1e6,1e6,1.,1.,1.,1.};
+	for (int j = 0; j < n_col; ++j) {
+		array7D x_p, x_m;
+		std::vector<double> thr_p(thr), thr_m(thr);
+		sc_state xi_p(x_i), xi_m(x_i), xf_p(x_f), xf_m(x_f);
+		double h;
+		if (j < 7 || j >= 7 + 3 * n_seg) {
+			const int c = (j < 7) ? j : j - 7 - 3 * n_seg;
+			h = col_scale[c] * 1e-3;
+			array7D s_p = ((j < 7) ? x_i : x_f).get_state(), s_m = s_p;
+			s_p[c] += h;
+			s_m[c] -= h;
+			if (j < 7) {
+				xi_p.set_state(s_p);
+				xi_m.set_state(s_m);
+			} else {
+				xf_p.set_state(s_p);
+				xf_m.set_state(s_m);
+			}
+		} else {
+			h = 1e-4;
+			thr_p[j - 7] += h;
+			thr_m[j - 7] -= h;
+		}
+		leg l_p(t_i,xi_p,thr_p,t_f,xf_p,spacecraft(1000,0.3,3000),mu), l_m(t_i,xi_m,thr_m,t_f,xf_m,spacecraft(1000,0.3,3000),mu);
+		l_p.get_mismatch_con(x_p.begin(),x_p.end());
+		l_m.get_mismatch_con(x_m.begin(),x_m.end());
+		const double cs = (j < 7) ? col_scale[j] : ((j >= 7 + 3 * n_seg) ? col_scale[j - 7 - 3 * n_seg] : 1.);
+		for (int i = 0; i < 7; ++i) {
+			// Compare the jacobian in units of the typical magnitudes of the mismatches and of the variables.
+			const double num = (x_p[i] - x_m[i]) / (2 * h) * cs / row_scale[i], an = jac[i * n_col + j] * cs / row_scale[i];
+			if (std::fabs(an - num) > 1e-5 * (1. + std::fabs(num))) {
+				std::cout << "leg jacobian (" << n_seg << " segments) failed at entry (" << i << "," << j << "): " << an << " vs " << num << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << "leg jacobian (" << n_seg << " segments) passes." << std::endl;
+	return 0;
+}
+
+// Checks the analytic jacobian of the constraints of gtoc_2 against the numerical one.
+int test_gtoc_2()
+{
+	pagmo::problem::gtoc_2 prob(815,300,110,47,5);
+	pagmo::population pop(prob,3);
+	std::vector<double> jac, num(prob.get_c_dimension() * prob.get_dimension());
+	for (pagmo::population::size_type p = 0; p < pop.size(); ++p) {
+		const pagmo::decision_vector &x = pop.get_individual(p).cur_x;
+		prob.constraints_gradient(jac,x);
+		// Central differences on every component, with the scheme of the default implementation.
+		const double h0 = 1e-8;
+		pagmo::decision_vector dx(x);
+		for (pagmo::decision_vector::size_type j = 0; j < x.size(); ++j) {
+			const double h = h0 * std::max(1.,std::fabs(dx[j]));
+			dx[j] = x[j] + h;
+			const pagmo::constraint_vector c_p = prob.compute_constraints(dx);
+			dx[j] = x[j] - h;
+			const pagmo::constraint_vector c_m = prob.compute_constraints(dx);
+			dx[j] = x[j];
+			for (pagmo::problem::base::c_size_type i = 0; i < c_p.size(); ++i) {
+				num[i * x.size() + j] = (c_p[i] - c_m[i]) / (2 * h);
+			}
+		}
+		for (std::vector<double>::size_type k = 0; k < jac.size(); ++k) {
+			if (std::fabs(jac[k] - num[k]) > 1e-4 * (1. + std::fabs(num[k]))) {
+				std::cout << "gtoc_2 jacobian failed at entry " << k << ": " << jac[k] << " vs " << num[k] << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << "gtoc_2 jacobian passes." << std::endl;
+	return 0;
+}
+
+int main()
+{
+	int res = 0;
+	res |= test_stm();
+	res |= test_leg(1);
+	res |= test_leg(10);
+	res |= test_leg(11);
+	res |= test_gtoc_2();
+	return res;
+}
@@ -0,0 +1,99 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the MPCORB catalogue
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "../src/keplerian_toolbox/keplerian_toolbox.h"
+
+using namespace kep_toolbox;
+
+static double distance(const array3D &a, const array3D &b)
+{
+	return std::sqrt((a[0]-b[0])*(a[0]-b[0]) + (a[1]-b[1])*(a[1]-b[1]) + (a[2]-b[2])*(a[2]-b[2]));
+}
+
+int main()
+{
+	const std::string ceres("00001    3.34  0.12 K107N 113.41048   72.58976   80.39321   10.58682  0.0791382  0.21432817   2.7653485  0 MPO110568  6063  94 1802-2006 0.61 M-v 30h MPCW       0000      (1) Ceres              20061025");
+	// Build a small catalogue with a header and variations of the Ceres record
+	std::vector<std::string> records;
+	const char *anomalies[] = {"113.41048", " 10.00000", "200.12345", "359.99999"};
+	const char *names[] = {"(1) Ceres           ", "(2) Foo             ", "(3) Bar             ", "(4) Baz             "};
+	for (int k = 0; k < 4; ++k) {
+		std::string rec(ceres);
+		rec.replace(4, 1, 1, '1' + k);
+		rec.replace(26, 9, anomalies[k]);
+		rec.replace(166, 20, names[k]);
+		records.push_back(rec);
+	}
+	const std::string filename("test_mpcorb_catalogue.dat");
+	{
+		std::ofstream f(filename.c_str());
+		f << "MINOR PLANET CENTER ORBIT DATABASE (MPCORB)\n\nDes'n     H     G   Epoch     M        Peri.      Node       Incl.       e            n           a        Reference #Obs #Opp    Arc    rms  Perts   Computer\n";
+		f << "----------------------------------------------------------------------------------------------------------------------------------------------------------------\n";
+		for (std::vector<std::string>::size_type k = 0; k < records.size(); ++k) {
+			f << records[k] << ((k == 1) ? "\r\n\n" : "\n");
+		}
+	}
+	mpcorb_catalogue cat(filename), cat_mt(filename, 3);
+	std::remove(filename.c_str());
+	if (cat.size() != records.size() || cat_mt.size() != records.size()) {
+		std::cout << "wrong number of records" << std::endl;
+		return 1;
+	}
+	std::vector<array3D> r, v, r_mt, v_mt;
+	const epoch when(5000);
+	cat.get_eph(when, r, v);
+	cat_mt.get_eph(when, r_mt, v_mt);
+	for (std::vector<std::string>::size_type k = 0; k < records.size(); ++k) {
+		planet_mpcorb ref(records[k]);
+		// Lookups by name and designation
+		if (cat.find(ref.get_name()) != k || cat.find(cat.get_designation(k)) != k || cat.get_H(k) != ref.get_H()) {
+			std::cout << "wrong lookup of record " << k << std::endl;
+			return 1;
+		}
+		if (cat.get_n_observations(k) != ref.get_n_observations() || cat.get_n_oppositions(k) != ref.get_n_oppositions() ||
+			cat_mt.get_n_observations(k) != ref.get_n_observations() || cat_mt.get_n_oppositions(k) != ref.get_n_oppositions()) {
+			std::cout << "wrong observations or oppositions of record " << k << std::endl;
+			return 1;
+		}
+		// The bulk ephemerides and the single planet must agree with planet_mpcorb.
+		array3D r_ref, v_ref, r_pl, v_pl;
+		ref.get_eph(when, r_ref, v_ref);
+		cat.get_planet(k)->get_eph(when, r_pl, v_pl);
+		if (distance(r[k], r_ref) > 1e-6 * norm(r_ref) || distance(v[k], v_ref) > 1e-6 * norm(v_ref) ||
+			distance(r_pl, r_ref) > 1e-6 * norm(r_ref) || r[k] != r_mt[k] || v[k] != v_mt[k]) {
+			std::cout << "wrong ephemerides of record " << k << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "mpcorb catalogue passes." << std::endl;
+	return 0;
+}
@@ -0,0 +1,141 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the batch evaluation of the objective function
+
+#include <algorithm>
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+const double EPS = 10e-9;
+
+// Checks that objfun_batch() matches objfun() on the individuals of a random population.
+int test_batch(const problem::base &prob)
+{
+	population pop(prob,37);
+	std::vector<decision_vector> x;
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		x.push_back(pop.get_individual(i).cur_x);
+	}
+	// Expected values from a separate copy of the problem: objfun_batch() refreshes the fitness cache,
+	// which would otherwise hand its own results back to objfun().
+	const problem::base_ptr reference = prob.clone();
+	std::vector<fitness_vector> f_expected;
+	for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+		f_expected.push_back(reference->objfun(x[i]));
+	}
+	std::vector<fitness_vector> f = prob.objfun_batch(x);
+	if (f.size() != x.size()) {
+		std::cout << prob.get_name() << " wrong number of fitness vectors!" << std::endl;
+		return 1;
+	}
+	for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+		for (fitness_vector::size_type k = 0; k < f_expected[i].size(); ++k) {
+			if (std::fabs(f[i][k] - f_expected[i][k]) > EPS * (1. + std::fabs(f_expected[i][k]))) {
+				std::cout << prob.get_name() << " batch fitness failed! " << f[i] << " vs " << f_expected[i] << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << prob.get_name() << " batch fitness passes." << std::endl;
+	return 0;
+}
+
+#ifdef PAGMO_ENABLE_KEP_TOOLBOX
+// Checks objfun() at three fixed points x_j = lb_j + (ub_j - lb_j) * frac(0.1 + 0.37 (j + 1) (k + 1)) against the values
+// of the former per-chromosome implementation of the MGA-1DSM problems (which now evaluate blocks of one).
+int test_reference(const problem::base &prob, const double *f_ref)
+{
+	for (int k = 0; k < 3; ++k) {
+		decision_vector x(prob.get_dimension());
+		for (decision_vector::size_type j = 0; j < x.size(); ++j) {
+			const double t = 0.1 + 0.37 * (j + 1) * (k + 1);
+			x[j] = prob.get_lb()[j] + (prob.get_ub()[j] - prob.get_lb()[j]) * (t - std::floor(t));
+		}
+		const fitness_vector f = prob.objfun(x);
+		for (fitness_vector::size_type d = 0; d < f.size(); ++d) {
+			if (std::fabs(f[d] - f_ref[k * f.size() + d]) > 1E-12 * std::fabs(f_ref[k * f.size() + d])) {
+				std::cout << prob.get_name() << " reference fitness failed! " << f << " at point " << k << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << prob.get_name() << " reference fitness passes." << std::endl;
+	return 0;
+}
+#endif
+
+int main()
+{
+	int res = 0;
+	res |= test_batch(problem::ackley(13));
+	res |= test_batch(problem::rastrigin(13));
+	res |= test_batch(problem::rosenbrock(13));
+	res |= test_batch(problem::schwefel(13));
+	res |= test_batch(problem::griewank(13));
+	res |= test_batch(problem::michalewicz(13));
+	res |= test_batch(problem::levy5(14));
+	res |= test_batch(problem::dejong(13));
+	for (int id = 1; id <= 6; ++id) {
+		res |= test_batch(problem::zdt(id,13));
+	}
+	for (int id = 1; id <= 7; ++id) {
+		res |= test_batch(problem::dtlz(id,5,4));
+	}
+#ifdef PAGMO_ENABLE_KEP_TOOLBOX
+	res |= test_batch(problem::mga_1dsm_tof());
+	res |= test_batch(problem::mga_1dsm_alpha());
+	{
+		const double f_tof[] = {640700.84199984488, 76490.370687781688, 42303.74473360354};
+		const double f_alpha[] = {99964.360630806186, 102411.68609545837, 272947.78250290686};
+		res |= test_reference(problem::mga_1dsm_tof(),f_tof);
+		res |= test_reference(problem::mga_1dsm_alpha(),f_alpha);
+	}
+	{
+		// Longer sequences, multi-objective, with the launch hyperbolic velocity.
+		std::vector<kep_toolbox::planet_ptr> seq;
+		seq.push_back(kep_toolbox::planet_ss("earth").clone());
+		seq.push_back(kep_toolbox::planet_ss("venus").clone());
+		seq.push_back(kep_toolbox::planet_ss("venus").clone());
+		seq.push_back(kep_toolbox::planet_ss("earth").clone());
+		seq.push_back(kep_toolbox::planet_ss("jupiter").clone());
+		std::vector<boost::array<double,2> > tof(4);
+		const boost::array<double,2> tof_bounds = {{ 30,1500 }};
+		std::fill(tof.begin(),tof.end(),tof_bounds);
+		res |= test_batch(problem::mga_1dsm_tof(seq,kep_toolbox::epoch(0),kep_toolbox::epoch(1000),tof,0.5,2.5,true,true,false));
+		res |= test_batch(problem::mga_1dsm_alpha(seq,kep_toolbox::epoch(0),kep_toolbox::epoch(1000),365.25,10*365.25,0.5,2.5,true,true,false));
+		const double f_tof[] = {612979.3415372672, 3295.1999999999989, 68182.688537768699, 2942.3999999999969, 2766176.057941163, 2589.6000000000008};
+		const double f_alpha[] = {62007.776037761039, 3126.5400000000004, 74587.89182521723, 2271.8550000000005, 736005.35487450636, 1417.1699999999994};
+		res |= test_reference(problem::mga_1dsm_tof(seq,kep_toolbox::epoch(0),kep_toolbox::epoch(1000),tof,0.5,2.5,true,true,false),f_tof);
+		res |= test_reference(problem::mga_1dsm_alpha(seq,kep_toolbox::epoch(0),kep_toolbox::epoch(1000),365.25,10*365.25,0.5,2.5,true,true,false),f_alpha);
+	}
+#endif
+	// A problem without a batch implementation goes through the default one.
+	res |= test_batch(problem::branin());
+	return res;
+}
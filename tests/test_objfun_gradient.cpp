@@ -0,0 +1,189 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the gradient of the objective function
+
+#include <algorithm>
+#include <iostream>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+// Checks that the analytic gradient matches central differences at the given points.
+int test_gradient(const problem::base &prob, const std::vector<decision_vector> &points, const double &tol)
+{
+	decision_vector grad, x_plus, x_minus;
+	for (std::vector<decision_vector>::size_type i = 0; i < points.size(); ++i) {
+		const decision_vector &x = points[i];
+		prob.objfun_gradient(grad,x);
+		for (decision_vector::size_type j = 0; j < x.size(); ++j) {
+			const double h = 1e-6 * std::max(1.,std::fabs(x[j]));
+			x_plus = x;
+			x_minus = x;
+			x_plus[j] += h;
+			x_minus[j] -= h;
+			const double num = (prob.objfun(x_plus)[0] - prob.objfun(x_minus)[0]) / (2 * h);
+			if (std::fabs(grad[j] - num) > tol * (1. + std::fabs(num))) {
+				std::cout << prob.get_name() << " gradient failed at component " << j << ": " << grad[j] << " vs " << num << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << prob.get_name() << " gradient passes." << std::endl;
+	return 0;
+}
+
+// The individuals of a random population.
+std::vector<decision_vector> random_points(const problem::base &prob)
+{
+	population pop(prob,10);
+	std::vector<decision_vector> retval;
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		retval.push_back(pop.get_individual(i).cur_x);
+	}
+	return retval;
+}
+
+// Perturbed cubic lattices of atoms with spacing close to the potential minimum. Random clusters have nearly overlapping
+// atoms, where the potential is so large that central differences are dominated by round-off errors.
+std::vector<decision_vector> lattice_points(const int &atoms)
+{
+	std::vector<decision_vector> retval;
+	for (int p = 0; p < 5; ++p) {
+		// Atoms 0, 1 and 2 are at the origin, on the z axis and on the y axis, as required by the decision vector.
+		std::vector<double> pos(9,0.);
+		pos[5] = pos[7] = 1.12;
+		for (int i = 0; (int)pos.size() < 3 * atoms; ++i) {
+			if (i == 0 || i == 1 || i == 3) {
+				continue;
+			}
+			const int grid[3] = {i / 9, (i / 3) % 3, i % 3};
+			for (int k = 0; k < 3; ++k) {
+				pos.push_back(1.12 * grid[k] + 0.05 * std::sin(1. + p + 3. * i + k));
+			}
+		}
+		decision_vector x(pos.begin() + 6,pos.end());
+		x[0] = pos[5];
+		retval.push_back(x);
+	}
+	return retval;
+}
+
+// Checks that a cutoff radius larger than the cluster gives back the all-pairs potential.
+int test_cutoff()
+{
+	problem::lennard_jones full(20), cut(20,100.);
+	population pop(full,10);
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		const decision_vector &x = pop.get_individual(i).cur_x;
+		const double f_full = full.objfun(x)[0], f_cut = cut.objfun(x)[0];
+		if (std::fabs(f_full - f_cut) > 1e-9 * (1. + std::fabs(f_full))) {
+			std::cout << "lennard_jones cutoff failed: " << f_cut << " vs " << f_full << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "lennard_jones cutoff passes." << std::endl;
+	return 0;
+}
+
+// Checks a small cutoff radius (many cells, few atoms each) against the truncated and shifted all-pairs sum.
+int test_small_cutoff()
+{
+	const int atoms = 200;
+	const double cutoff = 0.3;
+	problem::lennard_jones cut(atoms,cutoff);
+	population pop(cut,5);
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		const decision_vector &x = pop.get_individual(i).cur_x;
+		// Atoms positions, as in lennard_jones::r().
+		std::vector<double> pos(3 * atoms,0.);
+		pos[3 * 1 + 2] = x[0];
+		pos[3 * 2 + 1] = x[1];
+		pos[3 * 2 + 2] = x[2];
+		for (int k = 9; k < 3 * atoms; ++k) {
+			pos[k] = x[k - 6];
+		}
+		const double sixth_cut = 1. / std::pow(cutoff,6), shift = sixth_cut * sixth_cut - sixth_cut;
+		double expected = 0;
+		for (int a = 0; a < atoms; ++a) {
+			for (int b = a + 1; b < atoms; ++b) {
+				double dist = 0;
+				for (int k = 0; k < 3; ++k) {
+					dist += (pos[3 * a + k] - pos[3 * b + k]) * (pos[3 * a + k] - pos[3 * b + k]);
+				}
+				if (dist < cutoff * cutoff) {
+					const double sixth = 1. / (dist * dist * dist);
+					expected += 4 * (sixth * sixth - sixth - shift);
+				}
+			}
+		}
+		const double f = cut.objfun(x)[0];
+		if (std::fabs(f - expected) > 1e-9 * (1. + std::fabs(expected))) {
+			std::cout << "lennard_jones small cutoff failed: " << f << " vs " << expected << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "lennard_jones small cutoff passes." << std::endl;
+	return 0;
+}
+
+// Coincident atoms get the penalty fitness and a finite gradient.
+int test_overlap()
+{
+	const problem::lennard_jones full(10), cut(10,1.5);
+	const decision_vector x(full.get_dimension(),0.);
+	decision_vector grad;
+	for (int p = 0; p < 2; ++p) {
+		const problem::base &prob = p ? static_cast<const problem::base &>(cut) : full;
+		prob.objfun_gradient(grad,x);
+		for (decision_vector::size_type j = 0; j < grad.size(); ++j) {
+			if (!(std::fabs(grad[j]) < std::numeric_limits<double>::max())) {
+				std::cout << "lennard_jones overlap gradient failed at component " << j << ": " << grad[j] << std::endl;
+				return 1;
+			}
+		}
+		if (prob.objfun(x)[0] != 4e+20) {
+			std::cout << "lennard_jones overlap penalty failed: " << prob.objfun(x)[0] << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "lennard_jones overlap passes." << std::endl;
+	return 0;
+}
+
+int main()
+{
+	int res = 0;
+	res |= test_gradient(problem::lennard_jones(7),lattice_points(7),1e-4);
+	res |= test_gradient(problem::lennard_jones(20,1.5),lattice_points(20),1e-4);
+	// Problems without an analytic gradient go through finite differences.
+	res |= test_gradient(problem::rosenbrock(5),random_points(problem::rosenbrock(5)),1e-4);
+	res |= test_cutoff();
+	res |= test_small_cutoff();
+	res |= test_overlap();
+	return res;
+}
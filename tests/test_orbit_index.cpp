@@ -0,0 +1,86 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the orbit index
+
+#include <algorithm>
+#include <iostream>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include "../src/keplerian_toolbox/keplerian_toolbox.h"
+
+using namespace kep_toolbox;
+
+int main()
+{
+	std::vector<planet_ptr> asteroids;
+	for (int i = 1; i <= 7076; ++i) {
+		asteroids.push_back(asteroid_gtoc5(i).clone());
+	}
+	const epoch when(57000 - 51544);
+	const double T = 200;
+	std::vector<array3D> r(asteroids.size()), v(asteroids.size());
+	for (std::vector<planet_ptr>::size_type i = 0; i < asteroids.size(); ++i) {
+		asteroids[i]->get_eph(when, r[i], v[i]);
+	}
+	for (int m = 0; m < 2; ++m) {
+		const orbit_index::metric_type metric = (m == 0) ? orbit_index::EUCLIDEAN : orbit_index::ORBITAL;
+		orbit_index index(asteroids, when, metric, T);
+		// Queries from some of the asteroids must agree with a brute force search.
+		for (std::vector<planet_ptr>::size_type q = 0; q < asteroids.size(); q += 97) {
+			std::vector<std::pair<double, std::vector<double>::size_type> > brute;
+			for (std::vector<planet_ptr>::size_type i = 0; i < asteroids.size(); ++i) {
+				double d2 = 0;
+				for (int j = 0; j < 3; ++j) {
+					const double dr = r[i][j] - r[q][j], dv = v[i][j] - v[q][j];
+					d2 += (m == 0) ? dr * dr : dr * dr / (T * T * ASTRO_DAY2SEC * ASTRO_DAY2SEC) + dv * dv;
+				}
+				brute.push_back(std::make_pair(std::sqrt(d2), i));
+			}
+			std::sort(brute.begin(), brute.end());
+			std::vector<std::vector<double>::size_type> idx;
+			std::vector<double> dist;
+			index.find_knn(idx, dist, r[q], v[q], 10);
+			if (idx.size() != 10 || idx[0] != q) {
+				std::cout << "wrong knn query from " << q << std::endl;
+				return 1;
+			}
+			for (int k = 0; k < 10; ++k) {
+				if (std::abs(dist[k] - brute[k].first) > 1e-9 * brute[k].first) {
+					std::cout << "wrong knn distance from " << q << std::endl;
+					return 1;
+				}
+			}
+			const double radius = (brute[50].first + brute[51].first) / 2;
+			index.find_ball(idx, dist, r[q], v[q], radius);
+			if (idx.size() != 51 || dist.back() > radius) {
+				std::cout << "wrong ball query from " << q << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << "orbit index passes." << std::endl;
+	return 0;
+}
@@ -0,0 +1,104 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test code for the population: setting all the decision vectors at once against setting them one at a time.
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+// Domination list of individual i, sorted (the order of the entries depends on the order of the updates).
+static std::vector<population::size_type> sorted_dom_list(const population &pop, const population::size_type &i)
+{
+	std::vector<population::size_type> list(pop.get_domination_list(i));
+	std::sort(list.begin(),list.end());
+	return list;
+}
+
+static bool same_state(const population &a, const population &b)
+{
+	for (population::size_type i = 0; i < a.size(); ++i) {
+		const population::individual_type &ia = a.get_individual(i), &ib = b.get_individual(i);
+		if (ia.cur_x != ib.cur_x || ia.cur_f != ib.cur_f || ia.cur_c != ib.cur_c ||
+			ia.best_x != ib.best_x || ia.best_f != ib.best_f || ia.best_c != ib.best_c ||
+			a.get_domination_count(i) != b.get_domination_count(i) || sorted_dom_list(a,i) != sorted_dom_list(b,i))
+		{
+			std::cout << "individual " << i << " differs" << std::endl;
+			return false;
+		}
+	}
+	if (a.champion().x != b.champion().x || a.champion().f != b.champion().f || a.champion().c != b.champion().c) {
+		std::cout << "champion differs" << std::endl;
+		return false;
+	}
+	if (a.compute_pareto_fronts() != b.compute_pareto_fronts()) {
+		std::cout << "pareto fronts differ" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+// Two rounds of new decision vectors (taken from other random populations, so that in the second round the
+// best vectors are updated only for some individuals), set with the bulk and with the per-individual set_x().
+int test_set_x(const problem::base &prob)
+{
+	population bulk(prob,23,42);
+	population single(bulk);
+	for (int round = 0; round < 2; ++round) {
+		const population source(prob,23,round + 43);
+		std::vector<decision_vector> x;
+		for (population::size_type i = 0; i < source.size(); ++i) {
+			x.push_back(source.get_individual(i).cur_x);
+		}
+		bulk.set_x(x);
+		for (population::size_type i = 0; i < x.size(); ++i) {
+			single.set_x(i,x[i]);
+		}
+		if (!same_state(bulk,single)) {
+			std::cout << prob.get_name() << " bulk set_x failed." << std::endl;
+			return 1;
+		}
+	}
+	try {
+		bulk.set_x(std::vector<decision_vector>(bulk.size() - 1,bulk.get_individual(0).cur_x));
+		std::cout << prob.get_name() << " wrong number of decision vectors not detected." << std::endl;
+		return 1;
+	} catch (const value_error &) {}
+	std::cout << prob.get_name() << " bulk set_x passes." << std::endl;
+	return 0;
+}
+
+int main()
+{
+	int res = 0;
+	res |= test_set_x(problem::ackley(10));
+	res |= test_set_x(problem::zdt(1,10));
+	res |= test_set_x(problem::dtlz(2,6,3));
+	res |= test_set_x(problem::cec2006(7));
+	return res;
+}
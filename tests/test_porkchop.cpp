@@ -0,0 +1,132 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the pork-chop grid
+
+#include <iostream>
+#include <cmath>
+#include <sstream>
+#include "../src/keplerian_toolbox/keplerian_toolbox.h"
+
+using namespace kep_toolbox;
+
+// A body on a circular orbit in the x-z plane: Lambert problems between two such bodies have no
+// defined direction of motion and are rejected by the solver.
+class polar_planet : public planet
+{
+public:
+	polar_planet(const double &radius):planet(epoch(0),make_elements(radius),ASTRO_MU_SUN,1,1,1,"polar"),m_radius(radius) {}
+protected:
+	void eph_impl(const epoch &when, array3D &r, array3D &v) const
+	{
+		const double speed = std::sqrt(ASTRO_MU_SUN / m_radius), angle = when.mjd2000() * ASTRO_DAY2SEC * speed / m_radius;
+		r[0] = m_radius * std::cos(angle); r[1] = 0; r[2] = m_radius * std::sin(angle);
+		v[0] = -speed * std::sin(angle); v[1] = 0; v[2] = speed * std::cos(angle);
+	}
+private:
+	static array6D make_elements(const double &radius)
+	{
+		array6D elem = {{radius,0,M_PI / 2,0,0,0}};
+		return elem;
+	}
+	double m_radius;
+};
+
+// Ill-defined Lambert problems must give NaN grid points, in the single and multithreaded grids alike.
+int test_degenerate()
+{
+	polar_planet p1(ASTRO_AU), p2(1.5 * ASTRO_AU);
+	porkchop pc(p1,p2,epoch(0),epoch(100),5,epoch(200),epoch(300),5), pc_mt(p1,p2,epoch(0),epoch(100),5,epoch(200),epoch(300),5,0,2);
+	for (unsigned int i = 0; i < pc.get_n_t0(); ++i) {
+		for (unsigned int j = 0; j < pc.get_n_t1(); ++j) {
+			if (!std::isnan(pc.get_dv_departure(i,j)) || !std::isnan(pc.get_dv_arrival(i,j)) ||
+				!std::isnan(pc_mt.get_dv_departure(i,j)) || !std::isnan(pc_mt.get_dv_arrival(i,j)))
+			{
+				std::cout << "ill-defined Lambert problem not set to NaN at " << i << "," << j << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << "pork-chop ill-defined grid points pass." << std::endl;
+	return 0;
+}
+
+int main()
+{
+	if (test_degenerate()) {
+		return 1;
+	}
+	planet_ss earth("earth"), mars("mars");
+	const epoch t0s(3000), t0e(3600), t1s(3100), t1e(4100);
+	porkchop pc(earth,mars,t0s,t0e,31,t1s,t1e,41);
+	porkchop pc_mt(earth,mars,t0s,t0e,31,t1s,t1e,41,0,3);
+	porkchop pc_mr(earth,mars,t0s,t0e,31,t1s,t1e,41,2,2);
+	for (unsigned int i = 0; i < pc.get_n_t0(); ++i) {
+		for (unsigned int j = 0; j < pc.get_n_t1(); ++j) {
+			const double t0 = pc.get_t0()[i], t1 = pc.get_t1()[j];
+			const double dv0 = pc.get_dv_departure(i,j), dv1 = pc.get_dv_arrival(i,j);
+			// The multithreaded grid must be identical.
+			if (!(dv0 == pc_mt.get_dv_departure(i,j) || (std::isnan(dv0) && std::isnan(pc_mt.get_dv_departure(i,j))))) {
+				std::cout << "multithreaded grid differs at " << i << "," << j << std::endl;
+				return 1;
+			}
+			if (t1 <= t0) {
+				if (!std::isnan(dv0) || !std::isnan(dv1) || !std::isnan(pc_mr.get_dv_departure(i,j))) {
+					std::cout << "grid point " << i << "," << j << " should not be solved" << std::endl;
+					return 1;
+				}
+				continue;
+			}
+			// Each grid point must agree with a Lambert problem solved from scratch.
+			array3D r0, v0, r1, v1, dv;
+			earth.get_eph(epoch(t0),r0,v0);
+			mars.get_eph(epoch(t1),r1,v1);
+			lambert_problem lp(r0,r1,(t1 - t0) * ASTRO_DAY2SEC,ASTRO_MU_SUN,0,0);
+			diff(dv,lp.get_v1()[0],v0);
+			if (std::abs(norm(dv) - dv0) > 1e-8 * (1 + dv0)) {
+				std::cout << "departure DV differs at " << i << "," << j << std::endl;
+				return 1;
+			}
+			diff(dv,lp.get_v2()[0],v1);
+			if (std::abs(norm(dv) - dv1) > 1e-8 * (1 + dv1)) {
+				std::cout << "arrival DV differs at " << i << "," << j << std::endl;
+				return 1;
+			}
+			// Multiple revolutions can only improve the total DV.
+			if (pc_mr.get_dv_departure(i,j) + pc_mr.get_dv_arrival(i,j) > dv0 + dv1) {
+				std::cout << "multiple revolutions grid is worse at " << i << "," << j << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::ostringstream csv, bin;
+	pc.write_csv(csv);
+	pc.write_binary(bin);
+	if (bin.str().size() != 16 + sizeof(double) * (31 + 41 + 2 * 31 * 41)) {
+		std::cout << "wrong binary output size" << std::endl;
+		return 1;
+	}
+	std::cout << pc << "pork-chop grid passes." << std::endl;
+	return 0;
+}
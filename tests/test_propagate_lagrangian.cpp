@@ -0,0 +1,104 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the keplerian propagators
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "../src/keplerian_toolbox/keplerian_toolbox.h"
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+
+using namespace kep_toolbox;
+
+const double EPS = 1e-9;
+
+static double distance(const array3D &a, const array3D &b)
+{
+	return std::sqrt((a[0]-b[0])*(a[0]-b[0]) + (a[1]-b[1])*(a[1]-b[1]) + (a[2]-b[2])*(a[2]-b[2]));
+}
+
+int main()
+{
+	boost::mt19937 gen(123);
+	boost::variate_generator<boost::mt19937 &, boost::uniform_real<double> > drng(gen,boost::uniform_real<double>(0,1));
+	const int n = 1000;
+	std::vector<array3D> r(n), v(n);
+	std::vector<double> t(n);
+	// Random states, both on elliptical and hyperbolic orbits, and random (positive and negative) times.
+	for (int k = 0; k < n; ++k) {
+		for (int i = 0; i < 3; ++i) {
+			r[k][i] = drng() * 2 - 1;
+			v[k][i] = drng() * 2 - 1;
+		}
+		r[k][0] += 1.5;
+		v[k][1] += 1;
+		t[k] = 20 * drng() - 10;
+	}
+	std::vector<array3D> r_batch(r), v_batch(v);
+	propagate_lagrangian_batch(r_batch,v_batch,t,1.);
+	for (int k = 0; k < n; ++k) {
+		array3D r1 = r[k], v1 = v[k], r2 = r[k], v2 = v[k];
+		// Lagrangian and universal variables propagations must agree.
+		propagate_lagrangian(r1,v1,t[k],1.);
+		propagate_lagrangian_u(r2,v2,t[k],1.);
+		if (distance(r1,r2) > EPS * (1 + norm(r1)) || distance(v1,v2) > EPS * (1 + norm(v1))) {
+			std::cout << "lagrangian and universal propagations differ at state " << k << std::endl;
+			return 1;
+		}
+		// The batch propagation must give the same result.
+		if (r1 != r_batch[k] || v1 != v_batch[k]) {
+			std::cout << "batch propagation differs at state " << k << std::endl;
+			return 1;
+		}
+		// Back-propagation must return the initial state.
+		propagate_lagrangian(r1,v1,-t[k],1.);
+		if (distance(r1,r[k]) > EPS * (1 + norm(r[k])) || distance(v1,v[k]) > EPS * (1 + norm(v[k]))) {
+			std::cout << "back-propagation does not return the initial state " << k << std::endl;
+			return 1;
+		}
+	}
+	// With no thrust, the Taylor integrator (batch and single propagations) must agree with the lagrangian propagation.
+	std::vector<array3D> r_t(r.begin(), r.begin() + 100), v_t(v.begin(), v.begin() + 100), u_t(100);
+	std::vector<double> m_t(100, 1.), t_t(t.begin(), t.begin() + 100);
+	for (int k = 0; k < 100; ++k) {
+		u_t[k][0] = u_t[k][1] = u_t[k][2] = 0;
+	}
+	taylor_integrator ti;
+	ti.propagate_batch(r_t, v_t, m_t, u_t, t_t, 1., 1.);
+	for (int k = 0; k < 100; ++k) {
+		array3D r1 = r[k], v1 = v[k], r2 = r[k], v2 = v[k];
+		double m2 = 1.;
+		propagate_lagrangian(r1,v1,t[k],1.);
+		propagate_taylor(r2,v2,m2,u_t[k],t[k],1.,1.);
+		if (distance(r1,r_t[k]) > 1e-6 * (1 + norm(r1)) || distance(v1,v_t[k]) > 1e-6 * (1 + norm(v1)) || r2 != r_t[k] || v2 != v_t[k]) {
+			std::cout << "taylor and lagrangian propagations differ at state " << k << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "keplerian propagation passes." << std::endl;
+	return 0;
+}
@@ -0,0 +1,75 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the multithreaded fitness evaluation of the spheres problem
+
+#include <iostream>
+#include <vector>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+// Checks that the fitness computed with n_threads threads is identical to the single-threaded one
+// on the individuals of a random population.
+int test_threads(bool symmetric, unsigned n_threads)
+{
+	const int n_evaluations = 11;
+	const std::vector<double> sides(3,0.6);
+	problem::spheres serial(n_evaluations,10,1E-6,0,symmetric,50.0,sides,1);
+	problem::spheres threaded(n_evaluations,10,1E-6,0,symmetric,50.0,sides,n_threads);
+	population pop(serial,5);
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		const decision_vector &x = pop.get_individual(i).cur_x;
+		// Evaluate twice, so that a solver state left over from a previous call would show up. The caches are
+		// emptied so that the fitness is actually recomputed.
+		fitness_vector f_first;
+		for (int k = 0; k < 2; ++k) {
+			serial.reset_caches();
+			threaded.reset_caches();
+			const fitness_vector f_serial = serial.objfun(x);
+			const fitness_vector f_threaded = threaded.objfun(x);
+			if (k == 0) {
+				f_first = f_serial;
+			}
+			if (f_serial != f_threaded || f_serial != f_first) {
+				std::cout << serial.get_name() << " (symmetric=" << symmetric << ", n_threads=" << n_threads
+					<< ") fitness mismatch! " << f_threaded << " vs " << f_serial << " (first evaluation: " << f_first << ")" << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << serial.get_name() << " (symmetric=" << symmetric << ", n_threads=" << n_threads
+		<< ") threaded fitness passes." << std::endl;
+	return 0;
+}
+
+int main()
+{
+	int res = 0;
+	res |= test_threads(false,2);
+	res |= test_threads(false,4);
+	res |= test_threads(true,3);
+	res |= test_threads(false,20);
+	return res;
+}